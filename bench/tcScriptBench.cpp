@@ -0,0 +1,348 @@
+// =============================================================================
+// tcScriptBench - headless script benchmark runner
+//
+// Runs a script through the same tcScriptHost as the app, without a window,
+// GPU or audio device (see tcHeadless.h), and reports compile time, frame
+// times and allocations per frame.
+//
+//   tcScriptBench [options] <script.tcs | script.as>...
+//
+//   --frames N        measured frames (default 600)
+//   --warmup N        frames run before measuring (default 60)
+//   --keys N          press keys 1..9, 0 in turn every N frames (0 = off);
+//                     cycles through the samples of testScript/main.tcs
+//   --cache           allow the bytecode cache (off: always compile)
+//   --trace FILE      write a Chrome trace of the measured frames
+//
+// Exits with 1 if a script fails to build or reports an error.
+// =============================================================================
+
+#include "tcScriptHost.h"
+#include "tcHeadless.h"
+#include "tcScriptAllocator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <sstream>
+
+// =============================================================================
+// Allocation counting (AngelScript's own allocations are counted by
+// tcScriptAllocator)
+// =============================================================================
+
+static std::atomic<size_t> g_allocCount{0};
+static std::atomic<size_t> g_allocBytes{0};
+
+static void* countedAlloc(size_t size) {
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    g_allocBytes.fetch_add(size, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new(size_t size) {
+    if (void* p = countedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size) {
+    if (void* p = countedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+// =============================================================================
+// Script loading
+// =============================================================================
+
+static bool readFile(const string& path, string& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    std::stringstream ss;
+    ss << file.rdbuf();
+    out = ss.str();
+    return true;
+}
+
+// Minimal reader for the .tcs format: {"files": {"name": "code", ...}}
+class TcsReader {
+public:
+    explicit TcsReader(const string& text) : s_(text) {}
+
+    bool read(vector<pair<string, string>>& files) {
+        if (!expect('{')) return false;
+        while (true) {
+            string key;
+            if (!readString(key) || !expect(':')) return false;
+            if (key == "files") {
+                if (!readFiles(files)) return false;
+            } else if (!skipValue()) {
+                return false;
+            }
+            if (expect(',')) continue;
+            return expect('}');
+        }
+    }
+
+private:
+    bool readFiles(vector<pair<string, string>>& files) {
+        if (!expect('{')) return false;
+        if (expect('}')) return true;
+        while (true) {
+            string name, code;
+            if (!readString(name) || !expect(':') || !readString(code)) return false;
+            files.emplace_back(std::move(name), std::move(code));
+            if (expect(',')) continue;
+            return expect('}');
+        }
+    }
+
+    void skipSpace() {
+        while (i_ < s_.size() && (s_[i_] == ' ' || s_[i_] == '\n' || s_[i_] == '\r' || s_[i_] == '\t')) i_++;
+    }
+
+    bool expect(char c) {
+        skipSpace();
+        if (i_ < s_.size() && s_[i_] == c) {
+            i_++;
+            return true;
+        }
+        return false;
+    }
+
+    bool readString(string& out) {
+        if (!expect('"')) return false;
+        while (i_ < s_.size()) {
+            char c = s_[i_++];
+            if (c == '"') return true;
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (i_ >= s_.size()) return false;
+            char e = s_[i_++];
+            switch (e) {
+                case 'n': out += '\n'; break;
+                case 't': out += '\t'; break;
+                case 'r': out += '\r'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'u': {
+                    if (i_ + 4 > s_.size()) return false;
+                    unsigned cp = std::stoul(s_.substr(i_, 4), nullptr, 16);
+                    i_ += 4;
+                    appendUtf8(out, cp);
+                    break;
+                }
+                default: out += e; break;
+            }
+        }
+        return false;
+    }
+
+    static void appendUtf8(string& out, unsigned cp) {
+        if (cp < 0x80) {
+            out += static_cast<char>(cp);
+        } else if (cp < 0x800) {
+            out += static_cast<char>(0xC0 | (cp >> 6));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            out += static_cast<char>(0xE0 | (cp >> 12));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    }
+
+    // Skip any JSON value (only strings and objects/arrays need care)
+    bool skipValue() {
+        skipSpace();
+        if (i_ >= s_.size()) return false;
+        if (s_[i_] == '"') {
+            string ignored;
+            return readString(ignored);
+        }
+        if (s_[i_] == '{' || s_[i_] == '[') {
+            int depth = 0;
+            while (i_ < s_.size()) {
+                char c = s_[i_];
+                if (c == '"') {
+                    string ignored;
+                    if (!readString(ignored)) return false;
+                    continue;
+                }
+                i_++;
+                if (c == '{' || c == '[') depth++;
+                else if ((c == '}' || c == ']') && --depth == 0) return true;
+            }
+            return false;
+        }
+        while (i_ < s_.size() && s_[i_] != ',' && s_[i_] != '}') i_++;
+        return true;
+    }
+
+    const string& s_;
+    size_t i_ = 0;
+};
+
+static bool loadSources(const string& path, vector<pair<string, string>>& files) {
+    string text;
+    if (!readFile(path, text)) {
+        std::fprintf(stderr, "tcScriptBench: cannot read %s\n", path.c_str());
+        return false;
+    }
+    if (path.size() > 4 && path.compare(path.size() - 4, 4, ".tcs") == 0) {
+        if (!TcsReader(text).read(files)) {
+            std::fprintf(stderr, "tcScriptBench: %s is not a valid .tcs file\n", path.c_str());
+            return false;
+        }
+        return true;
+    }
+    // Plain script: section named after the file
+    string name = path.substr(path.find_last_of("/\\") + 1);
+    files.emplace_back(name.substr(0, name.find_last_of('.')), std::move(text));
+    return true;
+}
+
+// =============================================================================
+// Benchmark
+// =============================================================================
+
+struct Options {
+    int frames = 600;
+    int warmup = 60;
+    int keyInterval = 0;
+    bool cache = false;
+    string tracePath;
+    vector<string> scripts;
+};
+
+static bool parseOptions(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--frames" && hasValue) opt.frames = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--warmup" && hasValue) opt.warmup = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--keys" && hasValue) opt.keyInterval = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--trace" && hasValue) opt.tracePath = argv[++i];
+        else if (arg == "--cache") opt.cache = true;
+        else if (arg.rfind("--", 0) == 0) return false;
+        else opt.scripts.push_back(arg);
+    }
+    return !opt.scripts.empty();
+}
+
+static double msSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+}
+
+// One benchmark run per script; returns false on a script error
+static bool runScript(const Options& opt, const string& path) {
+    vector<pair<string, string>> files;
+    if (!loadSources(path, files)) return false;
+
+    tcScriptHost host;
+    host.setBytecodeCacheEnabled(opt.cache);
+    host.setExecutionBudget(0);
+
+    host.clearScriptFiles();
+    for (const auto& [name, code] : files) host.addScriptFile(name, code);
+
+    auto start = chrono::steady_clock::now();
+    bool built = host.buildScriptFiles();
+    double compileMs = msSince(start);
+    if (!built) {
+        std::fprintf(stderr, "%s: build failed\n%s\n", path.c_str(), host.getLastError().c_str());
+        return false;
+    }
+
+    start = chrono::steady_clock::now();
+    host.callSetup();
+    double setupMs = msSince(start);
+
+    static const int sampleKeys[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9', '0' };
+    int keyIndex = 0;
+    auto runFrame = [&](int frame) {
+        if (opt.keyInterval > 0 && frame % opt.keyInterval == 0) {
+            int key = sampleKeys[keyIndex++ % 10];
+            host.queueEvent({InputEvent::KeyPressed, 0, 0, 0, key});
+            host.queueEvent({InputEvent::KeyReleased, 0, 0, 0, key});
+        }
+        host.callUpdate();
+        host.callDraw();
+    };
+
+    for (int i = 0; i < opt.warmup; i++) runFrame(i);
+
+    if (!opt.tracePath.empty()) host.setProfilingEnabled(true);
+
+    vector<double> frameMs(opt.frames);
+    size_t allocCount = g_allocCount.load();
+    size_t allocBytes = g_allocBytes.load();
+    tcScriptAllocator::Stats scriptAllocs = tcScriptAllocator::getStats();
+    size_t nullCalls = tcheadless::Stats::nullCalls;
+    for (int i = 0; i < opt.frames; i++) {
+        start = chrono::steady_clock::now();
+        runFrame(opt.warmup + i);
+        frameMs[i] = msSince(start);
+    }
+    allocCount = g_allocCount.load() - allocCount;
+    allocBytes = g_allocBytes.load() - allocBytes;
+    size_t scriptAllocCount = tcScriptAllocator::getStats().allocs - scriptAllocs.allocs;
+    size_t systemAllocCount = tcScriptAllocator::getStats().systemAllocs - scriptAllocs.systemAllocs;
+    nullCalls = tcheadless::Stats::nullCalls - nullCalls;
+
+    if (!opt.tracePath.empty()) {
+        std::ofstream trace(opt.tracePath, std::ios::binary);
+        trace << host.getProfileTrace();
+        host.setProfilingEnabled(false);
+    }
+
+    double total = 0.0;
+    for (double ms : frameMs) total += ms;
+    vector<double> sorted = frameMs;
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&](double p) {
+        return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()))];
+    };
+    double frames = static_cast<double>(opt.frames);
+
+    std::printf("%s (%zu file%s)\n", path.c_str(), files.size(), files.size() == 1 ? "" : "s");
+    std::printf("  compile        %9.3f ms%s\n", compileMs, host.wasLoadedFromCache() ? " (bytecode cache)" : "");
+    std::printf("  setup          %9.3f ms\n", setupMs);
+    std::printf("  frames         %9d (after %d warm-up)\n", opt.frames, opt.warmup);
+    std::printf("  frame mean     %9.3f ms\n", total / frames);
+    std::printf("  frame p50      %9.3f ms\n", percentile(0.50));
+    std::printf("  frame p99      %9.3f ms\n", percentile(0.99));
+    std::printf("  frame max      %9.3f ms\n", sorted.back());
+    std::printf("  C++ allocs     %9.1f per frame (%.0f bytes)\n", allocCount / frames, allocBytes / frames);
+    std::printf("  script allocs  %9.1f per frame (%.1f reached malloc)\n", scriptAllocCount / frames, systemAllocCount / frames);
+    std::printf("  skipped calls  %9.1f per frame\n", nullCalls / frames);
+    std::printf("  live objects   %9zu\n", host.getLiveObjectCount());
+
+    string error = host.getLastError();
+    if (!error.empty()) {
+        std::fprintf(stderr, "%s: script error\n%s\n", path.c_str(), error.c_str());
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseOptions(argc, argv, opt)) {
+        std::fprintf(stderr,
+            "usage: tcScriptBench [--frames N] [--warmup N] [--keys N] [--cache] [--trace FILE] <script.tcs | script.as>...\n");
+        return 2;
+    }
+
+    bool ok = true;
+    for (const string& path : opt.scripts) {
+        ok = runScript(opt, path) && ok;
+    }
+    return ok ? 0 : 1;
+}
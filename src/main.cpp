@@ -3,6 +3,7 @@
 // =============================================================================
 
 #include "tcApp.h"
+#include "tcChipSynth.h"
 
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
@@ -58,6 +59,105 @@ const char* getScriptError() {
     return "";
 }
 
+// Mirror the bytecode cache to a directory on the Emscripten FS
+// (mount IDBFS there from JS to keep compiled scripts across page loads)
+EMSCRIPTEN_KEEPALIVE
+void setBytecodeCacheDir(const char* dir) {
+    if (g_app && dir) {
+        g_app->setBytecodeCacheDir(string(dir));
+    }
+}
+
+// Per-call time limit for script code in milliseconds (0 = unlimited).
+// suspend = 0 aborts the call with an error, 1 continues it next frame.
+EMSCRIPTEN_KEEPALIVE
+void setExecutionBudget(int milliseconds, int suspend) {
+    if (g_app) {
+        g_app->setExecutionBudget(milliseconds, suspend != 0);
+    }
+}
+
+// Memory cap for script allocations in megabytes (0 = none). A sketch that
+// exceeds it is stopped with an error until the next build.
+EMSCRIPTEN_KEEPALIVE
+void setMemoryCap(int megabytes) {
+    if (g_app) {
+        g_app->setMemoryCap(megabytes > 0 ? static_cast<size_t>(megabytes) * 1024 * 1024 : 0);
+    }
+}
+
+// Memory for decoded images, sounds and fonts kept across runs, in megabytes
+// (0 = no caching). Least recently used assets are dropped first.
+EMSCRIPTEN_KEEPALIVE
+void setAssetCacheBudget(int megabytes) {
+    if (g_app) {
+        g_app->setAssetCacheBudget(megabytes > 0 ? static_cast<size_t>(megabytes) * 1024 * 1024 : 0);
+    }
+}
+
+// Garbage collection time per frame in microseconds, and the number of
+// GC-tracked objects above which a full cycle is forced (0 = never).
+EMSCRIPTEN_KEEPALIVE
+void setGarbageCollection(int microseconds, int fullCycleObjects) {
+    if (g_app) {
+        g_app->setGarbageCollection(microseconds, static_cast<size_t>(fullCycleObjects > 0 ? fullCycleObjects : 0));
+    }
+}
+
+// Start (1) or stop (0) recording a script profile. Starting clears the
+// previous recording.
+EMSCRIPTEN_KEEPALIVE
+void setProfilingEnabled(int enabled) {
+    if (g_app) {
+        g_app->setProfilingEnabled(enabled != 0);
+    }
+}
+
+// Recorded profile as Chrome Trace Event JSON (chrome://tracing, Perfetto)
+EMSCRIPTEN_KEEPALIVE
+const char* getProfileTrace() {
+    static string traceStr;
+    if (g_app) {
+        traceStr = g_app->getProfileTrace();
+        return traceStr.c_str();
+    }
+    return "";
+}
+
+// Hot reload keeps script globals (1) or restarts from setup() (0, default)
+EMSCRIPTEN_KEEPALIVE
+void setPreserveState(int enabled) {
+    if (g_app) {
+        g_app->setPreserveState(enabled != 0);
+    }
+}
+
+// Number of live script objects (should stay flat while a script runs)
+EMSCRIPTEN_KEEPALIVE
+int getLiveObjectCount() {
+    return g_app ? static_cast<int>(g_app->getLiveObjectCount()) : 0;
+}
+
+// Snapshot of frame timings and engine counters as JSON: rolling
+// histograms for compile, update, draw, events and gc plus live objects
+// per type. One call per HUD refresh.
+EMSCRIPTEN_KEEPALIVE
+const char* getEngineStats() {
+    static string statsStr;
+    statsStr = g_app ? g_app->getStatsJson() : "{}";
+    return statsStr.c_str();
+}
+
+// Audio output for ChipSynth: fills 'out' with frames * channels interleaved
+// floats. Called by the WebAudio node tcAudioOutput opens; a page with its
+// own audio graph can call it too (with a buffer from _malloc).
+EMSCRIPTEN_KEEPALIVE
+void renderAudio(float* out, int frames, int channels, int sampleRate) {
+    if (out) {
+        tcChipSynth::mixAll(out, frames, channels, sampleRate);
+    }
+}
+
 // Pause the app (skip update/draw for power saving)
 EMSCRIPTEN_KEEPALIVE
 void pauseEngine() {
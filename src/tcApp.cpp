@@ -77,9 +77,10 @@ void tcApp::draw() {
 
 void tcApp::loadScript(const string& code) {
     if (scriptHost_) {
-        scriptLoaded_ = scriptHost_->loadScript(code);
-        if (scriptLoaded_) {
-            scriptHost_->callSetup();
+        // On failure the previous script (if any) keeps running
+        if (scriptHost_->loadScript(code)) {
+            scriptLoaded_ = true;
+            if (!scriptHost_->wasStateRestored()) scriptHost_->callSetup();
             logNotice("tcApp") << "Script loaded successfully";
         } else {
             logError("tcApp") << "Failed to load script: " << scriptHost_->getLastError();
@@ -91,6 +92,61 @@ string tcApp::getLastError() const {
     return scriptHost_ ? scriptHost_->getLastError() : "";
 }
 
+void tcApp::setBytecodeCacheDir(const string& dir) {
+    if (scriptHost_) {
+        scriptHost_->setBytecodeCacheDir(dir);
+    }
+}
+
+void tcApp::setExecutionBudget(int milliseconds, bool suspend) {
+    if (scriptHost_) {
+        scriptHost_->setExecutionBudget(milliseconds, suspend);
+    }
+}
+
+void tcApp::setMemoryCap(size_t bytes) {
+    if (scriptHost_) {
+        scriptHost_->setMemoryCap(bytes);
+    }
+}
+
+void tcApp::setAssetCacheBudget(size_t bytes) {
+    if (scriptHost_) {
+        scriptHost_->setAssetCacheBudget(bytes);
+    }
+}
+
+void tcApp::setGarbageCollection(int microseconds, size_t fullCycleObjects) {
+    if (scriptHost_) {
+        scriptHost_->setGarbageCollectionBudget(microseconds);
+        scriptHost_->setGarbageCollectionThreshold(fullCycleObjects);
+    }
+}
+
+void tcApp::setProfilingEnabled(bool enabled) {
+    if (scriptHost_) {
+        scriptHost_->setProfilingEnabled(enabled);
+    }
+}
+
+string tcApp::getProfileTrace() const {
+    return scriptHost_ ? scriptHost_->getProfileTrace() : "";
+}
+
+void tcApp::setPreserveState(bool enabled) {
+    if (scriptHost_) {
+        scriptHost_->setPreserveState(enabled);
+    }
+}
+
+size_t tcApp::getLiveObjectCount() const {
+    return scriptHost_ ? scriptHost_->getLiveObjectCount() : 0;
+}
+
+string tcApp::getStatsJson() const {
+    return scriptHost_ ? scriptHost_->getStatsJson() : "{}";
+}
+
 void tcApp::clearScriptFiles() {
     if (scriptHost_) {
         scriptHost_->clearScriptFiles();
@@ -105,51 +161,54 @@ void tcApp::addScriptFile(const string& name, const string& code) {
 
 bool tcApp::buildScriptFiles() {
     if (scriptHost_) {
-        scriptLoaded_ = scriptHost_->buildScriptFiles();
-        if (scriptLoaded_) {
-            scriptHost_->callSetup();
-            logNotice("tcApp") << "Script built successfully (multi-file)";
-        } else {
+        // On failure the previous script (if any) keeps running
+        if (!scriptHost_->buildScriptFiles()) {
             logError("tcApp") << "Failed to build script: " << scriptHost_->getLastError();
+            return false;
         }
-        return scriptLoaded_;
+        scriptLoaded_ = true;
+        if (!scriptHost_->wasStateRestored()) scriptHost_->callSetup();
+        logNotice("tcApp") << "Script built successfully (multi-file)";
+        return true;
     }
     return false;
 }
 
+// Input events are queued and delivered to the script before the next update()
+
 void tcApp::keyPressed(int key) {
     if (scriptHost_ && scriptLoaded_) {
-        scriptHost_->callKeyPressed(key);
+        scriptHost_->queueEvent({InputEvent::KeyPressed, 0, 0, 0, key});
     }
 }
 
 void tcApp::keyReleased(int key) {
     if (scriptHost_ && scriptLoaded_) {
-        scriptHost_->callKeyReleased(key);
+        scriptHost_->queueEvent({InputEvent::KeyReleased, 0, 0, 0, key});
     }
 }
 
 void tcApp::mousePressed(Vec2 pos, int button) {
     if (scriptHost_ && scriptLoaded_) {
-        scriptHost_->callMousePressed(pos.x, pos.y, button);
+        scriptHost_->queueEvent({InputEvent::MousePressed, pos.x, pos.y, button});
     }
 }
 
 void tcApp::mouseReleased(Vec2 pos, int button) {
     if (scriptHost_ && scriptLoaded_) {
-        scriptHost_->callMouseReleased(pos.x, pos.y, button);
+        scriptHost_->queueEvent({InputEvent::MouseReleased, pos.x, pos.y, button});
     }
 }
 
 void tcApp::mouseMoved(Vec2 pos) {
     if (scriptHost_ && scriptLoaded_) {
-        scriptHost_->callMouseMoved(pos.x, pos.y);
+        scriptHost_->queueEvent({InputEvent::MouseMoved, pos.x, pos.y});
     }
 }
 
 void tcApp::mouseDragged(Vec2 pos, int button) {
     if (scriptHost_ && scriptLoaded_) {
-        scriptHost_->callMouseDragged(pos.x, pos.y, button);
+        scriptHost_->queueEvent({InputEvent::MouseDragged, pos.x, pos.y, button});
     }
 }
 
@@ -159,7 +218,7 @@ void tcApp::mouseScrolled(Vec2 delta) {
 
 void tcApp::windowResized(int width, int height) {
     if (scriptHost_ && scriptLoaded_) {
-        scriptHost_->callWindowResized(width, height);
+        scriptHost_->queueEvent({InputEvent::WindowResized, static_cast<float>(width), static_cast<float>(height)});
     }
 }
 
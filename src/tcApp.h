@@ -34,6 +34,34 @@ public:
 
     string getLastError() const;
 
+    // Bytecode cache directory (empty = memory only)
+    void setBytecodeCacheDir(const string& dir);
+
+    // Per-call time limit for script code (0 = unlimited)
+    void setExecutionBudget(int milliseconds, bool suspend);
+
+    // Script memory cap in bytes (0 = none)
+    void setMemoryCap(size_t bytes);
+
+    // Memory for decoded assets kept across runs, in bytes (0 = no caching)
+    void setAssetCacheBudget(size_t bytes);
+
+    // Per-frame garbage collection time and full-cycle threshold
+    void setGarbageCollection(int microseconds, size_t fullCycleObjects);
+
+    // Script profiler (Chrome Trace Event JSON)
+    void setProfilingEnabled(bool enabled);
+    string getProfileTrace() const;
+
+    // Keep global variable values across reloads (opt-in)
+    void setPreserveState(bool enabled);
+
+    // Script-visible objects currently alive (for leak checks)
+    size_t getLiveObjectCount() const;
+
+    // Timings and engine counters as JSON (for the perf HUD)
+    string getStatsJson() const;
+
     // Pause control (for power saving)
     void setPaused(bool paused) { paused_ = paused; }
     bool isPaused() const { return paused_; }
@@ -0,0 +1,74 @@
+#include "tcAssetCache.h"
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+
+// kind|variant|path|size|mtime. Files that can't be stat'ed (paths TrussC
+// resolves itself, say) are keyed by path alone.
+std::string tcAssetCache::makeKey(const char* kind, const std::string& path, int variant) {
+    std::string key = std::string(kind) + '|' + std::to_string(variant) + '|' + path;
+    std::error_code ec;
+    std::filesystem::path file(path);
+    uintmax_t size = std::filesystem::file_size(file, ec);
+    if (ec) return key;
+    auto modified = std::filesystem::last_write_time(file, ec);
+    if (ec) return key;
+    key += '|' + std::to_string(size) + '|' + std::to_string(modified.time_since_epoch().count());
+    return key;
+}
+
+// kind#hash - can't collide with file keys, which have a '|' after the kind
+std::string tcAssetCache::makeKey(const char* kind, uint64_t hash) {
+    char buf[24];
+    snprintf(buf, sizeof(buf), "#%016llx", static_cast<unsigned long long>(hash));
+    return std::string(kind) + buf;
+}
+
+std::shared_ptr<const void> tcAssetCache::lookup(const std::string& key) {
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        stats_.misses++;
+        return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second.lru);
+    stats_.hits++;
+    return it->second.value;
+}
+
+void tcAssetCache::insert(const std::string& key, std::shared_ptr<const void> value, size_t bytes) {
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        stats_.bytes -= it->second.bytes;
+        lru_.erase(it->second.lru);
+        entries_.erase(it);
+    }
+    evict(budget_ - bytes);
+
+    lru_.push_front(key);
+    entries_.emplace(key, Entry{std::move(value), bytes, lru_.begin()});
+    stats_.bytes += bytes;
+    stats_.entries = entries_.size();
+}
+
+void tcAssetCache::evict(size_t budget) {
+    while (stats_.bytes > budget && !lru_.empty()) {
+        auto it = entries_.find(lru_.back());
+        stats_.bytes -= it->second.bytes;
+        entries_.erase(it);
+        lru_.pop_back();
+        stats_.evictions++;
+    }
+    stats_.entries = entries_.size();
+}
+
+void tcAssetCache::setBudget(size_t bytes) {
+    budget_ = bytes;
+    evict(budget_);
+}
+
+void tcAssetCache::clear() {
+    entries_.clear();
+    lru_.clear();
+    stats_.bytes = 0;
+    stats_.entries = 0;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+// =============================================================================
+// tcAssetCache - decoded assets kept across script reloads
+//
+// Script objects (Image, Sound, Font, ...) die with the script that made
+// them, so every Run used to read and decode the same files again. The host
+// keeps this cache for its whole lifetime: Image / Pixels / Sound / Font
+// loads look here first and copy the decoded asset out of it.
+//
+// Entries are keyed by kind ("pixels", "font", ...), path, a variant (font
+// size) and the file's size and modification time, so an edited file is
+// decoded again. Least recently used entries are evicted once the byte
+// budget is exceeded; a budget of 0 disables the cache.
+// =============================================================================
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+class tcAssetCache {
+public:
+    static constexpr size_t kDefaultBudget = 256 * 1024 * 1024;
+
+    struct Stats {
+        size_t entries = 0;
+        size_t bytes = 0;
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evictions = 0;
+    };
+
+    template<typename T>
+    std::shared_ptr<const T> find(const char* kind, const std::string& path, int variant = 0) {
+        return std::static_pointer_cast<const T>(lookup(makeKey(kind, path, variant)));
+    }
+
+    // 'bytes' is what the entry counts against the budget
+    template<typename T>
+    void store(const char* kind, const std::string& path, int variant, T value, size_t bytes) {
+        if (budget_ == 0 || bytes > budget_) return;
+        insert(makeKey(kind, path, variant), std::make_shared<const T>(std::move(value)), bytes);
+    }
+
+    // Assets generated in code (synthesized sounds, ...), keyed by a hash of
+    // the parameters that produced them
+    template<typename T>
+    std::shared_ptr<const T> find(const char* kind, uint64_t hash) {
+        return std::static_pointer_cast<const T>(lookup(makeKey(kind, hash)));
+    }
+    template<typename T>
+    void store(const char* kind, uint64_t hash, T value, size_t bytes) {
+        if (budget_ == 0 || bytes > budget_) return;
+        insert(makeKey(kind, hash), std::make_shared<const T>(std::move(value)), bytes);
+    }
+
+    void setBudget(size_t bytes);
+    size_t getBudget() const { return budget_; }
+    void clear();
+
+    const Stats& getStats() const { return stats_; }
+
+private:
+    struct Entry {
+        std::shared_ptr<const void> value;
+        size_t bytes;
+        std::list<std::string>::iterator lru;
+    };
+
+    static std::string makeKey(const char* kind, const std::string& path, int variant);
+    static std::string makeKey(const char* kind, uint64_t hash);
+    std::shared_ptr<const void> lookup(const std::string& key);
+    void insert(const std::string& key, std::shared_ptr<const void> value, size_t bytes);
+    void evict(size_t budget);
+
+    std::unordered_map<std::string, Entry> entries_;
+    std::list<std::string> lru_;    // most recently used first
+    size_t budget_ = kDefaultBudget;
+    Stats stats_;
+};
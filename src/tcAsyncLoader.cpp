@@ -0,0 +1,101 @@
+#include "tcAsyncLoader.h"
+
+#ifdef TCSCRIPT_LOADER_THREADS
+
+tcAsyncLoader::~tcAsyncLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        queued_.clear();
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) worker.join();
+}
+
+void tcAsyncLoader::submit(Work work, Finish finish) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queued_.push_back({std::move(work), std::move(finish)});
+        if (workers_.empty()) {
+            for (int i = 0; i < kWorkers; i++) workers_.emplace_back(&tcAsyncLoader::workerLoop, this);
+        }
+    }
+    pending_++;
+    wake_.notify_one();
+}
+
+void tcAsyncLoader::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [this] { return stopping_ || !queued_.empty(); });
+        if (stopping_) return;
+
+        Job job = std::move(queued_.front());
+        queued_.pop_front();
+        running_++;
+        lock.unlock();
+        job.work();
+        lock.lock();
+        running_--;
+        done_.push_back(std::move(job));
+        if (running_ == 0) idle_.notify_all();
+    }
+}
+
+void tcAsyncLoader::poll() {
+    if (pending_ == 0) return;
+    std::vector<Job> done;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        done.swap(done_);
+    }
+    // finish() may submit more loads (a callback calling loadAsync)
+    for (Job& job : done) {
+        pending_--;
+        job.finish(false);
+    }
+}
+
+void tcAsyncLoader::cancelAll() {
+    if (pending_ == 0) return;
+    std::deque<Job> skipped;
+    std::vector<Job> done;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        skipped.swap(queued_);
+        idle_.wait(lock, [this] { return running_ == 0; });
+        done.swap(done_);
+    }
+    for (Job& job : done) job.finish(true);
+    for (Job& job : skipped) job.finish(true);
+    pending_ = 0;
+}
+
+#else
+
+tcAsyncLoader::~tcAsyncLoader() = default;
+
+void tcAsyncLoader::submit(Work work, Finish finish) {
+    queued_.push_back({std::move(work), std::move(finish)});
+    pending_++;
+}
+
+void tcAsyncLoader::poll() {
+    // Only the jobs queued before this poll; callbacks may queue more
+    std::deque<Job> jobs;
+    jobs.swap(queued_);
+    for (Job& job : jobs) {
+        job.work();
+        pending_--;
+        job.finish(false);
+    }
+}
+
+void tcAsyncLoader::cancelAll() {
+    std::deque<Job> jobs;
+    jobs.swap(queued_);
+    for (Job& job : jobs) job.finish(true);
+    pending_ = 0;
+}
+
+#endif
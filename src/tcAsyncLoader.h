@@ -0,0 +1,78 @@
+#pragma once
+
+// =============================================================================
+// tcAsyncLoader - file decoding on worker threads
+//
+// loadAsync() bindings submit a job in two halves: work() decodes into
+// memory the job owns and runs on a worker thread; finish() hands the result
+// to the script object (and uploads to the GPU) on the main thread, from
+// poll() once per frame. Script objects and the script engine are only ever
+// touched by finish().
+//
+// Native builds and Emscripten builds with pthreads use kWorkers threads,
+// started on the first submit. Emscripten builds without pthreads run work()
+// on the main thread at the next poll(), so loadAsync still returns at once.
+// =============================================================================
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <vector>
+
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+#define TCSCRIPT_LOADER_THREADS 1
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+class tcAsyncLoader {
+public:
+    using Work = std::function<void()>;
+    // cancelled: the script was reloaded or the host is shutting down - apply
+    // or drop the result, but don't call into the script
+    using Finish = std::function<void(bool cancelled)>;
+
+    static constexpr int kWorkers = 2;
+
+    tcAsyncLoader() = default;
+    ~tcAsyncLoader();
+
+    tcAsyncLoader(const tcAsyncLoader&) = delete;
+    tcAsyncLoader& operator=(const tcAsyncLoader&) = delete;
+
+    void submit(Work work, Finish finish);
+
+    // Main thread: runs finish() for every job whose work is done
+    void poll();
+
+    // Main thread: waits for jobs in progress, then finishes every job with
+    // cancelled = true. Jobs not started yet are finished without their work.
+    void cancelAll();
+
+    // Submitted jobs not finished yet
+    size_t getPendingCount() const { return pending_; }
+
+private:
+    struct Job {
+        Work work;
+        Finish finish;
+    };
+
+    size_t pending_ = 0;
+
+#ifdef TCSCRIPT_LOADER_THREADS
+    void workerLoop();
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::deque<Job> queued_;
+    std::vector<Job> done_;
+    int running_ = 0;
+    bool stopping_ = false;
+#else
+    std::deque<Job> queued_;
+#endif
+};
@@ -0,0 +1,88 @@
+#include "tcAudioOutput.h"
+#include "tcChipSynth.h"
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+
+// Mono mix rendered into a _malloc'ed buffer, copied to every output channel
+EM_JS(int, tcAudioOutputOpen, (), {
+    var AudioContextType = window.AudioContext || window.webkitAudioContext;
+    if (!AudioContextType) return 0;
+    var context = new AudioContextType();
+    var frames = 1024;
+    var node = context.createScriptProcessor(frames, 0, 2);
+    var buffer = _malloc(frames * 4);
+    node.onaudioprocess = function(e) {
+        var out = e.outputBuffer;
+        var count = Math.min(out.length, frames);
+        _renderAudio(buffer, count, 1, context.sampleRate);
+        var mono = HEAPF32.subarray(buffer >> 2, (buffer >> 2) + count);
+        for (var c = 0; c < out.numberOfChannels; c++) out.getChannelData(c).set(mono);
+    };
+    node.connect(context.destination);
+
+    // Autoplay policy: audio starts suspended until the user interacts
+    var resume = function() {
+        if (context.state === 'suspended') context.resume();
+    };
+    ['pointerdown', 'keydown', 'touchstart'].forEach(function(type) {
+        document.addEventListener(type, resume, true);
+    });
+    resume();
+    Module['tcAudioOutput'] = { context: context, node: node, buffer: buffer };
+    return 1;
+});
+
+EM_JS(void, tcAudioOutputClose, (), {
+    var output = Module['tcAudioOutput'];
+    if (!output) return;
+    output.node.disconnect();
+    output.context.close();
+    _free(output.buffer);
+    delete Module['tcAudioOutput'];
+});
+
+static bool g_outputOpen = false;
+
+bool tcAudioOutput::start() {
+    if (!g_outputOpen) g_outputOpen = tcAudioOutputOpen() != 0;
+    return g_outputOpen;
+}
+
+void tcAudioOutput::stop() {
+    if (!g_outputOpen) return;
+    tcAudioOutputClose();
+    g_outputOpen = false;
+}
+
+bool tcAudioOutput::isRunning() {
+    return g_outputOpen;
+}
+
+void tcAudioOutput::setExternal(bool) {
+}
+
+#else
+
+static bool g_external = false;
+
+bool tcAudioOutput::start() {
+#ifdef TCSCRIPT_HEADLESS
+    return true;
+#else
+    return g_external;
+#endif
+}
+
+void tcAudioOutput::stop() {
+}
+
+bool tcAudioOutput::isRunning() {
+    return g_external;
+}
+
+void tcAudioOutput::setExternal(bool external) {
+    g_external = external;
+}
+
+#endif
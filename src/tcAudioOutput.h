@@ -0,0 +1,29 @@
+#pragma once
+
+// =============================================================================
+// tcAudioOutput - the audio callback that drives tcChipSynth::mixAll()
+//
+// TrussC's Sound plays whole buffers and has no streaming hook, so ChipSynth
+// brings its own output, started when the first synth is created:
+//
+// - Web: a WebAudio context with a ScriptProcessorNode whose callback calls
+//   the exported renderAudio() on the main thread (no pthreads needed).
+//   Browsers keep the context suspended until the page gets a click, tap or
+//   key press; it resumes on the first one.
+// - Native: TrussC's audio device is not reachable from here. An app that
+//   calls tcChipSynth::mixAll() from its own audio stream says so with
+//   setExternal(true); otherwise there is no output and createChipSynth()
+//   fails with a script exception instead of returning a silent synth.
+// - Headless benchmark runner: synths are created but never rendered.
+// =============================================================================
+
+class tcAudioOutput {
+public:
+    // Opens the output on first use. Returns false if this platform has none.
+    static bool start();
+    static void stop();
+    static bool isRunning();
+
+    // Native: the app renders tcChipSynth::mixAll() into its own stream
+    static void setExternal(bool external);
+};
@@ -0,0 +1,250 @@
+#include "tcBytecodeCache.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+// =============================================================================
+// Memory stream for SaveByteCode / LoadByteCode
+// =============================================================================
+namespace {
+
+class MemoryStream : public asIBinaryStream {
+public:
+    MemoryStream() = default;
+    explicit MemoryStream(const std::vector<asBYTE>& data) : data_(data) {}
+
+    int Write(const void* ptr, asUINT size) override {
+        if (size == 0) return 0;
+        const asBYTE* bytes = static_cast<const asBYTE*>(ptr);
+        data_.insert(data_.end(), bytes, bytes + size);
+        return 0;
+    }
+
+    int Read(void* ptr, asUINT size) override {
+        if (readPos_ + size > data_.size()) return -1;
+        std::memcpy(ptr, data_.data() + readPos_, size);
+        readPos_ += size;
+        return 0;
+    }
+
+    std::vector<asBYTE>& data() { return data_; }
+
+private:
+    std::vector<asBYTE> data_;
+    size_t readPos_ = 0;
+};
+
+// FNV-1a 64-bit
+constexpr uint64_t kFnvOffset = 14695981039346656037ull;
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+void hashBytes(uint64_t& h, const void* data, size_t size) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        h ^= p[i];
+        h *= kFnvPrime;
+    }
+}
+
+void hashString(uint64_t& h, const std::string& s) {
+    uint64_t len = s.size();
+    hashBytes(h, &len, sizeof(len));  // length prefix keeps section boundaries unambiguous
+    hashBytes(h, s.data(), s.size());
+}
+
+// Everything registered with the engine, by declaration: a binding whose
+// signature changed (even with the same number of functions and types)
+// keys its scripts differently
+void hashType(uint64_t& h, asITypeInfo* type) {
+    hashString(h, type->GetNamespace() ? type->GetNamespace() : "");
+    hashString(h, type->GetName());
+    asQWORD flags = type->GetFlags();
+    asUINT size = type->GetSize();
+    hashBytes(h, &flags, sizeof(flags));
+    hashBytes(h, &size, sizeof(size));
+    for (asUINT i = 0; i < type->GetFactoryCount(); i++) {
+        hashString(h, type->GetFactoryByIndex(i)->GetDeclaration(true, true, false));
+    }
+    for (asUINT i = 0; i < type->GetBehaviourCount(); i++) {
+        asEBehaviours behaviour;
+        asIScriptFunction* func = type->GetBehaviourByIndex(i, &behaviour);
+        hashBytes(h, &behaviour, sizeof(behaviour));
+        if (func) hashString(h, func->GetDeclaration(true, true, false));
+    }
+    for (asUINT i = 0; i < type->GetMethodCount(); i++) {
+        hashString(h, type->GetMethodByIndex(i)->GetDeclaration(true, true, false));
+    }
+    for (asUINT i = 0; i < type->GetPropertyCount(); i++) {
+        hashString(h, type->GetPropertyDeclaration(i, true));
+    }
+}
+
+// Enum values are int in older AngelScript releases and asINT64 in newer ones
+template<typename Value>
+Value enumValueType(const char* (asITypeInfo::*)(asUINT, Value*) const);
+using EnumValue = decltype(enumValueType(&asITypeInfo::GetEnumValueByIndex));
+
+uint64_t hashEngine(asIScriptEngine* engine) {
+    uint64_t h = kFnvOffset;
+    for (asUINT i = 0; i < engine->GetObjectTypeCount(); i++) {
+        hashType(h, engine->GetObjectTypeByIndex(i));
+    }
+    for (asUINT i = 0; i < engine->GetEnumCount(); i++) {
+        asITypeInfo* type = engine->GetEnumByIndex(i);
+        hashString(h, type->GetName());
+        for (asUINT v = 0; v < type->GetEnumValueCount(); v++) {
+            EnumValue value = 0;
+            hashString(h, type->GetEnumValueByIndex(v, &value));
+            hashBytes(h, &value, sizeof(value));
+        }
+    }
+    for (asUINT i = 0; i < engine->GetFuncdefCount(); i++) {
+        asIScriptFunction* signature = engine->GetFuncdefByIndex(i)->GetFuncdefSignature();
+        if (signature) hashString(h, signature->GetDeclaration(true, true, false));
+    }
+    for (asUINT i = 0; i < engine->GetGlobalFunctionCount(); i++) {
+        hashString(h, engine->GetGlobalFunctionByIndex(i)->GetDeclaration(true, true, false));
+    }
+    for (asUINT i = 0; i < engine->GetGlobalPropertyCount(); i++) {
+        const char* name = nullptr;
+        const char* nameSpace = nullptr;
+        int typeId = 0;
+        bool isConst = false;
+        if (engine->GetGlobalPropertyByIndex(i, &name, &nameSpace, &typeId, &isConst) < 0) continue;
+        hashString(h, nameSpace ? nameSpace : "");
+        hashString(h, name ? name : "");
+        hashString(h, engine->GetTypeDeclaration(typeId, true));
+        hashBytes(h, &isConst, sizeof(isConst));
+    }
+    return h;
+}
+
+// Registration is done once per engine; walking every declaration on each
+// build would cost more than the cache saves
+struct EngineHash {
+    asIScriptEngine* engine = nullptr;
+    asUINT functions = 0;
+    asUINT types = 0;
+    uint64_t hash = 0;
+};
+
+uint64_t engineIdentity(asIScriptEngine* engine) {
+    static EngineHash cached;
+    asUINT functions = engine->GetGlobalFunctionCount();
+    asUINT types = engine->GetObjectTypeCount();
+    if (cached.engine != engine || cached.functions != functions || cached.types != types) {
+        cached = {engine, functions, types, hashEngine(engine)};
+    }
+    return cached.hash;
+}
+
+} // namespace
+
+// =============================================================================
+// tcBytecodeCache
+// =============================================================================
+
+uint64_t tcBytecodeCache::hashSections(const Sections& sections, asIScriptEngine* engine) {
+    uint64_t h = kFnvOffset;
+    hashString(h, asGetLibraryVersion());
+    hashString(h, asGetLibraryOptions());
+    if (engine) {
+        uint64_t identity = engineIdentity(engine);
+        hashBytes(h, &identity, sizeof(identity));
+    }
+    for (const auto& [name, code] : sections) {
+        hashString(h, name);
+        hashString(h, code);
+    }
+    return h;
+}
+
+bool tcBytecodeCache::load(uint64_t key, asIScriptModule* module) {
+    if (!module) return false;
+
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        std::vector<asBYTE> data;
+        if (!readFile(key, data)) return false;
+        insert(key, std::move(data));
+        it = entries_.find(key);
+    }
+
+    MemoryStream stream(it->second);
+    if (module->LoadByteCode(&stream) < 0) {
+        // Stale or corrupt entry - drop it so the next run rebuilds cleanly
+        remove(key);
+        return false;
+    }
+    return true;
+}
+
+void tcBytecodeCache::store(uint64_t key, asIScriptModule* module) {
+    if (!module) return;
+
+    MemoryStream stream;
+    if (module->SaveByteCode(&stream) < 0) return;
+
+    writeFile(key, stream.data());
+    insert(key, std::move(stream.data()));
+}
+
+void tcBytecodeCache::remove(uint64_t key) {
+    entries_.erase(key);
+    order_.erase(std::remove(order_.begin(), order_.end(), key), order_.end());
+    if (!directory_.empty()) {
+        std::error_code ec;
+        std::filesystem::remove(pathFor(key), ec);
+    }
+}
+
+void tcBytecodeCache::clear() {
+    entries_.clear();
+    order_.clear();
+}
+
+void tcBytecodeCache::setDirectory(const std::string& dir) {
+    directory_ = dir;
+    if (!directory_.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(directory_, ec);
+    }
+}
+
+std::string tcBytecodeCache::pathFor(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.asbc", static_cast<unsigned long long>(key));
+    return directory_ + "/" + name;
+}
+
+bool tcBytecodeCache::readFile(uint64_t key, std::vector<asBYTE>& out) const {
+    if (directory_.empty()) return false;
+
+    std::ifstream file(pathFor(key), std::ios::binary);
+    if (!file) return false;
+
+    out.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return !out.empty();
+}
+
+void tcBytecodeCache::writeFile(uint64_t key, const std::vector<asBYTE>& data) const {
+    if (directory_.empty()) return;
+
+    std::ofstream file(pathFor(key), std::ios::binary | std::ios::trunc);
+    if (!file) return;
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+}
+
+void tcBytecodeCache::insert(uint64_t key, std::vector<asBYTE> data) {
+    if (entries_.find(key) == entries_.end()) {
+        order_.push_back(key);
+    }
+    entries_[key] = std::move(data);
+
+    while (entries_.size() > maxEntries_ && !order_.empty()) {
+        entries_.erase(order_.front());
+        order_.pop_front();
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+// =============================================================================
+// tcBytecodeCache - compiled script cache keyed by source hash
+//
+// Stores SaveByteCode() output so an unchanged script can be restored with
+// LoadByteCode() instead of being parsed and compiled again. Entries live in
+// memory and, if a directory is set, are mirrored to the filesystem (on the
+// web this is the Emscripten FS - mount IDBFS there to survive page reloads).
+// =============================================================================
+
+#include <angelscript.h>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class tcBytecodeCache {
+public:
+    using Sections = std::vector<std::pair<std::string, std::string>>;
+
+    // Hash of all sections (name + code, in order) plus the engine identity,
+    // so bytecode from a different library build or API is never reused
+    static uint64_t hashSections(const Sections& sections, asIScriptEngine* engine);
+
+    // Restore a module from cached bytecode. The module must be empty.
+    // Returns false on miss or if the bytecode no longer loads.
+    bool load(uint64_t key, asIScriptModule* module);
+
+    // Save a successfully built module
+    void store(uint64_t key, asIScriptModule* module);
+
+    void remove(uint64_t key);
+    void clear();
+
+    // Optional on-disk mirror (empty = memory only)
+    void setDirectory(const std::string& dir);
+    const std::string& getDirectory() const { return directory_; }
+
+    void setMaxEntries(size_t n) { maxEntries_ = n; }
+    size_t size() const { return entries_.size(); }
+
+private:
+    std::string pathFor(uint64_t key) const;
+    bool readFile(uint64_t key, std::vector<asBYTE>& out) const;
+    void writeFile(uint64_t key, const std::vector<asBYTE>& data) const;
+    void insert(uint64_t key, std::vector<asBYTE> data);
+
+    std::unordered_map<uint64_t, std::vector<asBYTE>> entries_;
+    std::deque<uint64_t> order_;  // insertion order for eviction
+    std::string directory_;
+    size_t maxEntries_ = 16;
+};
@@ -0,0 +1,257 @@
+#include "tcChipSynth.h"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+using namespace tc;
+
+// Every live synth; mixAll() only try_locks, so the audio thread never waits
+// on a script creating or releasing one
+static std::mutex g_synthsMutex;
+static std::vector<tcChipSynth*> g_synths;
+
+tcChipSynth::tcChipSynth(int voices)
+    : voiceCount_(std::clamp(voices, 1, kMaxVoices)) {
+    std::lock_guard<std::mutex> lock(g_synthsMutex);
+    g_synths.push_back(this);
+}
+
+tcChipSynth::~tcChipSynth() {
+    std::lock_guard<std::mutex> lock(g_synthsMutex);
+    g_synths.erase(std::remove(g_synths.begin(), g_synths.end(), this), g_synths.end());
+}
+
+// =============================================================================
+// Script thread
+// =============================================================================
+
+bool tcChipSynth::push(const Command& command) {
+    size_t head = queueHead_.load(std::memory_order_relaxed);
+    if (head - queueTail_.load(std::memory_order_acquire) >= kQueueSize) return false;
+    queue_[head % kQueueSize] = command;
+    queueHead_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool tcChipSynth::play(const ChipSoundNote& note, double delaySeconds) {
+    uint64_t delay = static_cast<uint64_t>(std::max(0.0, delaySeconds) * getSampleRate() + 0.5);
+    return playAt(note, getFrame() + delay);
+}
+
+bool tcChipSynth::playAt(const ChipSoundNote& note, uint64_t frame) {
+    return push({Command::Play, frame, note});
+}
+
+bool tcChipSynth::stopAll() {
+    return push({Command::Stop, 0, ChipSoundNote()});
+}
+
+// =============================================================================
+// Audio thread
+// =============================================================================
+
+void tcChipSynth::drainQueue() {
+    size_t tail = queueTail_.load(std::memory_order_relaxed);
+    size_t head = queueHead_.load(std::memory_order_acquire);
+    for (; tail != head; tail++) {
+        const Command& command = queue_[tail % kQueueSize];
+        if (command.type == Command::Stop) {
+            pendingCount_ = 0;
+            for (Voice& voice : voices_) voice.active = false;
+        } else if (pendingCount_ < kMaxPending) {
+            pending_[pendingCount_++] = command;
+        } else {
+            // Too many notes waiting: replace the latest one
+            auto latest = std::max_element(pending_.begin(), pending_.begin() + pendingCount_,
+                [](const Command& a, const Command& b) { return a.frame < b.frame; });
+            if (command.frame < latest->frame) *latest = command;
+        }
+    }
+    queueTail_.store(tail, std::memory_order_release);
+}
+
+void tcChipSynth::startVoice(const ChipSoundNote& note, int sampleRate) {
+    // A free voice, else steal the oldest
+    Voice* voice = &voices_[0];
+    for (int i = 0; i < voiceCount_; i++) {
+        Voice& candidate = voices_[i];
+        if (!candidate.active) {
+            voice = &candidate;
+            break;
+        }
+        if (candidate.age > voice->age) voice = &candidate;
+    }
+
+    auto frames = [sampleRate](float seconds) {
+        return static_cast<uint32_t>(std::max(0.0f, seconds) * sampleRate + 0.5f);
+    };
+    Voice& v = *voice;
+    v.active = true;
+    v.wave = note.wave;
+    v.phase = 0.0f;
+    v.increment = std::max(0.0f, note.hz) / sampleRate;
+    v.volume = note.volume;
+    v.age = 0;
+    v.attack = frames(note.attack);
+    v.decay = frames(note.decay);
+    v.gate = frames(note.duration);
+    v.release = frames(note.release);
+    v.sustain = std::clamp(note.sustain, 0.0f, 1.0f);
+    v.pink[0] = v.pink[1] = v.pink[2] = 0.0f;
+    noiseSeed_ = noiseSeed_ * 1664525u + 1013904223u;
+    v.noise = noiseSeed_ | 1u;
+
+    // Level the release starts from (the gate may close during attack/decay)
+    if (v.gate < v.attack) {
+        v.releaseFrom = static_cast<float>(v.gate) / v.attack;
+    } else if (v.gate < v.attack + v.decay) {
+        v.releaseFrom = 1.0f - (1.0f - v.sustain) * (v.gate - v.attack) / v.decay;
+    } else {
+        v.releaseFrom = v.sustain;
+    }
+}
+
+// Oscillator and envelope into stack blocks, then one multiply-add into the
+// mix. Each loop is branch-free per sample so the compiler can vectorize it.
+void tcChipSynth::renderVoice(Voice& v, float* mix, int frames) {
+    float osc[kBlock];
+    float env[kBlock];
+
+    float phase = v.phase;
+    const float inc = v.increment;
+    switch (v.wave) {
+    case Wave::Sin:
+        for (int i = 0; i < frames; i++) {
+            osc[i] = std::sin((phase + inc * i) * 6.28318530718f);
+        }
+        break;
+    case Wave::Square:
+        for (int i = 0; i < frames; i++) {
+            float p = phase + inc * i;
+            osc[i] = (p - std::floor(p)) < 0.5f ? 1.0f : -1.0f;
+        }
+        break;
+    case Wave::Triangle:
+        for (int i = 0; i < frames; i++) {
+            float p = phase + inc * i;
+            osc[i] = 4.0f * std::fabs(p - std::floor(p) - 0.5f) - 1.0f;
+        }
+        break;
+    case Wave::Sawtooth:
+        for (int i = 0; i < frames; i++) {
+            float p = phase + inc * i;
+            osc[i] = 2.0f * (p - std::floor(p)) - 1.0f;
+        }
+        break;
+    case Wave::Noise:
+        for (int i = 0; i < frames; i++) {
+            v.noise ^= v.noise << 13;
+            v.noise ^= v.noise >> 17;
+            v.noise ^= v.noise << 5;
+            osc[i] = static_cast<int32_t>(v.noise) * (1.0f / 2147483648.0f);
+        }
+        break;
+    case Wave::PinkNoise:
+        // Paul Kellet's economy filter over white noise
+        for (int i = 0; i < frames; i++) {
+            v.noise ^= v.noise << 13;
+            v.noise ^= v.noise >> 17;
+            v.noise ^= v.noise << 5;
+            float white = static_cast<int32_t>(v.noise) * (1.0f / 2147483648.0f);
+            v.pink[0] = 0.99765f * v.pink[0] + white * 0.0990460f;
+            v.pink[1] = 0.96300f * v.pink[1] + white * 0.2965164f;
+            v.pink[2] = 0.57000f * v.pink[2] + white * 1.0526913f;
+            osc[i] = (v.pink[0] + v.pink[1] + v.pink[2] + white * 0.1848f) * 0.25f;
+        }
+        break;
+    default:
+        std::fill(osc, osc + frames, 0.0f);
+        break;
+    }
+    phase += inc * frames;
+    v.phase = phase - std::floor(phase);
+
+    const uint32_t decayEnd = v.attack + v.decay;
+    const uint32_t end = v.gate + v.release;
+    for (int i = 0; i < frames; i++) {
+        uint32_t age = v.age + i;
+        float level;
+        if (age >= v.gate) {
+            level = age >= end ? 0.0f : v.releaseFrom * (1.0f - static_cast<float>(age - v.gate) / v.release);
+        } else if (age < v.attack) {
+            level = static_cast<float>(age) / v.attack;
+        } else if (age < decayEnd) {
+            level = 1.0f - (1.0f - v.sustain) * (age - v.attack) / v.decay;
+        } else {
+            level = v.sustain;
+        }
+        env[i] = level * v.volume;
+    }
+    v.age += frames;
+    if (v.age >= end) v.active = false;
+
+    for (int i = 0; i < frames; i++) mix[i] += osc[i] * env[i];
+}
+
+// Renders into 'mono' (added to what is there). Blocks are cut at every
+// pending note's frame, so notes start on their exact sample.
+void tcChipSynth::render(float* mono, int frames, int sampleRate) {
+    drainQueue();
+
+    float block[kBlock];
+    const uint64_t start = frame_.load(std::memory_order_relaxed);
+    int done = 0;
+    while (done < frames) {
+        const uint64_t now = start + done;
+        int count = std::min(kBlock, frames - done);
+        for (size_t i = 0; i < pendingCount_;) {
+            if (pending_[i].frame <= now) {
+                startVoice(pending_[i].note, sampleRate);
+                pending_[i] = pending_[--pendingCount_];
+            } else {
+                count = static_cast<int>(std::min<uint64_t>(count, pending_[i].frame - now));
+                i++;
+            }
+        }
+
+        std::fill(block, block + count, 0.0f);
+        for (int v = 0; v < voiceCount_; v++) {
+            if (voices_[v].active) renderVoice(voices_[v], block, count);
+        }
+        const float volume = getVolume();
+        float* out = mono + done;
+        for (int i = 0; i < count; i++) out[i] += block[i] * volume;
+        done += count;
+    }
+
+    int active = 0;
+    for (int v = 0; v < voiceCount_; v++) active += voices_[v].active;
+    activeVoices_.store(active, std::memory_order_relaxed);
+    frame_.store(start + frames, std::memory_order_release);
+}
+
+void tcChipSynth::mixAll(float* out, int frames, int channels, int sampleRate) {
+    if (frames <= 0 || channels <= 0) return;
+    std::fill(out, out + static_cast<size_t>(frames) * channels, 0.0f);
+    if (sampleRate > 0) sampleRate_.store(sampleRate, std::memory_order_relaxed);
+
+    std::unique_lock<std::mutex> lock(g_synthsMutex, std::try_to_lock);
+    if (!lock.owns_lock() || g_synths.empty()) return;
+
+    // Mono slices, then spread to every channel
+    constexpr int kSlice = 256;
+    float mono[kSlice];
+    for (int done = 0; done < frames; done += kSlice) {
+        int count = std::min(kSlice, frames - done);
+        std::fill(mono, mono + count, 0.0f);
+        for (tcChipSynth* synth : g_synths) synth->render(mono, count, getSampleRate());
+
+        float* frame = out + static_cast<size_t>(done) * channels;
+        for (int i = 0; i < count; i++) {
+            float sample = std::clamp(mono[i], -1.0f, 1.0f);
+            for (int c = 0; c < channels; c++) frame[c] = sample;
+            frame += channels;
+        }
+    }
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+// =============================================================================
+// tcChipSynth - streaming chip voices rendered in the audio callback
+//
+// ChipSoundNote.build() renders a whole note into a Sound buffer up front.
+// tcChipSynth renders the same oscillators (the Wave set plus ADSR) block by
+// block while the audio plays: memory is a fixed voice pool and a fixed
+// command queue, and a note costs nothing until it sounds.
+//
+// Threads: play() / stopAll() / setVolume() are called on the script thread
+// and only push commands into a lock-free queue. mixAll() runs on the audio
+// thread, drains the queues and starts every note at its exact sample frame.
+// A note's envelope: attack, decay to the sustain level, hold until
+// 'duration' has passed, then release.
+//
+// Output: the audio callback opened by tcAudioOutput (or the app's own audio
+// stream) calls mixAll(). mixAll() never blocks; while a synth is being
+// created or destroyed it outputs one block of silence.
+// =============================================================================
+
+#include <TrussC.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+class tcChipSynth {
+public:
+    static constexpr int kMaxVoices = 64;
+    static constexpr int kDefaultSampleRate = 44100;
+
+    explicit tcChipSynth(int voices = 16);
+    ~tcChipSynth();
+
+    tcChipSynth(const tcChipSynth&) = delete;
+    tcChipSynth& operator=(const tcChipSynth&) = delete;
+
+    // Script thread. Returns false if the command queue is full (the audio
+    // callback is not running).
+    bool play(const tc::ChipSoundNote& note, double delaySeconds = 0.0);
+    bool playAt(const tc::ChipSoundNote& note, uint64_t frame);
+    // Silences every voice and drops notes not started yet
+    bool stopAll();
+
+    void setVolume(float volume) { volume_.store(volume, std::memory_order_relaxed); }
+    float getVolume() const { return volume_.load(std::memory_order_relaxed); }
+
+    int getVoiceCount() const { return voiceCount_; }
+    int getActiveVoices() const { return activeVoices_.load(std::memory_order_relaxed); }
+
+    // Synth clock: frames rendered so far (advances only while audio runs)
+    uint64_t getFrame() const { return frame_.load(std::memory_order_acquire); }
+
+    // Audio thread: overwrite 'out' (interleaved) with every synth's output
+    static void mixAll(float* out, int frames, int channels, int sampleRate);
+    static int getSampleRate() { return sampleRate_.load(std::memory_order_relaxed); }
+
+private:
+    struct Command {
+        enum Type : uint8_t { Play, Stop } type;
+        uint64_t frame;
+        tc::ChipSoundNote note;
+    };
+
+    struct Voice {
+        bool active = false;
+        tc::Wave wave = tc::Wave::Square;
+        float phase = 0.0f;
+        float increment = 0.0f;     // phase per frame (cycles)
+        float volume = 0.0f;
+        uint32_t age = 0;           // frames since the note started
+        uint32_t attack = 0, decay = 0, gate = 0, release = 0;
+        float sustain = 1.0f;
+        float releaseFrom = 0.0f;   // envelope level when the gate closed
+        uint32_t noise = 1;
+        float pink[3] = {};
+    };
+
+    // Render block: envelope and oscillator are computed into stack arrays of
+    // this many frames, then mixed
+    static constexpr int kBlock = 64;
+    static constexpr size_t kQueueSize = 512;
+    static constexpr size_t kMaxPending = 256;
+
+    bool push(const Command& command);
+    void drainQueue();
+    void startVoice(const tc::ChipSoundNote& note, int sampleRate);
+    void renderVoice(Voice& voice, float* mix, int frames);
+    void render(float* mono, int frames, int sampleRate);
+
+    // Single producer (script thread) / single consumer (audio thread)
+    std::array<Command, kQueueSize> queue_;
+    std::atomic<size_t> queueHead_{0};   // next write
+    std::atomic<size_t> queueTail_{0};   // next read
+
+    // Audio thread only
+    std::array<Command, kMaxPending> pending_;
+    size_t pendingCount_ = 0;
+    std::array<Voice, kMaxVoices> voices_;
+    uint32_t noiseSeed_ = 0x9E3779B9u;
+
+    int voiceCount_;
+    std::atomic<float> volume_{1.0f};
+    std::atomic<int> activeVoices_{0};
+    std::atomic<uint64_t> frame_{0};
+
+    static inline std::atomic<int> sampleRate_{kDefaultSampleRate};
+};
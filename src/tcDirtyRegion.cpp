@@ -0,0 +1,127 @@
+#include "tcDirtyRegion.h"
+#include <algorithm>
+#include <limits>
+
+// Sub-rectangle uploads need the GL texture behind a sokol image
+#if defined(SOKOL_GLES3)
+#define TC_DIRTY_SUBIMAGE 1
+#include <GLES3/gl3.h>
+#elif defined(SOKOL_GLCORE)
+#define TC_DIRTY_SUBIMAGE 1
+#if defined(__APPLE__)
+#include <OpenGL/gl3.h>
+#else
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+#include <GL/gl.h>
+#endif
+#endif
+
+namespace {
+
+using Box = tcDirtyRegion::Box;
+
+// Overlapping or sharing an edge / corner
+bool touches(const Box& a, const Box& b) {
+    return a.x0 <= b.x1 && b.x0 <= a.x1 && a.y0 <= b.y1 && b.y0 <= a.y1;
+}
+
+bool contains(const Box& outer, const Box& inner) {
+    return outer.x0 <= inner.x0 && outer.y0 <= inner.y0 && inner.x1 <= outer.x1 && inner.y1 <= outer.y1;
+}
+
+Box unite(const Box& a, const Box& b) {
+    return { std::min(a.x0, b.x0), std::min(a.y0, b.y0), std::max(a.x1, b.x1), std::max(a.y1, b.y1) };
+}
+
+} // namespace
+
+void tcDirtyRegion::add(int x, int y, int w, int h, int imageWidth, int imageHeight) {
+    Box box = { std::max(x, 0), std::max(y, 0), std::min(x + w, imageWidth), std::min(y + h, imageHeight) };
+    if (box.x0 >= box.x1 || box.y0 >= box.y1) return;
+
+    // setColor() in a loop mostly lands inside a box it already grew
+    for (const Box& b : boxes_) {
+        if (contains(b, box)) return;
+    }
+    insert(box);
+}
+
+void tcDirtyRegion::insert(Box box) {
+    // Absorb every box the new one touches; the union may reach further ones
+    for (size_t i = 0; i < boxes_.size();) {
+        if (touches(boxes_[i], box)) {
+            box = unite(box, boxes_[i]);
+            boxes_[i] = boxes_.back();
+            boxes_.pop_back();
+            i = 0;
+        } else {
+            i++;
+        }
+    }
+    boxes_.push_back(box);
+    if (boxes_.size() <= kMaxBoxes) return;
+
+    // Too many boxes: merge the pair whose union adds the least area
+    size_t bestA = 0, bestB = 1;
+    long long bestWaste = std::numeric_limits<long long>::max();
+    for (size_t a = 0; a < boxes_.size(); a++) {
+        for (size_t b = a + 1; b < boxes_.size(); b++) {
+            long long waste = unite(boxes_[a], boxes_[b]).area() - boxes_[a].area() - boxes_[b].area();
+            if (waste < bestWaste) {
+                bestWaste = waste;
+                bestA = a;
+                bestB = b;
+            }
+        }
+    }
+    Box merged = unite(boxes_[bestA], boxes_[bestB]);
+    boxes_.erase(boxes_.begin() + bestB);
+    boxes_.erase(boxes_.begin() + bestA);
+    insert(merged);
+}
+
+long long tcDirtyRegion::area() const {
+    long long total = 0;
+    for (const Box& b : boxes_) total += b.area();
+    return total;
+}
+
+bool tcDirtyRegion::upload(tc::Texture& texture, const tc::Pixels& pixels) const {
+#ifdef TC_DIRTY_SUBIMAGE
+    // sokol textures are RGBA8; other channel counts are converted on upload
+    if (!texture.isAllocated() || !pixels.isAllocated() || pixels.getChannels() != 4 ||
+        texture.getWidth() != pixels.getWidth() || texture.getHeight() != pixels.getHeight()) {
+        return false;
+    }
+    sg_gl_image_info info = sg_gl_query_image_info(texture.getImage());
+    GLuint tex = info.tex[info.active_slot];
+    if (tex == 0) return false;
+    GLenum target = info.tex_target ? info.tex_target : GL_TEXTURE_2D;
+
+    GLint alignment = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+    glBindTexture(target, tex);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, pixels.getWidth());
+    for (const Box& box : boxes_) {
+        glPixelStorei(GL_UNPACK_SKIP_PIXELS, box.x0);
+        glPixelStorei(GL_UNPACK_SKIP_ROWS, box.y0);
+        glTexSubImage2D(target, 0, box.x0, box.y0, box.x1 - box.x0, box.y1 - box.y0,
+            GL_RGBA, GL_UNSIGNED_BYTE, pixels.getData());
+    }
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+    glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+    glBindTexture(target, 0);
+    // sokol caches GL bindings - it must not assume its own are still bound
+    sg_reset_state_cache();
+    return true;
+#else
+    (void)texture;
+    (void)pixels;
+    return false;
+#endif
+}
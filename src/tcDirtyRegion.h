@@ -0,0 +1,65 @@
+#pragma once
+
+// =============================================================================
+// tcDirtyRegion - changed areas of an image between texture uploads
+//
+// Image.setColor() adds the pixel it wrote; nearby and overlapping boxes are
+// merged, so a brush stroke grows one box instead of adding thousands. At
+// most kMaxBoxes are kept - past that, the two boxes whose union wastes the
+// least area are merged.
+//
+// sg_update_image has no sub-rectangle, so upload() goes around sokol_gfx on
+// its GL backends (the web build included): one glTexSubImage2D per box into
+// the texture sokol created. Other backends have no such path and the caller
+// uploads the whole image. tcUploadStats reports how many of the uploaded
+// bytes had actually changed.
+// =============================================================================
+
+#include <TrussC.h>
+#include <cstddef>
+#include <vector>
+
+class tcDirtyRegion {
+public:
+    static constexpr size_t kMaxBoxes = 8;
+
+    // Half-open pixel box [x0, x1) x [y0, y1)
+    struct Box {
+        int x0, y0, x1, y1;
+        long long area() const { return static_cast<long long>(x1 - x0) * (y1 - y0); }
+    };
+
+    // Adds a rectangle, clipped to the image size
+    void add(int x, int y, int w, int h, int imageWidth, int imageHeight);
+    void addAll(int imageWidth, int imageHeight) { add(0, 0, imageWidth, imageHeight, imageWidth, imageHeight); }
+    void clear() { boxes_.clear(); }
+
+    bool empty() const { return boxes_.empty(); }
+    const std::vector<Box>& getBoxes() const { return boxes_; }
+    // Pixels covered by the boxes (they never overlap after merging)
+    long long area() const;
+
+    // Sends only the boxes of 'pixels' to 'texture', which must already hold
+    // an upload of the same size. Returns false if the backend can't update
+    // part of a texture (or the formats don't allow it) - nothing was sent.
+    bool upload(tc::Texture& texture, const tc::Pixels& pixels) const;
+
+private:
+    void insert(Box box);
+
+    std::vector<Box> boxes_;
+};
+
+// Texture uploads made by Image.update() and Texture.loadData()
+struct tcUploadStats {
+    static inline size_t uploads = 0;       // uploads sent to the GPU
+    static inline size_t skipped = 0;       // update() calls with nothing changed
+    static inline size_t bytes = 0;         // bytes sent
+    static inline size_t dirtyBytes = 0;    // of those, bytes inside dirty regions
+
+    static void add(size_t sent, size_t dirty) {
+        uploads++;
+        bytes += sent;
+        dirtyBytes += dirty;
+    }
+};
@@ -0,0 +1,199 @@
+#include "tcDisplayList.h"
+#include <cmath>
+
+using namespace tc;
+
+tcDisplayList::~tcDisplayList() {
+    if (recording == this) recording = nullptr;
+}
+
+void tcDisplayList::begin() {
+    clear();
+    recording = this;
+}
+
+void tcDisplayList::end() {
+    if (recording == this) recording = nullptr;
+}
+
+void tcDisplayList::clear() {
+    commands_.clear();
+    args_.clear();
+    texts_.clear();
+    baked_.reset();
+}
+
+// =============================================================================
+// Recording
+// =============================================================================
+
+void tcDisplayList::record(Op op, Replay replay, std::initializer_list<float> args) {
+    commands_.push_back({replay, static_cast<uint32_t>(args_.size()), kNoText, op});
+    args_.insert(args_.end(), args);
+}
+
+void tcDisplayList::recordText(Replay replay, const std::string& text, float x, float y) {
+    commands_.push_back({replay, static_cast<uint32_t>(args_.size()), static_cast<uint32_t>(texts_.size()), Op::Other});
+    args_.push_back(x);
+    args_.push_back(y);
+    texts_.push_back(text);
+}
+
+void tcDisplayList::append(const tcDisplayList& other) {
+    uint32_t argBase = static_cast<uint32_t>(args_.size());
+    uint32_t textBase = static_cast<uint32_t>(texts_.size());
+    for (Command command : other.commands_) {
+        command.args += argBase;
+        if (command.text != kNoText) command.text += textBase;
+        commands_.push_back(command);
+    }
+    args_.insert(args_.end(), other.args_.begin(), other.args_.end());
+    texts_.insert(texts_.end(), other.texts_.begin(), other.texts_.end());
+}
+
+// =============================================================================
+// Replay
+// =============================================================================
+
+void tcDisplayList::draw() const {
+    if (recording) {
+        // Drawing a list into another one copies its commands
+        if (recording != this) recording->append(*this);
+        return;
+    }
+
+    if (baked_) {
+        if (baked_->hasTriangles) baked_->triangles.draw();
+        if (baked_->hasLines) baked_->lines.draw();
+        if (baked_->setsColor) setColor(baked_->color.r, baked_->color.g, baked_->color.b, baked_->color.a);
+        if (baked_->fill == 1) fill();
+        else if (baked_->fill == 0) noFill();
+        if (baked_->strokeWeight >= 0.0f) setStrokeWeight(baked_->strokeWeight);
+        return;
+    }
+
+    const float* args = args_.data();
+    for (const Command& command : commands_) {
+        command.replay(args + command.args, command.text != kNoText ? &texts_[command.text] : nullptr);
+    }
+}
+
+// =============================================================================
+// Baking
+// =============================================================================
+
+bool tcDisplayList::bake() {
+    if (isBaked()) return true;
+
+    struct Style {
+        bool hasColor = false;
+        Color color;
+        bool fill = true;           // TrussC default
+        float strokeWeight = 1.0f;
+        bool fillSet = false;
+        bool strokeWeightSet = false;
+    };
+
+    auto baked = std::make_unique<Baked>();
+    baked->triangles.setMode(PrimitiveMode::Triangles);
+    baked->lines.setMode(PrimitiveMode::Lines);
+
+    Style style;
+    std::vector<Style> styleStack;
+    std::vector<Mat4> matrixStack = { Mat4::identity() };
+    int circleResolution = getCircleResolution();
+    constexpr float kTau = 6.28318530718f;
+    constexpr float kDegToRad = kTau / 360.0f;
+
+    auto triangle = [&](float x1, float y1, float x2, float y2, float x3, float y3) {
+        const Mat4& m = matrixStack.back();
+        baked->triangles.addVertex(m * Vec3(x1, y1, 0.0f));
+        baked->triangles.addVertex(m * Vec3(x2, y2, 0.0f));
+        baked->triangles.addVertex(m * Vec3(x3, y3, 0.0f));
+        for (int i = 0; i < 3; i++) baked->triangles.addColor(style.color);
+        baked->hasTriangles = true;
+    };
+
+    for (const Command& command : commands_) {
+        const float* a = args_.data() + command.args;
+        Mat4& m = matrixStack.back();
+
+        // Transforms outside push/popMatrix would carry over to whatever is
+        // drawn after the list, which a baked mesh cannot reproduce
+        bool transform = command.op >= Op::ResetMatrix && command.op <= Op::Scale2;
+        if (transform && (matrixStack.size() == 1 || command.op == Op::ResetMatrix)) return false;
+
+        // Shapes need a known color and fill state
+        bool shape = command.op >= Op::Rect;
+        if (shape && !style.hasColor) return false;
+
+        switch (command.op) {
+            case Op::SetColor1: style.color = Color(a[0], a[0], a[0], 1.0f); style.hasColor = true; break;
+            case Op::SetColor3: style.color = Color(a[0], a[1], a[2], 1.0f); style.hasColor = true; break;
+            case Op::SetColor4: style.color = Color(a[0], a[1], a[2], a[3]); style.hasColor = true; break;
+            case Op::Fill: style.fill = true; style.fillSet = true; break;
+            case Op::NoFill: style.fill = false; style.fillSet = true; break;
+            case Op::StrokeWeight: style.strokeWeight = a[0]; style.strokeWeightSet = true; break;
+            case Op::CircleResolution: circleResolution = static_cast<int>(a[0]); break;
+            case Op::PushStyle: styleStack.push_back(style); break;
+            case Op::PopStyle:
+                if (styleStack.empty()) return false;
+                style = styleStack.back();
+                styleStack.pop_back();
+                break;
+
+            case Op::PushMatrix: matrixStack.push_back(m); break;
+            case Op::PopMatrix:
+                if (matrixStack.size() == 1) return false;
+                matrixStack.pop_back();
+                break;
+            case Op::Translate2: m = m * Mat4::translate(a[0], a[1], 0.0f); break;
+            case Op::Translate3: m = m * Mat4::translate(a[0], a[1], a[2]); break;
+            case Op::Rotate:
+            case Op::RotateZ: m = m * Mat4::rotateZ(a[0]); break;
+            case Op::RotateDeg:
+            case Op::RotateZDeg: m = m * Mat4::rotateZ(a[0] * kDegToRad); break;
+            case Op::Scale1: m = m * Mat4::scale(a[0], a[0], 1.0f); break;
+            case Op::Scale2: m = m * Mat4::scale(a[0], a[1], 1.0f); break;
+
+            case Op::Rect:
+                if (!style.fill) return false;
+                triangle(a[0], a[1], a[0] + a[2], a[1], a[0] + a[2], a[1] + a[3]);
+                triangle(a[0], a[1], a[0] + a[2], a[1] + a[3], a[0], a[1] + a[3]);
+                break;
+            case Op::Circle:
+                if (!style.fill || circleResolution < 3) return false;
+                for (int i = 0; i < circleResolution; i++) {
+                    float t0 = kTau * i / circleResolution;
+                    float t1 = kTau * (i + 1) / circleResolution;
+                    triangle(a[0], a[1],
+                             a[0] + std::cos(t0) * a[2], a[1] + std::sin(t0) * a[2],
+                             a[0] + std::cos(t1) * a[2], a[1] + std::sin(t1) * a[2]);
+                }
+                break;
+            case Op::Triangle:
+                if (!style.fill) return false;
+                triangle(a[0], a[1], a[2], a[3], a[4], a[5]);
+                break;
+            case Op::Line:
+                if (style.strokeWeight != 1.0f) return false;
+                baked->lines.addVertex(m * Vec3(a[0], a[1], 0.0f));
+                baked->lines.addVertex(m * Vec3(a[2], a[3], 0.0f));
+                baked->lines.addColor(style.color);
+                baked->lines.addColor(style.color);
+                baked->hasLines = true;
+                break;
+
+            default:
+                return false;
+        }
+    }
+    if (matrixStack.size() != 1 || !styleStack.empty()) return false;
+
+    baked->setsColor = style.hasColor;
+    baked->color = style.color;
+    baked->fill = style.fillSet ? (style.fill ? 1 : 0) : -1;
+    baked->strokeWeight = style.strokeWeightSet ? style.strokeWeight : -1.0f;
+    baked_ = std::move(baked);
+    return true;
+}
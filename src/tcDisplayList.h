@@ -0,0 +1,91 @@
+#pragma once
+
+// =============================================================================
+// tcDisplayList - recorded immediate-mode drawing, replayed in one call
+//
+// Between begin() and end() the immediate-mode bindings (drawRect, setColor,
+// translate, ...) append a command to the recording list instead of drawing.
+// draw() replays the commands with direct TrussC calls, so a static scene of
+// hundreds of shapes costs one script call per frame.
+//
+// bake() goes one step further for plain 2D content: filled rects, circles
+// and triangles plus lines, under translate / rotate / scale, are turned into
+// one triangle mesh and one line mesh with vertex colors (lines end up on
+// top of all triangles). The list must set
+// its color before the first shape; fill and a stroke weight of 1 are
+// assumed unless it changes them. Lists using anything else stay in replay
+// mode.
+// =============================================================================
+
+#include <TrussC.h>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+class tcDisplayList {
+public:
+    // Commands bake() understands; everything else is Other
+    enum class Op : uint8_t {
+        Other,
+        SetColor1, SetColor3, SetColor4,
+        Fill, NoFill, StrokeWeight, CircleResolution, PushStyle, PopStyle,
+        PushMatrix, PopMatrix, ResetMatrix,
+        Translate2, Translate3, Rotate, RotateDeg, RotateZ, RotateZDeg, Scale1, Scale2,
+        Rect, Circle, Line, Triangle,
+    };
+
+    // Replays one command from its recorded arguments
+    using Replay = void (*)(const float* args, const std::string* text);
+
+    // The list being recorded, or nullptr (checked by the bindings)
+    static inline tcDisplayList* recording = nullptr;
+
+    ~tcDisplayList();
+
+    // Start recording (drops previous contents). Recording another list
+    // ends this one.
+    void begin();
+    void end();
+    bool isRecording() const { return recording == this; }
+
+    void record(Op op, Replay replay, std::initializer_list<float> args = {});
+    void recordText(Replay replay, const std::string& text, float x, float y);
+
+    void draw() const;
+    void clear();
+    size_t size() const { return commands_.size(); }
+
+    // Convert to meshes; false if the list uses commands that cannot be baked
+    bool bake();
+    bool isBaked() const { return baked_ != nullptr; }
+
+private:
+    struct Command {
+        Replay replay;
+        uint32_t args;      // index of the first argument in args_
+        uint32_t text;      // index into texts_, or kNoText
+        Op op;
+    };
+    static constexpr uint32_t kNoText = UINT32_MAX;
+
+    struct Baked {
+        tc::Mesh triangles;
+        tc::Mesh lines;
+        bool hasTriangles = false;
+        bool hasLines = false;
+        // Style left behind by the recorded commands, restored after drawing
+        bool setsColor = false;
+        tc::Color color;
+        int fill = -1;      // -1 untouched, 0 noFill, 1 fill
+        float strokeWeight = -1.0f;
+    };
+
+    void append(const tcDisplayList& other);
+
+    std::vector<Command> commands_;
+    std::vector<float> args_;
+    std::vector<std::string> texts_;
+    std::unique_ptr<Baked> baked_;
+};
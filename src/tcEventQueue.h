@@ -0,0 +1,86 @@
+#pragma once
+
+// =============================================================================
+// tcEventQueue - input events collected between frames
+//
+// tcApp pushes OS events here instead of calling into the script right away;
+// tcScriptHost dispatches the whole queue once per frame before update().
+// Consecutive mouse moves (and drags with the same button) are merged into
+// the latest one, so a high-rate pointer costs one script call per frame.
+// =============================================================================
+
+#include <array>
+#include <cstddef>
+
+// Also registered as the script value type 'InputEvent'
+struct InputEvent {
+    enum Type : int {
+        MousePressed,
+        MouseReleased,
+        MouseMoved,
+        MouseDragged,
+        KeyPressed,
+        KeyReleased,
+        WindowResized,
+    };
+
+    int type = MouseMoved;
+    float x = 0.0f;     // mouse position, or new width for WindowResized
+    float y = 0.0f;     // mouse position, or new height for WindowResized
+    int button = 0;
+    int key = 0;
+};
+
+class tcEventQueue {
+public:
+    static constexpr size_t kCapacity = 256;
+
+    void setCoalesceMoves(bool enabled) { coalesceMoves_ = enabled; }
+    bool isCoalesceMoves() const { return coalesceMoves_; }
+
+    void push(const InputEvent& event) {
+        if (count_ > 0 && canMerge(back(), event)) {
+            back() = event;
+            return;
+        }
+        if (count_ == kCapacity) {
+            // Full: drop the oldest event
+            head_ = (head_ + 1) % kCapacity;
+            count_--;
+            dropped_++;
+        }
+        events_[(head_ + count_) % kCapacity] = event;
+        count_++;
+    }
+
+    bool empty() const { return count_ == 0; }
+    size_t size() const { return count_; }
+    const InputEvent& operator[](size_t i) const { return events_[(head_ + i) % kCapacity]; }
+
+    void clear() {
+        head_ = 0;
+        count_ = 0;
+    }
+
+    // Events lost to overflow since startup
+    size_t getDroppedCount() const { return dropped_; }
+
+private:
+    InputEvent& back() { return events_[(head_ + count_ - 1) % kCapacity]; }
+
+    bool canMerge(const InputEvent& last, const InputEvent& next) const {
+        if (last.type != next.type) return false;
+        switch (next.type) {
+            case InputEvent::MouseMoved: return coalesceMoves_;
+            case InputEvent::MouseDragged: return coalesceMoves_ && last.button == next.button;
+            case InputEvent::WindowResized: return true;  // only the final size matters
+            default: return false;
+        }
+    }
+
+    std::array<InputEvent, kCapacity> events_;
+    size_t head_ = 0;
+    size_t count_ = 0;
+    size_t dropped_ = 0;
+    bool coalesceMoves_ = true;
+};
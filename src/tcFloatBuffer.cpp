@@ -0,0 +1,92 @@
+#include "tcFloatBuffer.h"
+#include <TrussC.h>
+#include <algorithm>
+#include <cmath>
+
+// =============================================================================
+// Loops
+// =============================================================================
+
+// The unit-stride branch is the one worth vectorizing; keep it a plain loop
+template<typename F>
+void tcFloatBuffer::apply(size_t offset, size_t stride, F f) {
+    size_t n = count(offset, stride);
+    float* p = data_.data() + offset;
+    if (stride == 1) {
+        for (size_t i = 0; i < n; i++) p[i] = f(p[i]);
+    } else {
+        for (size_t i = 0; i < n; i++) p[i * stride] = f(p[i * stride]);
+    }
+}
+
+template<typename F>
+void tcFloatBuffer::apply(const tcFloatBuffer& other, size_t offset, size_t stride, F f) {
+    size_t n = std::min(count(offset, stride), other.count(offset, stride));
+    float* p = data_.data() + offset;
+    const float* q = other.data_.data() + offset;
+    if (stride == 1) {
+        for (size_t i = 0; i < n; i++) p[i] = f(p[i], q[i]);
+    } else {
+        for (size_t i = 0; i < n; i++) p[i * stride] = f(p[i * stride], q[i * stride]);
+    }
+}
+
+// =============================================================================
+// Kernels
+// =============================================================================
+
+void tcFloatBuffer::fill(float value, size_t offset, size_t stride) {
+    apply(offset, stride, [value](float) { return value; });
+}
+
+void tcFloatBuffer::add(float value, size_t offset, size_t stride) {
+    apply(offset, stride, [value](float a) { return a + value; });
+}
+
+void tcFloatBuffer::mul(float value, size_t offset, size_t stride) {
+    apply(offset, stride, [value](float a) { return a * value; });
+}
+
+void tcFloatBuffer::clamp(float lo, float hi, size_t offset, size_t stride) {
+    apply(offset, stride, [lo, hi](float a) { return std::min(std::max(a, lo), hi); });
+}
+
+void tcFloatBuffer::sin(size_t offset, size_t stride) {
+    apply(offset, stride, [](float a) { return std::sin(a); });
+}
+
+void tcFloatBuffer::cos(size_t offset, size_t stride) {
+    apply(offset, stride, [](float a) { return std::cos(a); });
+}
+
+void tcFloatBuffer::add(const tcFloatBuffer& other, size_t offset, size_t stride) {
+    apply(other, offset, stride, [](float a, float b) { return a + b; });
+}
+
+void tcFloatBuffer::mul(const tcFloatBuffer& other, size_t offset, size_t stride) {
+    apply(other, offset, stride, [](float a, float b) { return a * b; });
+}
+
+void tcFloatBuffer::fma(const tcFloatBuffer& other, float scale, size_t offset, size_t stride) {
+    apply(other, offset, stride, [scale](float a, float b) { return a + b * scale; });
+}
+
+void tcFloatBuffer::lerp(const tcFloatBuffer& other, float t, size_t offset, size_t stride) {
+    apply(other, offset, stride, [t](float a, float b) { return a + (b - a) * t; });
+}
+
+void tcFloatBuffer::fillRandom(float min, float max, size_t offset, size_t stride) {
+    apply(offset, stride, [min, max](float) { return tc::random(min, max); });
+}
+
+void tcFloatBuffer::fillNoise(float x, float y, float step, size_t offset, size_t stride) {
+    size_t k = 0;
+    apply(offset, stride, [&](float) { return tc::noise(x + step * k++, y); });
+}
+
+void tcFloatBuffer::copyFrom(const tcFloatBuffer& src, size_t srcOffset, size_t srcStride, size_t offset, size_t stride) {
+    size_t n = std::min(count(offset, stride), src.count(srcOffset, srcStride));
+    float* p = data_.data() + offset;
+    const float* q = src.data_.data() + srcOffset;
+    for (size_t i = 0; i < n; i++) p[i * stride] = q[i * srcStride];
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+// =============================================================================
+// tcFloatBuffer - contiguous float storage with bulk kernels for scripts
+//
+// Every array<float> element access is a bounds-checked script operation.
+// FloatBuffer keeps its values in one 16-byte aligned block and does the
+// per-element math in native loops (add, mul, fma, clamp, lerp, sin, cos,
+// noise and random fills). The unit-stride loops are plain enough for the
+// compiler to vectorize (SSE on desktop, SIMD128 on wasm when enabled).
+//
+// Every kernel takes an offset and a stride, so one channel of interleaved
+// data (e.g. the y of x, y, radius triples) can be processed on its own:
+// the kernel touches elements offset, offset + stride, ... up to size().
+// Kernels with a second buffer read the same positions from it and stop at
+// the shorter of the two.
+//
+// Mesh, Pixels and the batched draw functions read data() in place.
+// =============================================================================
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+class tcFloatBuffer {
+public:
+    static constexpr size_t kAlignment = 16;
+
+    explicit tcFloatBuffer(size_t size = 0) : data_(size, 0.0f) {}
+
+    void resize(size_t size) { data_.resize(size, 0.0f); }
+    size_t size() const { return data_.size(); }
+    float* data() { return data_.data(); }
+    const float* data() const { return data_.data(); }
+    float& operator[](size_t i) { return data_[i]; }
+    float operator[](size_t i) const { return data_[i]; }
+
+    // Number of elements a kernel with this offset / stride touches
+    size_t count(size_t offset, size_t stride) const {
+        return offset < data_.size() ? (data_.size() - offset + stride - 1) / stride : 0;
+    }
+
+    void fill(float value, size_t offset = 0, size_t stride = 1);
+    void add(float value, size_t offset = 0, size_t stride = 1);
+    void mul(float value, size_t offset = 0, size_t stride = 1);
+    void clamp(float lo, float hi, size_t offset = 0, size_t stride = 1);
+    void sin(size_t offset = 0, size_t stride = 1);
+    void cos(size_t offset = 0, size_t stride = 1);
+
+    // this += other / this *= other / this += other * scale / this += (other - this) * t
+    void add(const tcFloatBuffer& other, size_t offset = 0, size_t stride = 1);
+    void mul(const tcFloatBuffer& other, size_t offset = 0, size_t stride = 1);
+    void fma(const tcFloatBuffer& other, float scale, size_t offset = 0, size_t stride = 1);
+    void lerp(const tcFloatBuffer& other, float t, size_t offset = 0, size_t stride = 1);
+
+    // Uniform random values in [min, max)
+    void fillRandom(float min, float max, size_t offset = 0, size_t stride = 1);
+    // Element k gets noise(x + k * step, y)
+    void fillNoise(float x, float y, float step, size_t offset = 0, size_t stride = 1);
+
+    // Strided copy; stops at the end of either buffer
+    void copyFrom(const tcFloatBuffer& src, size_t srcOffset, size_t srcStride, size_t offset, size_t stride);
+
+private:
+    template<typename T>
+    struct AlignedAllocator {
+        using value_type = T;
+        AlignedAllocator() = default;
+        template<typename U> AlignedAllocator(const AlignedAllocator<U>&) {}
+        T* allocate(size_t n) {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(kAlignment)));
+        }
+        void deallocate(T* p, size_t) { ::operator delete(p, std::align_val_t(kAlignment)); }
+        template<typename U> bool operator==(const AlignedAllocator<U>&) const { return true; }
+        template<typename U> bool operator!=(const AlignedAllocator<U>&) const { return false; }
+    };
+
+    template<typename F> void apply(size_t offset, size_t stride, F f);
+    template<typename F> void apply(const tcFloatBuffer& other, size_t offset, size_t stride, F f);
+
+    std::vector<float, AlignedAllocator<float>> data_;
+};
@@ -0,0 +1,31 @@
+#include "tcFrameStats.h"
+#include <algorithm>
+#include <cstdio>
+
+void tcTimingStats::appendJson(std::string& out) const {
+    std::array<double, kWindow> sorted;
+    std::copy(samples_.begin(), samples_.begin() + size_, sorted.begin());
+    std::sort(sorted.begin(), sorted.begin() + size_);
+
+    double sum = 0.0;
+    std::array<size_t, kBuckets> hist{};
+    for (size_t i = 0; i < size_; i++) {
+        sum += sorted[i];
+        size_t b = 0;
+        while (b < kBucketMs.size() && sorted[i] > kBucketMs[b]) b++;
+        hist[b]++;
+    }
+    auto percentile = [&](double p) {
+        return size_ ? sorted[std::min(size_ - 1, static_cast<size_t>(p * size_))] : 0.0;
+    };
+
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), "{\"n\":%zu,\"last\":%.3f,\"mean\":%.3f,\"p50\":%.3f,\"p99\":%.3f,\"max\":%.3f,\"hist\":[",
+        total_, last_, size_ ? sum / size_ : 0.0, percentile(0.50), percentile(0.99), size_ ? sorted[size_ - 1] : 0.0);
+    out += buf;
+    for (size_t b = 0; b < kBuckets; b++) {
+        std::snprintf(buf, sizeof(buf), b ? ",%zu" : "%zu", hist[b]);
+        out += buf;
+    }
+    out += "]}";
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+// =============================================================================
+// tcFrameStats - rolling timing histograms for the perf HUD
+//
+// tcScriptHost times compiles, update(), draw(), event dispatch and garbage
+// collection into one tcTimingStats each. Every stat keeps the last kWindow
+// samples, so mean / percentiles / histogram describe the last few seconds
+// rather than the whole session. Recording is a clock read and a ring buffer
+// store; the summary is only computed when a snapshot is requested.
+// =============================================================================
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+class tcTimingStats {
+public:
+    static constexpr size_t kWindow = 240;     // ~4 seconds at 60 fps
+
+    // Histogram bucket upper bounds in ms (the last bucket is open-ended)
+    static constexpr std::array<double, 9> kBucketMs = { 0.1, 0.25, 0.5, 1, 2, 4, 8, 16, 33 };
+    static constexpr size_t kBuckets = kBucketMs.size() + 1;
+
+    void add(double ms) {
+        samples_[next_] = ms;
+        next_ = (next_ + 1) % kWindow;
+        if (size_ < kWindow) size_++;
+        total_++;
+        last_ = ms;
+    }
+
+    size_t getTotalCount() const { return total_; }
+    double getLast() const { return last_; }
+
+    void clear() {
+        size_ = 0;
+        next_ = 0;
+        total_ = 0;
+        last_ = 0.0;
+    }
+
+    // {"n":total,"last":ms,"mean":ms,"p50":ms,"p99":ms,"max":ms,"hist":[...]}
+    void appendJson(std::string& out) const;
+
+private:
+    std::array<double, kWindow> samples_{};
+    size_t next_ = 0;
+    size_t size_ = 0;
+    size_t total_ = 0;
+    double last_ = 0.0;
+};
+
+// Adds the time from construction to destruction to a tcTimingStats
+class tcScopedTiming {
+public:
+    explicit tcScopedTiming(tcTimingStats& stats)
+        : stats_(stats), start_(std::chrono::steady_clock::now()) {}
+    ~tcScopedTiming() {
+        stats_.add(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_).count());
+    }
+
+    tcScopedTiming(const tcScopedTiming&) = delete;
+    tcScopedTiming& operator=(const tcScopedTiming&) = delete;
+
+private:
+    tcTimingStats& stats_;
+    std::chrono::steady_clock::time_point start_;
+};
@@ -0,0 +1,122 @@
+#pragma once
+
+// =============================================================================
+// tcHeadless - null graphics backend for the headless benchmark runner
+//
+// TrussC has no windowless mode, so TCSCRIPT_HEADLESS builds stub out the
+// binding layer instead: calls that need a window, GPU or audio device
+// (drawing, transforms, textures, fonts, sounds, input state) are marked after
+// registration and skipped at call time. A skipped call returns zero / false
+// / an empty value and is counted in Stats, everything else (math, meshes,
+// paths, pixels, tweens, the script itself) runs for real.
+//
+// The check happens in the generic thunk, so TCSCRIPT_HEADLESS forces the
+// generic calling convention just like the web build.
+// =============================================================================
+
+#include <angelscript.h>
+#include <cstring>
+#include <new>
+#include <string>
+#include "tcProfiler.h"
+
+namespace tcheadless {
+
+// Function user data slot marking a call as skipped
+constexpr asPWORD kNullCallUserData = 0x7C51;
+
+struct Stats {
+    static inline size_t nullCalls = 0;     // skipped calls since startup
+};
+
+// Write the default value for the function's return type
+inline void setDefaultReturn(asIScriptGeneric* gen) {
+    asIScriptEngine* engine = gen->GetEngine();
+    int typeId = gen->GetFunction()->GetReturnTypeId();
+    if (typeId == asTYPEID_VOID) return;
+
+    if (!(typeId & asTYPEID_MASK_OBJECT)) {
+        // Primitive or enum
+        switch (engine->GetSizeOfPrimitiveType(typeId)) {
+            case 1: gen->SetReturnByte(0); break;
+            case 2: gen->SetReturnWord(0); break;
+            case 8: gen->SetReturnQWord(0); break;
+            default: gen->SetReturnDWord(0); break;
+        }
+        return;
+    }
+
+    asITypeInfo* type = engine->GetTypeInfoById(typeId);
+    if (std::strcmp(type->GetName(), "string") == 0) {
+        new (gen->GetAddressOfReturnLocation()) std::string();
+    } else {
+        std::memset(gen->GetAddressOfReturnLocation(), 0, type->GetSize());
+    }
+}
+
+// Generic calling convention wrapper that skips marked calls
+template<asGENFUNC_t F>
+struct NullableGeneric {
+    static void call(asIScriptGeneric* gen) {
+        if (gen->GetFunction()->GetUserData(kNullCallUserData)) {
+            ++Stats::nullCalls;
+            setDefaultReturn(gen);
+            return;
+        }
+        F(gen);
+    }
+};
+
+// Only calls whose result can be faked can be skipped: no handles or
+// references, and value types must be POD (or string)
+inline bool canSkip(asIScriptEngine* engine, asIScriptFunction* func) {
+    asDWORD flags = 0;
+    int typeId = func->GetReturnTypeId(&flags);
+    if (flags != asTM_NONE) return false;
+    if (typeId == asTYPEID_VOID || !(typeId & asTYPEID_MASK_OBJECT)) return true;
+    if (typeId & asTYPEID_OBJHANDLE) return false;
+
+    asITypeInfo* type = engine->GetTypeInfoById(typeId);
+    if (!type) return false;
+    if (std::strcmp(type->GetName(), "string") == 0) return true;
+    return (type->GetFlags() & asOBJ_POD) != 0;
+}
+
+inline void skip(asIScriptEngine* engine, asIScriptFunction* func) {
+    static int marker;
+    if (canSkip(engine, func)) {
+        func->SetUserData(&marker, kNullCallUserData);
+    }
+}
+
+// Mark the calls that need a window, GPU or audio device. Call after all
+// functions are registered (global functions must carry their profiler
+// category, see tcScriptHost::registerTrussCFunctions).
+inline void markNullCalls(asIScriptEngine* engine) {
+    static const char* const categories[] = { "graphics", "transform", "input", "system" };
+    for (asUINT i = 0; i < engine->GetGlobalFunctionCount(); i++) {
+        asIScriptFunction* func = engine->GetGlobalFunctionByIndex(i);
+        const char* category = static_cast<const char*>(func->GetUserData(tcProfiler::kCategoryUserData));
+        if (!category) continue;
+        for (const char* c : categories) {
+            if (std::strcmp(category, c) == 0) skip(engine, func);
+        }
+    }
+
+    // Types backed by GPU or audio resources are skipped entirely; elsewhere
+    // only the draw calls are
+    static const char* const types[] = { "Texture", "Fbo", "Font", "Image", "EasyCam", "Sound" };
+    for (asUINT i = 0; i < engine->GetObjectTypeCount(); i++) {
+        asITypeInfo* type = engine->GetObjectTypeByIndex(i);
+        bool all = false;
+        for (const char* t : types) {
+            if (std::strcmp(type->GetName(), t) == 0) all = true;
+        }
+        for (asUINT m = 0; m < type->GetMethodCount(); m++) {
+            asIScriptFunction* func = type->GetMethodByIndex(m);
+            if (all || std::strncmp(func->GetName(), "draw", 4) == 0) skip(engine, func);
+        }
+    }
+}
+
+} // namespace tcheadless
@@ -0,0 +1,163 @@
+#include "tcParticleSystem.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace tc;
+
+void tcParticleSystem::setMaxParticles(size_t max) {
+    maxParticles_ = max;
+    if (count_ > max) {
+        count_ = max;
+        for (tcFloatBuffer& c : columns_) c.resize(count_);
+    }
+}
+
+void tcParticleSystem::clear() {
+    count_ = 0;
+    for (tcFloatBuffer& c : columns_) c.resize(0);
+}
+
+void tcParticleSystem::syncColumns() {
+    for (tcFloatBuffer& c : columns_) {
+        if (c.size() != count_) c.resize(count_);
+    }
+}
+
+// =============================================================================
+// Emit
+// =============================================================================
+
+size_t tcParticleSystem::emit(size_t count, float x, float y) {
+    syncColumns();
+    count = std::min(count, maxParticles_ > count_ ? maxParticles_ - count_ : 0);
+    if (count == 0) return 0;
+
+    size_t first = count_;
+    count_ += count;
+    for (tcFloatBuffer& c : columns_) c.resize(count_);
+
+    float* px = columns_[PosX].data();
+    float* py = columns_[PosY].data();
+    float* vx = columns_[VelX].data();
+    float* vy = columns_[VelY].data();
+    float* life = columns_[Life].data();
+    float* size = columns_[Size].data();
+    for (size_t i = first; i < count_; i++) {
+        float angle = direction_ + random(-0.5f, 0.5f) * spread_;
+        float speed = random(speedMin_, speedMax_);
+        px[i] = x;
+        py[i] = y;
+        vx[i] = std::cos(angle) * speed;
+        vy[i] = std::sin(angle) * speed;
+        life[i] = random(lifeMin_, lifeMax_);
+        size[i] = random(sizeMin_, sizeMax_);
+    }
+    // Age is already 0 from resize()
+    columns_[ColorR].fill(color_.r, first);
+    columns_[ColorG].fill(color_.g, first);
+    columns_[ColorB].fill(color_.b, first);
+    columns_[ColorA].fill(color_.a, first);
+
+    if (emitHook_) emitHook_(*this, first, count);
+    return count;
+}
+
+// =============================================================================
+// Update
+// =============================================================================
+
+void tcParticleSystem::update(float dt) {
+    syncColumns();
+    size_t n = count_;
+    float* px = columns_[PosX].data();
+    float* py = columns_[PosY].data();
+    float* vx = columns_[VelX].data();
+    float* vy = columns_[VelY].data();
+    float* age = columns_[Age].data();
+
+    if (noiseStrength_ != 0.0f) {
+        noiseTime_ += dt;
+        float push = noiseStrength_ * dt;
+        for (size_t i = 0; i < n; i++) {
+            float angle = noise(px[i] * noiseScale_, py[i] * noiseScale_, noiseTime_ * 0.5f) * 12.5663706144f;
+            vx[i] += std::cos(angle) * push;
+            vy[i] += std::sin(angle) * push;
+        }
+    }
+
+    // Plain unit-stride loops, left for the compiler to vectorize
+    float gx = gravityX_ * dt;
+    float gy = gravityY_ * dt;
+    float damping = std::max(0.0f, 1.0f - drag_ * dt);
+    for (size_t i = 0; i < n; i++) vx[i] = (vx[i] + gx) * damping;
+    for (size_t i = 0; i < n; i++) vy[i] = (vy[i] + gy) * damping;
+    for (size_t i = 0; i < n; i++) px[i] += vx[i] * dt;
+    for (size_t i = 0; i < n; i++) py[i] += vy[i] * dt;
+    for (size_t i = 0; i < n; i++) age[i] += dt;
+
+    killDead();
+    if (updateHook_ && count_ > 0) updateHook_(*this, 0, count_);
+}
+
+void tcParticleSystem::killDead() {
+    const float* age = columns_[Age].data();
+    const float* life = columns_[Life].data();
+    size_t i = 0;
+    while (i < count_) {
+        if (age[i] < life[i]) {
+            i++;
+            continue;
+        }
+        count_--;
+        for (tcFloatBuffer& c : columns_) c[i] = c[count_];
+    }
+    for (tcFloatBuffer& c : columns_) c.resize(count_);
+}
+
+// =============================================================================
+// Draw
+// =============================================================================
+
+void tcParticleSystem::draw() const {
+    // Columns resized by a script since the last update only draw what they cover
+    size_t n = count_;
+    for (const tcFloatBuffer& c : columns_) n = std::min(n, c.size());
+    if (n == 0) return;
+
+    const float* px = columns_[PosX].data();
+    const float* py = columns_[PosY].data();
+    const float* age = columns_[Age].data();
+    const float* life = columns_[Life].data();
+    const float* size = columns_[Size].data();
+    const float* r = columns_[ColorR].data();
+    const float* g = columns_[ColorG].data();
+    const float* b = columns_[ColorB].data();
+    const float* a = columns_[ColorA].data();
+
+    float unitX[kMaxResolution], unitY[kMaxResolution];
+    int sides = resolution_;
+    for (int k = 0; k < sides; k++) {
+        float t = 6.28318530718f * k / sides;
+        unitX[k] = std::cos(t);
+        unitY[k] = std::sin(t);
+    }
+
+    mesh_.clear();
+    mesh_.setMode(PrimitiveMode::Triangles);
+    uint32_t base = 0;
+    for (size_t i = 0; i < n; i++) {
+        float alpha = a[i];
+        if (fadeOut_ && life[i] > 0.0f) alpha *= std::max(0.0f, 1.0f - age[i] / life[i]);
+        Color color(r[i], g[i], b[i], alpha);
+
+        mesh_.addVertex(px[i], py[i]);
+        mesh_.addColor(color);
+        for (int k = 0; k < sides; k++) {
+            mesh_.addVertex(px[i] + unitX[k] * size[i], py[i] + unitY[k] * size[i]);
+            mesh_.addColor(color);
+            mesh_.addTriangle(base, base + 1 + k, base + 1 + (k + 1) % sides);
+        }
+        base += sides + 1;
+    }
+    mesh_.draw();
+}
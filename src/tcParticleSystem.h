@@ -0,0 +1,99 @@
+#pragma once
+
+// =============================================================================
+// tcParticleSystem - native particles stored as float columns
+//
+// Position, velocity, age, life, size and color each live in their own
+// tcFloatBuffer (struct of arrays), so emit, integrate and draw run as tight
+// native loops instead of script loops over array<Vec2> / array<Color>.
+//
+// update(dt) applies gravity, drag and an optional noise force, integrates,
+// ages the particles and removes the dead ones by moving the last particle
+// into their slot (order is not preserved). draw() renders every particle as
+// a filled polygon with one mesh.
+//
+// Scripts customize behaviour per batch, not per particle: the emit hook
+// sees the index range of each freshly emitted batch, the update hook runs
+// once per update over all live particles, and both can work on the columns
+// with the FloatBuffer kernels.
+// =============================================================================
+
+#include "tcFloatBuffer.h"
+#include <TrussC.h>
+#include <algorithm>
+#include <functional>
+
+class tcParticleSystem {
+public:
+    enum Column { PosX, PosY, VelX, VelY, Age, Life, Size, ColorR, ColorG, ColorB, ColorA, ColumnCount };
+
+    // Called with the index range of a batch of particles
+    using BatchHook = std::function<void(tcParticleSystem& system, size_t first, size_t count)>;
+
+    explicit tcParticleSystem(size_t maxParticles = 10000) : maxParticles_(maxParticles) {}
+
+    size_t size() const { return count_; }
+    void setMaxParticles(size_t max);
+    size_t getMaxParticles() const { return maxParticles_; }
+
+    // The column holds one value per live particle
+    tcFloatBuffer& column(Column c) { return columns_[c]; }
+
+    // Emitter settings (angles in radians, life in seconds)
+    void setSpeed(float min, float max) { speedMin_ = min; speedMax_ = max; }
+    void setDirection(float angle, float spread) { direction_ = angle; spread_ = spread; }
+    void setLife(float min, float max) { lifeMin_ = min; lifeMax_ = max; }
+    void setSize(float min, float max) { sizeMin_ = min; sizeMax_ = max; }
+    void setColor(const tc::Color& color) { color_ = color; }
+
+    // Forces. Drag is the fraction of velocity lost per second; the noise
+    // force pushes particles along a slowly changing noise field.
+    void setGravity(float x, float y) { gravityX_ = x; gravityY_ = y; }
+    void setDrag(float drag) { drag_ = drag; }
+    void setNoiseForce(float strength, float scale) { noiseStrength_ = strength; noiseScale_ = scale; }
+
+    // Alpha fades out over each particle's life (applied when drawing)
+    void setFadeOut(bool fade) { fadeOut_ = fade; }
+    // Polygon sides used by draw()
+    static constexpr int kMaxResolution = 64;
+    void setResolution(int sides) { resolution_ = std::clamp(sides, 3, kMaxResolution); }
+
+    void setEmitHook(BatchHook hook) { emitHook_ = std::move(hook); }
+    void setUpdateHook(BatchHook hook) { updateHook_ = std::move(hook); }
+    const BatchHook& getEmitHook() const { return emitHook_; }
+    const BatchHook& getUpdateHook() const { return updateHook_; }
+
+    // Emit up to `count` particles at (x, y); returns how many were emitted
+    size_t emit(size_t count, float x, float y);
+    void update(float dt);
+    void draw() const;
+    void clear();
+
+private:
+    // Scripts may resize a column; bring them all back to count_
+    void syncColumns();
+    void killDead();
+
+    tcFloatBuffer columns_[ColumnCount];
+    size_t count_ = 0;
+    size_t maxParticles_;
+
+    float speedMin_ = 50.0f, speedMax_ = 100.0f;
+    float direction_ = 0.0f, spread_ = 6.28318530718f;
+    float lifeMin_ = 1.0f, lifeMax_ = 2.0f;
+    float sizeMin_ = 2.0f, sizeMax_ = 4.0f;
+    tc::Color color_ = tc::Color(1.0f, 1.0f, 1.0f, 1.0f);
+
+    float gravityX_ = 0.0f, gravityY_ = 0.0f;
+    float drag_ = 0.0f;
+    float noiseStrength_ = 0.0f, noiseScale_ = 0.01f;
+    float noiseTime_ = 0.0f;
+
+    bool fadeOut_ = false;
+    int resolution_ = 8;
+
+    BatchHook emitHook_;
+    BatchHook updateHook_;
+
+    mutable tc::Mesh mesh_;
+};
@@ -0,0 +1,237 @@
+#include "tcPixelKernels.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+#include <thread>
+#endif
+
+using namespace tc;
+
+namespace {
+
+// =============================================================================
+// Work splitting
+// =============================================================================
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+
+template<typename F>
+void parallelFor(int count, size_t, F f) {
+    f(0, count);
+}
+
+#else
+
+// Below this many bytes, starting threads costs more than it saves
+constexpr size_t kMinParallelBytes = 256 * 1024;
+constexpr unsigned kMaxWorkers = 8;
+
+// Calls f(begin, end) over [0, count), split across threads for big images
+template<typename F>
+void parallelFor(int count, size_t bytes, F f) {
+    unsigned workers = bytes >= kMinParallelBytes ? std::thread::hardware_concurrency() : 1;
+    workers = std::min({std::max(workers, 1u), kMaxWorkers, static_cast<unsigned>(std::max(count, 1))});
+    if (workers == 1) {
+        f(0, count);
+        return;
+    }
+    int chunk = (count + static_cast<int>(workers) - 1) / static_cast<int>(workers);
+    std::vector<std::thread> threads;
+    for (int begin = chunk; begin < count; begin += chunk) {
+        threads.emplace_back(f, begin, std::min(count, begin + chunk));
+    }
+    f(0, std::min(count, chunk));
+    for (std::thread& thread : threads) thread.join();
+}
+
+#endif
+
+struct Image8 {
+    unsigned char* data;
+    int width, height, channels;
+    size_t rowBytes;
+    size_t bytes;
+};
+
+bool view(Pixels& pixels, Image8& image) {
+    if (!pixels.isAllocated()) return false;
+    image.data = pixels.getData();
+    image.width = pixels.getWidth();
+    image.height = pixels.getHeight();
+    image.channels = pixels.getChannels();
+    image.rowBytes = static_cast<size_t>(image.width) * image.channels;
+    image.bytes = image.rowBytes * image.height;
+    return image.data && image.bytes > 0;
+}
+
+// Channels holding color (the rest is alpha)
+int colorChannels(int channels) {
+    return channels >= 3 ? 3 : 1;
+}
+
+unsigned char toByte(float v) {
+    return static_cast<unsigned char>(std::min(std::max(v, 0.0f), 255.0f) + 0.5f);
+}
+
+template<typename Op>
+void blendWith(Image8& dst, const unsigned char* src, float amount, Op op) {
+    parallelFor(dst.height, dst.bytes, [&](int y0, int y1) {
+        for (int y = y0; y < y1; y++) {
+            unsigned char* d = dst.data + y * dst.rowBytes;
+            const unsigned char* s = src + y * dst.rowBytes;
+            for (size_t i = 0; i < dst.rowBytes; i++) {
+                float a = d[i];
+                d[i] = toByte(a + (op(a, static_cast<float>(s[i])) - a) * amount);
+            }
+        }
+    });
+}
+
+} // namespace
+
+namespace tcpixels {
+
+// =============================================================================
+// Kernels
+// =============================================================================
+
+void fill(Pixels& pixels, const Color& color) {
+    Image8 image;
+    if (!view(pixels, image)) return;
+
+    unsigned char value[4];
+    switch (image.channels) {
+        case 1: value[0] = toByte(color.r * 255.0f); break;
+        case 2: value[0] = toByte(color.r * 255.0f); value[1] = toByte(color.a * 255.0f); break;
+        default:
+            value[0] = toByte(color.r * 255.0f);
+            value[1] = toByte(color.g * 255.0f);
+            value[2] = toByte(color.b * 255.0f);
+            value[3] = toByte(color.a * 255.0f);
+            break;
+    }
+    int channels = std::min(image.channels, 4);
+
+    // Fill the first row, then copy it
+    unsigned char* row = image.data;
+    for (int x = 0; x < image.width; x++) std::memcpy(row + x * image.channels, value, channels);
+    for (int y = 1; y < image.height; y++) std::memcpy(image.data + y * image.rowBytes, row, image.rowBytes);
+}
+
+void blur(Pixels& pixels, int radius) {
+    Image8 image;
+    if (radius < 1 || !view(pixels, image)) return;
+
+    const int w = image.width, h = image.height, ch = image.channels;
+    const int window = 2 * radius + 1;
+    std::vector<unsigned char> tmp(image.bytes);
+
+    // Horizontal pass (image -> tmp): running sum along each row
+    parallelFor(h, image.bytes, [&](int y0, int y1) {
+        for (int y = y0; y < y1; y++) {
+            const unsigned char* in = image.data + y * image.rowBytes;
+            unsigned char* out = tmp.data() + y * image.rowBytes;
+            for (int c = 0; c < ch; c++) {
+                int sum = 0;
+                for (int k = -radius; k <= radius; k++) sum += in[std::clamp(k, 0, w - 1) * ch + c];
+                for (int x = 0; x < w; x++) {
+                    out[x * ch + c] = static_cast<unsigned char>((sum + window / 2) / window);
+                    sum += in[std::min(x + radius + 1, w - 1) * ch + c] - in[std::max(x - radius, 0) * ch + c];
+                }
+            }
+        }
+    });
+
+    // Vertical pass (tmp -> image): running sums for a range of byte columns,
+    // walking down the rows so memory is read in order
+    parallelFor(static_cast<int>(image.rowBytes), image.bytes, [&](int b0, int b1) {
+        std::vector<int> sum(b1 - b0, 0);
+        for (int k = -radius; k <= radius; k++) {
+            const unsigned char* row = tmp.data() + std::clamp(k, 0, h - 1) * image.rowBytes;
+            for (int i = b0; i < b1; i++) sum[i - b0] += row[i];
+        }
+        for (int y = 0; y < h; y++) {
+            unsigned char* out = image.data + y * image.rowBytes;
+            const unsigned char* add = tmp.data() + std::min(y + radius + 1, h - 1) * image.rowBytes;
+            const unsigned char* sub = tmp.data() + std::max(y - radius, 0) * image.rowBytes;
+            for (int i = b0; i < b1; i++) {
+                out[i] = static_cast<unsigned char>((sum[i - b0] + window / 2) / window);
+                sum[i - b0] += add[i] - sub[i];
+            }
+        }
+    });
+}
+
+void threshold(Pixels& pixels, float level) {
+    Image8 image;
+    if (!view(pixels, image)) return;
+
+    const int ch = image.channels;
+    const int color = colorChannels(ch);
+    const float cut = level * 255.0f;
+    parallelFor(image.height, image.bytes, [&](int y0, int y1) {
+        for (int y = y0; y < y1; y++) {
+            unsigned char* p = image.data + y * image.rowBytes;
+            for (int x = 0; x < image.width; x++, p += ch) {
+                float lum = color == 3 ? p[0] * 0.299f + p[1] * 0.587f + p[2] * 0.114f : p[0];
+                unsigned char v = lum >= cut ? 255 : 0;
+                for (int c = 0; c < color; c++) p[c] = v;
+            }
+        }
+    });
+}
+
+void convolve(Pixels& pixels, const float* kernel, int size) {
+    Image8 image;
+    if (size < 1 || size % 2 == 0 || !view(pixels, image)) return;
+
+    const int w = image.width, h = image.height, ch = image.channels;
+    const int color = colorChannels(ch);
+    const int half = size / 2;
+    std::vector<unsigned char> src(image.data, image.data + image.bytes);
+
+    parallelFor(h, image.bytes * size, [&](int y0, int y1) {
+        for (int y = y0; y < y1; y++) {
+            unsigned char* out = image.data + y * image.rowBytes;
+            for (int x = 0; x < w; x++) {
+                float acc[3] = {0.0f, 0.0f, 0.0f};
+                for (int ky = 0; ky < size; ky++) {
+                    const unsigned char* row = src.data() + std::clamp(y + ky - half, 0, h - 1) * image.rowBytes;
+                    for (int kx = 0; kx < size; kx++) {
+                        const unsigned char* p = row + std::clamp(x + kx - half, 0, w - 1) * ch;
+                        float k = kernel[ky * size + kx];
+                        for (int c = 0; c < color; c++) acc[c] += p[c] * k;
+                    }
+                }
+                for (int c = 0; c < color; c++) out[x * ch + c] = toByte(acc[c]);
+            }
+        }
+    });
+}
+
+void blend(Pixels& dst, const Pixels& src, Blend mode, float amount) {
+    Image8 image;
+    if (!view(dst, image) || !src.isAllocated()) return;
+    if (src.getWidth() != image.width || src.getHeight() != image.height || src.getChannels() != image.channels) return;
+
+    const unsigned char* s = src.getData();
+    amount = std::min(std::max(amount, 0.0f), 1.0f);
+    switch (mode) {
+        case Blend::Mix:
+            blendWith(image, s, amount, [](float, float b) { return b; });
+            break;
+        case Blend::Add:
+            blendWith(image, s, amount, [](float a, float b) { return std::min(a + b, 255.0f); });
+            break;
+        case Blend::Multiply:
+            blendWith(image, s, amount, [](float a, float b) { return a * b * (1.0f / 255.0f); });
+            break;
+        case Blend::Screen:
+            blendWith(image, s, amount, [](float a, float b) { return 255.0f - (255.0f - a) * (255.0f - b) * (1.0f / 255.0f); });
+            break;
+    }
+}
+
+} // namespace tcpixels
@@ -0,0 +1,36 @@
+#pragma once
+
+// =============================================================================
+// tcPixelKernels - whole-image operations on Pixels
+//
+// Native loops for what a script would otherwise do with one getColor /
+// setColor call per pixel: fill, box blur, threshold, convolution and
+// blending. They work on 8-bit Pixels with 1-4 channels.
+//
+// Large images are split by rows (or columns) across worker threads on
+// native builds. Wasm builds without pthreads run on the calling thread.
+// =============================================================================
+
+#include <TrussC.h>
+#include <cstddef>
+
+namespace tcpixels {
+
+enum class Blend { Mix, Add, Multiply, Screen };
+
+void fill(tc::Pixels& pixels, const tc::Color& color);
+
+// Box blur with the given radius in pixels (all channels)
+void blur(tc::Pixels& pixels, int radius);
+
+// Color channels become 0 or 1 depending on luminance >= level (0-1); alpha is kept
+void threshold(tc::Pixels& pixels, float level);
+
+// size x size kernel (size odd), applied to the color channels with clamped
+// edges; alpha is kept. The kernel is used as given, not normalized.
+void convolve(tc::Pixels& pixels, const float* kernel, int size);
+
+// Blend src into dst (same size and channel count); amount 0-1
+void blend(tc::Pixels& dst, const tc::Pixels& src, Blend mode, float amount);
+
+} // namespace tcpixels
@@ -0,0 +1,149 @@
+#include "tcProfiler.h"
+#include <cstdio>
+
+tcProfiler::~tcProfiler() {
+    if (active == this) active = nullptr;
+}
+
+void tcProfiler::setEnabled(bool enabled) {
+    if (enabled) {
+        if (active == this) return;
+        clear();
+        active = this;
+    } else if (active == this) {
+        endAll();
+        active = nullptr;
+    }
+}
+
+void tcProfiler::clear() {
+    events_.clear();
+    names_.clear();
+    functionIds_.clear();
+    spanIds_.clear();
+    openSpans_ = 0;
+    droppedSpans_ = 0;
+    truncated_ = false;
+    start_ = std::chrono::steady_clock::now();
+}
+
+// =============================================================================
+// Recording
+// =============================================================================
+
+uint32_t tcProfiler::addName(std::string name, const char* category) {
+    names_.emplace_back(std::move(name), category);
+    return static_cast<uint32_t>(names_.size() - 1);
+}
+
+void tcProfiler::begin(asIScriptFunction* func) {
+    auto it = functionIds_.find(func);
+    uint32_t id;
+    if (it != functionIds_.end()) {
+        id = it->second;
+    } else {
+        bool isScript = func->GetFuncType() == asFUNC_SCRIPT;
+        std::string name = func->GetObjectName()
+            ? std::string(func->GetObjectName()) + "::" + func->GetName()
+            : std::string(func->GetName());
+        id = addName(std::move(name), isScript ? "script" : tcprof::categoryOf(func));
+        functionIds_.emplace(func, id);
+    }
+    push(id, 'B');
+}
+
+void tcProfiler::begin(const char* name, const char* category) {
+    auto it = spanIds_.find(name);
+    uint32_t id;
+    if (it != spanIds_.end()) {
+        id = it->second;
+    } else {
+        id = addName(name, category);
+        spanIds_.emplace(name, id);
+    }
+    push(id, 'B');
+}
+
+void tcProfiler::end() {
+    push(0, 'E');
+}
+
+void tcProfiler::endAll() {
+    while (openSpans_ > 0 || droppedSpans_ > 0) {
+        end();
+    }
+}
+
+void tcProfiler::push(uint32_t name, char phase) {
+    if (phase == 'B') {
+        // Keep room for the end events of everything still open
+        if (droppedSpans_ > 0 || events_.size() + openSpans_ + 1 >= kMaxEvents) {
+            droppedSpans_++;
+            truncated_ = true;
+            return;
+        }
+        openSpans_++;
+    } else {
+        if (droppedSpans_ > 0) {
+            droppedSpans_--;
+            return;
+        }
+        if (openSpans_ == 0) return;
+        openSpans_--;
+    }
+    int64_t ts = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start_).count();
+    events_.push_back({ts, name, phase});
+}
+
+// =============================================================================
+// Chrome Trace Event export
+// =============================================================================
+
+static void appendJsonString(std::string& out, const std::string& s) {
+    out += '"';
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+std::string tcProfiler::toChromeTrace() const {
+    std::string out;
+    out.reserve(events_.size() * 64 + 128);
+    out += "{\"traceEvents\":[";
+
+    char buf[64];
+    for (size_t i = 0; i < events_.size(); i++) {
+        const Event& e = events_[i];
+        if (i > 0) out += ',';
+        if (e.phase == 'B') {
+            const auto& [name, category] = names_[e.name];
+            out += "{\"name\":";
+            appendJsonString(out, name);
+            out += ",\"cat\":";
+            appendJsonString(out, category);
+            std::snprintf(buf, sizeof(buf), ",\"ph\":\"B\",\"ts\":%lld,\"pid\":1,\"tid\":1}", static_cast<long long>(e.ts));
+        } else {
+            std::snprintf(buf, sizeof(buf), "{\"ph\":\"E\",\"ts\":%lld,\"pid\":1,\"tid\":1}", static_cast<long long>(e.ts));
+        }
+        out += buf;
+    }
+
+    out += "],\"displayTimeUnit\":\"ms\"";
+    if (truncated_) {
+        std::snprintf(buf, sizeof(buf), ",\"otherData\":{\"truncated\":\"%zu events\"}", kMaxEvents);
+        out += buf;
+    }
+    out += '}';
+    return out;
+}
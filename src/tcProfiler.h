@@ -0,0 +1,101 @@
+#pragma once
+
+// =============================================================================
+// tcProfiler - script call profiler with Chrome trace export
+//
+// Records begin/end timestamps for script functions (tracked by tcScriptHost
+// from the line callback) and, in builds configured with TCSCRIPT_PROFILER,
+// for every registered C++ call. toChromeTrace() returns Trace Event JSON
+// that loads in chrome://tracing or https://ui.perfetto.dev.
+//
+// While disabled nothing is recorded and no callback is installed: script
+// functions are only tracked with profiling on, and the C++ call wrappers
+// only exist in TCSCRIPT_PROFILER builds.
+// =============================================================================
+
+#include <angelscript.h>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class tcProfiler {
+public:
+    // Function user data slot holding the category name (const char*)
+    static constexpr asPWORD kCategoryUserData = 0x7C50;
+
+    // Recording stops once this many events are stored
+    static constexpr size_t kMaxEvents = 200000;
+
+    // The profiler that is recording, or nullptr (checked by call wrappers)
+    static inline tcProfiler* active = nullptr;
+
+    ~tcProfiler();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return active == this; }
+
+    // Spans must nest: every begin is closed by end (or endAll)
+    void begin(asIScriptFunction* func);
+    void begin(const char* name, const char* category);
+    void end();
+
+    // Close every open span (call stack unwound or execution suspended)
+    void endAll();
+    size_t openSpans() const { return openSpans_; }
+
+    // Drop cached names (functions of a discarded module may be reused)
+    void forgetFunctions() { functionIds_.clear(); }
+
+    void clear();
+    size_t getEventCount() const { return events_.size(); }
+
+    std::string toChromeTrace() const;
+
+private:
+    struct Event {
+        int64_t ts;         // microseconds since enable
+        uint32_t name;      // index into names_ (begin events only)
+        char phase;         // 'B' or 'E'
+    };
+
+    void push(uint32_t name, char phase);
+    uint32_t addName(std::string name, const char* category);
+
+    std::vector<Event> events_;
+    std::vector<std::pair<std::string, const char*>> names_;   // name, category
+    std::unordered_map<asIScriptFunction*, uint32_t> functionIds_;
+    std::unordered_map<std::string, uint32_t> spanIds_;
+    std::chrono::steady_clock::time_point start_;
+    size_t openSpans_ = 0;
+    size_t droppedSpans_ = 0;   // open spans that did not fit (their end is dropped too)
+    bool truncated_ = false;
+};
+
+namespace tcprof {
+
+// Category of a registered function: the object type for methods, otherwise
+// the category tagged at registration ("graphics", "math", ...)
+inline const char* categoryOf(asIScriptFunction* func) {
+    if (const char* objectName = func->GetObjectName()) return objectName;
+    if (void* category = func->GetUserData(tcProfiler::kCategoryUserData)) return static_cast<const char*>(category);
+    return "native";
+}
+
+// Generic calling convention wrapper that times the wrapped call
+template<asGENFUNC_t F>
+struct ProfiledGeneric {
+    static void call(asIScriptGeneric* gen) {
+        tcProfiler* profiler = tcProfiler::active;
+        if (!profiler) {
+            F(gen);
+            return;
+        }
+        profiler->begin(gen->GetFunction());
+        F(gen);
+        profiler->end();
+    }
+};
+
+} // namespace tcprof
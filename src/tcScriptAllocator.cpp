@@ -0,0 +1,98 @@
+#include "tcScriptAllocator.h"
+#include <angelscript.h>
+#include <cstdint>
+#include <cstdlib>
+
+namespace {
+
+constexpr size_t kGranularity = 16;
+constexpr size_t kClassCount = tcScriptAllocator::kMaxPooledSize / kGranularity;
+constexpr uint32_t kLargeBlock = UINT32_MAX;
+
+// Precedes every block; 16 bytes keep the payload 16-byte aligned
+struct alignas(16) Header {
+    uint32_t sizeClass;     // index into freeLists, or kLargeBlock
+    size_t size;            // requested size
+};
+static_assert(sizeof(Header) == 16, "Header must keep payloads aligned");
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+FreeBlock* freeLists[kClassCount] = {};
+char* chunkCursor = nullptr;
+size_t chunkRemaining = 0;
+
+size_t classSize(uint32_t sizeClass) {
+    return (sizeClass + 1) * kGranularity;
+}
+
+void* asAlloc(size_t size) { return tcScriptAllocator::allocate(size); }
+void asFree(void* ptr) { tcScriptAllocator::deallocate(ptr); }
+
+} // namespace
+
+tcScriptAllocator::Stats tcScriptAllocator::stats_;
+size_t tcScriptAllocator::cap_ = 0;
+bool tcScriptAllocator::installed_ = false;
+
+void tcScriptAllocator::install() {
+    if (installed_) return;
+    asSetGlobalMemoryFunctions(asAlloc, asFree);
+    installed_ = true;
+}
+
+void* tcScriptAllocator::allocate(size_t size) {
+    Header* header;
+    if (size == 0 || size > kMaxPooledSize) {
+        stats_.systemAllocs++;
+        header = static_cast<Header*>(std::malloc(sizeof(Header) + size));
+        if (!header) return nullptr;
+        header->sizeClass = kLargeBlock;
+    } else {
+        uint32_t sizeClass = static_cast<uint32_t>((size - 1) / kGranularity);
+        if (FreeBlock* block = freeLists[sizeClass]) {
+            freeLists[sizeClass] = block->next;
+            header = reinterpret_cast<Header*>(block) - 1;
+        } else {
+            size_t blockSize = sizeof(Header) + classSize(sizeClass);
+            if (chunkRemaining < blockSize) {
+                // The tail of the old chunk is left unused
+                stats_.systemAllocs++;
+                chunkCursor = static_cast<char*>(std::malloc(kChunkSize));
+                if (!chunkCursor) {
+                    chunkRemaining = 0;
+                    return nullptr;
+                }
+                chunkRemaining = kChunkSize;
+                stats_.reservedBytes += kChunkSize;
+            }
+            header = reinterpret_cast<Header*>(chunkCursor);
+            chunkCursor += blockSize;
+            chunkRemaining -= blockSize;
+        }
+        header->sizeClass = sizeClass;
+    }
+    header->size = size;
+
+    stats_.allocs++;
+    stats_.bytesInUse += size;
+    if (stats_.bytesInUse > stats_.peakBytes) stats_.peakBytes = stats_.bytesInUse;
+    return header + 1;
+}
+
+void tcScriptAllocator::deallocate(void* ptr) {
+    if (!ptr) return;
+    Header* header = static_cast<Header*>(ptr) - 1;
+    stats_.frees++;
+    stats_.bytesInUse -= header->size;
+
+    if (header->sizeClass == kLargeBlock) {
+        std::free(header);
+        return;
+    }
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->next = freeLists[header->sizeClass];
+    freeLists[header->sizeClass] = block;
+}
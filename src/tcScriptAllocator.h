@@ -0,0 +1,57 @@
+#pragma once
+
+// =============================================================================
+// tcScriptAllocator - pooled memory for the AngelScript engine
+//
+// Installed with asSetGlobalMemoryFunctions before the first engine is
+// created, so the engine, compiled modules, script objects and CScriptArray
+// storage all come from here. Requests up to kMaxPooledSize bytes are served
+// from per-size-class free lists. The blocks are carved sequentially out of
+// 64 KB chunks that are never handed back, so temporaries created and
+// dropped within a frame reuse the same memory. Reloads reuse the memory of
+// the discarded module instead of fragmenting the system heap. Larger
+// requests go straight to malloc.
+//
+// An optional memory cap limits the bytes in use. Going over it never fails
+// an allocation (the engine does not expect that). tcScriptHost checks
+// isOverCap() and stops the script instead.
+//
+// Script thread only, like the rest of the engine.
+// =============================================================================
+
+#include <cstddef>
+
+class tcScriptAllocator {
+public:
+    static constexpr size_t kMaxPooledSize = 512;
+    static constexpr size_t kChunkSize = 64 * 1024;
+
+    struct Stats {
+        size_t allocs = 0;          // allocation requests
+        size_t frees = 0;
+        size_t systemAllocs = 0;    // requests that reached malloc (chunks and large blocks)
+        size_t bytesInUse = 0;      // requested bytes currently allocated
+        size_t peakBytes = 0;
+        size_t reservedBytes = 0;   // chunk memory held by the pools
+    };
+
+    // Route AngelScript's allocations through the pools. Must run before the
+    // first engine is created; later calls do nothing.
+    static void install();
+    static bool isInstalled() { return installed_; }
+
+    static void* allocate(size_t size);
+    static void deallocate(void* ptr);
+
+    static const Stats& getStats() { return stats_; }
+
+    // 0 = no cap
+    static void setMemoryCap(size_t bytes) { cap_ = bytes; }
+    static size_t getMemoryCap() { return cap_; }
+    static bool isOverCap() { return cap_ > 0 && stats_.bytesInUse > cap_; }
+
+private:
+    static Stats stats_;
+    static size_t cap_;
+    static bool installed_;
+};
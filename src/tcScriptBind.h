@@ -0,0 +1,258 @@
+#pragma once
+
+// =============================================================================
+// tcScriptBind - compile-time AngelScript binding helpers
+//
+// Bind a typed C++ function once and let the compiler pick the calling
+// convention:
+//
+//   tcbind::Binder bind(engine);
+//   bind.function<as_drawCircle_3f>("void drawCircle(float, float, float)");
+//   bind.method<Vec2_OpAdd>("Vec2", "Vec2 opAdd(const Vec2 &in) const");
+//
+// When the AngelScript library supports native calls the function is
+// registered directly (asCALL_CDECL / asCALL_CDECL_OBJFIRST / asCALL_THISCALL).
+// On AS_MAX_PORTABILITY builds (Emscripten) an asCALL_GENERIC thunk is
+// generated from the C++ signature instead, so there is only one wrapper to
+// write per binding either way.
+//
+// Define TCSCRIPT_FORCE_GENERIC to always use the generated generic thunks
+// (useful for comparing call overhead on desktop). TCSCRIPT_PROFILER also
+// forces them and wraps each one so tcProfiler can time the call, and so does
+// TCSCRIPT_HEADLESS (the benchmark runner's null graphics backend).
+// =============================================================================
+
+#include <angelscript.h>
+#include <cstring>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifdef TCSCRIPT_PROFILER
+#include "tcProfiler.h"
+#endif
+#ifdef TCSCRIPT_HEADLESS
+#include "tcHeadless.h"
+#endif
+
+namespace tcbind {
+
+// True if the linked AngelScript library can call native functions directly
+inline bool nativeCallsSupported() {
+#if defined(TCSCRIPT_FORCE_GENERIC) || defined(TCSCRIPT_PROFILER) || defined(TCSCRIPT_HEADLESS)
+    return false;
+#else
+    static const bool supported = std::strstr(asGetLibraryOptions(), "AS_MAX_PORTABILITY") == nullptr;
+    return supported;
+#endif
+}
+
+namespace detail {
+
+// -----------------------------------------------------------------------------
+// Argument extraction
+// -----------------------------------------------------------------------------
+template<typename T>
+inline T getArg(asIScriptGeneric* gen, asUINT i) {
+    using U = std::remove_reference_t<T>;
+    using B = std::remove_cv_t<U>;
+
+    if constexpr (std::is_reference_v<T>) {
+        // &in / &out / &inout: objects arrive as object pointers, primitives as addresses
+        if constexpr (std::is_class_v<B>) {
+            return *static_cast<U*>(gen->GetArgObject(i));
+        } else {
+            return *static_cast<U*>(gen->GetArgAddress(i));
+        }
+    } else if constexpr (std::is_same_v<B, bool>) {
+        return gen->GetArgByte(i) != 0;
+    } else if constexpr (std::is_enum_v<B>) {
+        return static_cast<B>(gen->GetArgDWord(i));
+    } else if constexpr (std::is_same_v<B, float>) {
+        return gen->GetArgFloat(i);
+    } else if constexpr (std::is_same_v<B, double>) {
+        return gen->GetArgDouble(i);
+    } else if constexpr (std::is_integral_v<B>) {
+        if constexpr (sizeof(B) == 1) return static_cast<B>(gen->GetArgByte(i));
+        else if constexpr (sizeof(B) == 2) return static_cast<B>(gen->GetArgWord(i));
+        else if constexpr (sizeof(B) == 4) return static_cast<B>(gen->GetArgDWord(i));
+        else return static_cast<B>(gen->GetArgQWord(i));
+    } else if constexpr (std::is_class_v<B>) {
+        // Value type passed by value
+        return *static_cast<B*>(gen->GetArgObject(i));
+    } else {
+        // Handles need explicit reference counting; keep those hand-written
+        static_assert(!std::is_pointer_v<B>, "tcbind: pointer/handle arguments are not supported");
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Return value
+// -----------------------------------------------------------------------------
+template<typename R, typename Fn>
+inline void callAndReturn(asIScriptGeneric* gen, Fn&& fn) {
+    using B = std::remove_cv_t<R>;
+
+    if constexpr (std::is_void_v<R>) {
+        fn();
+    } else if constexpr (std::is_reference_v<R>) {
+        R ref = fn();
+        gen->SetReturnAddress(const_cast<void*>(static_cast<const void*>(&ref)));
+    } else if constexpr (std::is_same_v<B, bool>) {
+        gen->SetReturnByte(fn() ? 1 : 0);
+    } else if constexpr (std::is_enum_v<B>) {
+        gen->SetReturnDWord(static_cast<asDWORD>(fn()));
+    } else if constexpr (std::is_same_v<B, float>) {
+        gen->SetReturnFloat(fn());
+    } else if constexpr (std::is_same_v<B, double>) {
+        gen->SetReturnDouble(fn());
+    } else if constexpr (std::is_integral_v<B>) {
+        if constexpr (sizeof(B) == 1) gen->SetReturnByte(static_cast<asBYTE>(fn()));
+        else if constexpr (sizeof(B) == 2) gen->SetReturnWord(static_cast<asWORD>(fn()));
+        else if constexpr (sizeof(B) == 4) gen->SetReturnDWord(static_cast<asDWORD>(fn()));
+        else gen->SetReturnQWord(static_cast<asQWORD>(fn()));
+    } else {
+        static_assert(!std::is_pointer_v<B>, "tcbind: pointer/handle returns are not supported");
+        // Value type returned by value
+        new (gen->GetAddressOfReturnLocation()) B(fn());
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Generic thunks
+// -----------------------------------------------------------------------------
+
+// Free function: R f(A...)
+template<typename Sig, Sig F> struct FunctionThunk;
+
+template<typename R, typename... A, R (*F)(A...)>
+struct FunctionThunk<R (*)(A...), F> {
+    static void call(asIScriptGeneric* gen) {
+        invoke(gen, std::index_sequence_for<A...>{});
+    }
+    template<size_t... I>
+    static void invoke(asIScriptGeneric* gen, std::index_sequence<I...>) {
+        callAndReturn<R>(gen, [gen]() -> R { return F(getArg<A>(gen, I)...); });
+    }
+};
+
+// Free function taking the object first: R f(T* self, A...)
+template<typename Sig, Sig F> struct ObjFirstThunk;
+
+template<typename R, typename T, typename... A, R (*F)(T*, A...)>
+struct ObjFirstThunk<R (*)(T*, A...), F> {
+    static void call(asIScriptGeneric* gen) {
+        invoke(gen, std::index_sequence_for<A...>{});
+    }
+    template<size_t... I>
+    static void invoke(asIScriptGeneric* gen, std::index_sequence<I...>) {
+        T* self = static_cast<T*>(gen->GetObject());
+        callAndReturn<R>(gen, [gen, self]() -> R { return F(self, getArg<A>(gen, I)...); });
+    }
+};
+
+// Member function: R C::m(A...) [const]
+template<typename Sig, Sig M> struct MethodThunk;
+
+template<typename R, typename C, typename... A, R (C::*M)(A...)>
+struct MethodThunk<R (C::*)(A...), M> {
+    static void call(asIScriptGeneric* gen) {
+        invoke(gen, std::index_sequence_for<A...>{});
+    }
+    template<size_t... I>
+    static void invoke(asIScriptGeneric* gen, std::index_sequence<I...>) {
+        C* self = static_cast<C*>(gen->GetObject());
+        callAndReturn<R>(gen, [gen, self]() -> R { return (self->*M)(getArg<A>(gen, I)...); });
+    }
+};
+
+template<typename R, typename C, typename... A, R (C::*M)(A...) const>
+struct MethodThunk<R (C::*)(A...) const, M> {
+    static void call(asIScriptGeneric* gen) {
+        invoke(gen, std::index_sequence_for<A...>{});
+    }
+    template<size_t... I>
+    static void invoke(asIScriptGeneric* gen, std::index_sequence<I...>) {
+        const C* self = static_cast<const C*>(gen->GetObject());
+        callAndReturn<R>(gen, [gen, self]() -> R { return (self->*M)(getArg<A>(gen, I)...); });
+    }
+};
+
+} // namespace detail
+
+// Entry point for an asCALL_GENERIC function: timed in profiler builds,
+// skippable in headless builds (see tcHeadless.h)
+template<asGENFUNC_t G>
+inline asSFuncPtr generic() {
+#if defined(TCSCRIPT_HEADLESS) && defined(TCSCRIPT_PROFILER)
+    return asFUNCTION(tcprof::ProfiledGeneric<tcheadless::NullableGeneric<G>::call>::call);
+#elif defined(TCSCRIPT_HEADLESS)
+    return asFUNCTION(tcheadless::NullableGeneric<G>::call);
+#elif defined(TCSCRIPT_PROFILER)
+    return asFUNCTION(tcprof::ProfiledGeneric<G>::call);
+#else
+    return asFUNCTION(G);
+#endif
+}
+
+// =============================================================================
+// Binder - registers typed functions with the best available convention
+// =============================================================================
+class Binder {
+public:
+    explicit Binder(asIScriptEngine* engine)
+        : engine_(engine), native_(nativeCallsSupported()) {}
+
+    bool usesNativeCalls() const { return native_; }
+
+    // Global function
+    template<auto F>
+    int function(const char* decl) {
+        if (native_) {
+            return engine_->RegisterGlobalFunction(decl, asFUNCTION(F), asCALL_CDECL);
+        }
+        return engine_->RegisterGlobalFunction(decl,
+            generic<detail::FunctionThunk<decltype(F), F>::call>(), asCALL_GENERIC);
+    }
+
+    // Object method: either a free function taking the object first, or a
+    // member function pointer
+    template<auto F>
+    int method(const char* obj, const char* decl) {
+        if constexpr (std::is_member_function_pointer_v<decltype(F)>) {
+            if (native_) {
+                return engine_->RegisterObjectMethod(obj, decl, methodPtr(F), asCALL_THISCALL);
+            }
+            return engine_->RegisterObjectMethod(obj, decl,
+                generic<detail::MethodThunk<decltype(F), F>::call>(), asCALL_GENERIC);
+        } else {
+            if (native_) {
+                return engine_->RegisterObjectMethod(obj, decl, asFUNCTION(F), asCALL_CDECL_OBJFIRST);
+            }
+            return engine_->RegisterObjectMethod(obj, decl,
+                generic<detail::ObjFirstThunk<decltype(F), F>::call>(), asCALL_GENERIC);
+        }
+    }
+
+    // Object behaviour (constructors etc.): free function taking the object first
+    template<auto F>
+    int behaviour(const char* obj, asEBehaviours behaviour, const char* decl) {
+        if (native_) {
+            return engine_->RegisterObjectBehaviour(obj, behaviour, decl, asFUNCTION(F), asCALL_CDECL_OBJFIRST);
+        }
+        return engine_->RegisterObjectBehaviour(obj, behaviour, decl,
+            generic<detail::ObjFirstThunk<decltype(F), F>::call>(), asCALL_GENERIC);
+    }
+
+private:
+    template<typename C, typename R, typename... A>
+    static asSFuncPtr methodPtr(R (C::*m)(A...)) { return asSMethodPtr<sizeof(void (C::*)())>::Convert(m); }
+    template<typename C, typename R, typename... A>
+    static asSFuncPtr methodPtr(R (C::*m)(A...) const) { return asSMethodPtr<sizeof(void (C::*)())>::Convert(m); }
+
+    asIScriptEngine* engine_;
+    bool native_;
+};
+
+} // namespace tcbind
@@ -1,37 +1,124 @@
 #include "tcScriptHost.h"
+#include "tcScriptBind.h"
+#include "tcScriptRef.h"
+#include "tcScriptAllocator.h"
+#include "tcAssetCache.h"
+#include "tcAudioOutput.h"
+#include "tcChipSynth.h"
+#include "tcDirtyRegion.h"
+#include "tcDisplayList.h"
+#include "tcFloatBuffer.h"
+#include "tcParticleSystem.h"
+#include "tcPixelKernels.h"
+#include "tcSequencer.h"
 #include <scriptstdstring/scriptstdstring.h>
 #include <scriptarray/scriptarray.h>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
 #include <vector>
 #include <memory>
+#include <type_traits>
+#include <unordered_map>
 
-// Global containers for reference types (cleaned up on script reload)
-static vector<unique_ptr<Texture>> g_textures;
-static vector<unique_ptr<Fbo>> g_fbos;
-static vector<unique_ptr<Pixels>> g_pixels;
-static vector<unique_ptr<Sound>> g_sounds;
-static vector<unique_ptr<Font>> g_fonts;
-static vector<unique_ptr<Tween<float>>> g_tweens;
-static vector<unique_ptr<ChipSoundBundle>> g_chipBundles;
-static vector<unique_ptr<Mesh>> g_meshes;
-static vector<unique_ptr<Path>> g_paths;
-static vector<unique_ptr<StrokeMesh>> g_strokeMeshes;
-static vector<unique_ptr<Image>> g_images;
-static vector<unique_ptr<EasyCam>> g_easyCams;
+using tcscript::ScriptObject;
+using tcscript::BorrowedRefs;
+using tcscript::FramePool;
 
+// Sounds that are playing hold an extra reference so a fire-and-forget
+// createSound().play() is not cut off when the script drops the handle
+static vector<Sound*> g_playingSounds;
+
+static void keepPlayingSound(Sound* sound) {
+    for (Sound* s : g_playingSounds) {
+        if (s == sound) return;
+    }
+    ScriptObject<Sound>::addRef(sound);
+    g_playingSounds.push_back(sound);
+}
+
+// Sounds play() was called on while they were still loading or being
+// synthesized; they start as soon as they are ready
+static vector<Sound*> g_playWhenReady;
+
+static void playWhenReady(Sound* sound) {
+    if (std::find(g_playWhenReady.begin(), g_playWhenReady.end(), sound) == g_playWhenReady.end()) {
+        g_playWhenReady.push_back(sound);
+    }
+}
+static bool cancelPlayWhenReady(Sound* sound) {
+    auto it = std::find(g_playWhenReady.begin(), g_playWhenReady.end(), sound);
+    if (it == g_playWhenReady.end()) return false;
+    g_playWhenReady.erase(it);
+    return true;
+}
+// Called when a background load of 'sound' has finished
+static void soundReady(Sound* sound) {
+    if (!cancelPlayWhenReady(sound)) return;
+    sound->play();
+    keepPlayingSound(sound);
+}
+
+// Release sounds that finished playing (called once per frame)
+static void releaseFinishedSounds() {
+    for (size_t i = 0; i < g_playingSounds.size();) {
+        Sound* sound = g_playingSounds[i];
+        if (sound->isPlaying() || sound->isPaused()) {
+            i++;
+            continue;
+        }
+        g_playingSounds[i] = g_playingSounds.back();
+        g_playingSounds.pop_back();
+        ScriptObject<Sound>::release(sound);
+    }
+}
+
+// Temporary meshes and paths (createTempMesh / createTempPath) go back to
+// their pools after each frame, keeping their vertex capacity
+static void resetFramePools() {
+    FramePool<Mesh>::reset([](Mesh& mesh) {
+        mesh.clear();
+        mesh.setMode(PrimitiveMode::Triangles);
+    });
+    FramePool<Path>::reset([](Path& path) {
+        path.clear();
+        path.setClosed(false);
+    });
+}
+
+// Particle systems given a script hook. ParticleSystem is GC-tracked, so
+// object -> system -> delegate -> object cycles are collected, except when a
+// borrowed column handle holds the system: the collector can't see that
+// edge. Hooks are dropped when the script is replaced, which breaks those.
+// A system leaves the list when it is destroyed (see the destroy hook).
+static vector<tcParticleSystem*> g_hookedParticles;
+
+static void dropParticleHooks() {
+    vector<tcParticleSystem*> systems;
+    systems.swap(g_hookedParticles);
+    // Releasing a delegate can release the system itself - keep it alive
+    for (tcParticleSystem* system : systems) ScriptObject<tcParticleSystem>::addRef(system);
+    for (tcParticleSystem* system : systems) {
+        system->setEmitHook(nullptr);
+        system->setUpdateHook(nullptr);
+    }
+    for (tcParticleSystem* system : systems) tcscript::scriptRelease(system);
+}
+
+// Stop and release everything the previous script left playing
 static void clearScriptResources() {
-    g_textures.clear();
-    g_fbos.clear();
-    g_pixels.clear();
-    g_sounds.clear();
-    g_fonts.clear();
-    g_tweens.clear();
-    g_chipBundles.clear();
-    g_meshes.clear();
-    g_paths.clear();
-    g_strokeMeshes.clear();
-    g_images.clear();
-    g_easyCams.clear();
+    for (Sound* sound : g_playingSounds) {
+        sound->stop();
+        ScriptObject<Sound>::release(sound);
+    }
+    g_playingSounds.clear();
+    g_playWhenReady.clear();
+    dropParticleHooks();
+    FramePool<Mesh>::clear();
+    FramePool<Path>::clear();
+    tcDisplayList::recording = nullptr;
 }
 
 // Font path constants for script access
@@ -39,6 +126,18 @@ static const string fontSans = TC_FONT_SANS;
 static const string fontSerif = TC_FONT_SERIF;
 static const string fontMono = TC_FONT_MONO;
 
+// Line callback for the execution watchdog
+static void lineCallbackStatic(asIScriptContext* ctx, void* param) {
+    static_cast<tcScriptHost*>(param)->checkExecutionBudget(ctx);
+}
+
+// Line callback while profiling (tracks script function entry/exit too)
+static void profileLineCallbackStatic(asIScriptContext* ctx, void* param) {
+    tcScriptHost* host = static_cast<tcScriptHost*>(param);
+    host->profileLine(ctx);
+    host->checkExecutionBudget(ctx);
+}
+
 // Message callback for AngelScript errors
 static void messageCallbackStatic(const asSMessageInfo* msg, void* param) {
     tcScriptHost* host = static_cast<tcScriptHost*>(param);
@@ -54,158 +153,477 @@ static void messageCallbackStatic(const asSMessageInfo* msg, void* param) {
     }
 }
 
+// Hand-written asCALL_GENERIC wrappers (timed in TCSCRIPT_PROFILER builds,
+// skippable in TCSCRIPT_HEADLESS builds)
+#define AS_GENERIC(func) tcbind::generic<func>(), asCALL_GENERIC
+
 // =============================================================================
-// Helper macros for generic calling convention
+// Helper macros for typed wrappers
+// (registered through tcbind::Binder - native calls where available,
+//  generated asCALL_GENERIC thunks otherwise)
 // =============================================================================
 
 #define AS_VOID_0(func) \
-    static void as_##func(asIScriptGeneric* gen) { func(); }
+    static void as_##func() { func(); }
 
 #define AS_VOID_1F(func) \
-    static void as_##func##_1f(asIScriptGeneric* gen) { func(gen->GetArgFloat(0)); }
+    static void as_##func##_1f(float a) { func(a); }
 
 #define AS_VOID_2F(func) \
-    static void as_##func##_2f(asIScriptGeneric* gen) { func(gen->GetArgFloat(0), gen->GetArgFloat(1)); }
+    static void as_##func##_2f(float a, float b) { func(a, b); }
 
 #define AS_VOID_3F(func) \
-    static void as_##func##_3f(asIScriptGeneric* gen) { func(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2)); }
+    static void as_##func##_3f(float a, float b, float c) { func(a, b, c); }
 
 #define AS_VOID_4F(func) \
-    static void as_##func##_4f(asIScriptGeneric* gen) { func(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2), gen->GetArgFloat(3)); }
+    static void as_##func##_4f(float a, float b, float c, float d) { func(a, b, c, d); }
 
 #define AS_VOID_5F(func) \
-    static void as_##func##_5f(asIScriptGeneric* gen) { func(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2), gen->GetArgFloat(3), gen->GetArgFloat(4)); }
+    static void as_##func##_5f(float a, float b, float c, float d, float e) { func(a, b, c, d, e); }
 
 #define AS_VOID_6F(func) \
-    static void as_##func##_6f(asIScriptGeneric* gen) { func(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2), gen->GetArgFloat(3), gen->GetArgFloat(4), gen->GetArgFloat(5)); }
+    static void as_##func##_6f(float a, float b, float c, float d, float e, float f) { func(a, b, c, d, e, f); }
 
 #define AS_FLOAT_0(func) \
-    static void as_##func(asIScriptGeneric* gen) { gen->SetReturnFloat(func()); }
+    static float as_##func() { return func(); }
 
 #define AS_FLOAT_1F(func) \
-    static void as_##func##_1f(asIScriptGeneric* gen) { gen->SetReturnFloat(func(gen->GetArgFloat(0))); }
+    static float as_##func##_1f(float a) { return func(a); }
 
 #define AS_FLOAT_2F(func) \
-    static void as_##func##_2f(asIScriptGeneric* gen) { gen->SetReturnFloat(func(gen->GetArgFloat(0), gen->GetArgFloat(1))); }
+    static float as_##func##_2f(float a, float b) { return func(a, b); }
 
 #define AS_INT_0(func) \
-    static void as_##func(asIScriptGeneric* gen) { gen->SetReturnDWord(func()); }
+    static int as_##func() { return func(); }
 
 #define AS_VOID_1I(func) \
-    static void as_##func##_1i(asIScriptGeneric* gen) { func(gen->GetArgDWord(0)); }
+    static void as_##func##_1i(int a) { func(a); }
 
 #define AS_BOOL_0(func) \
-    static void as_##func(asIScriptGeneric* gen) { gen->SetReturnByte(func() ? 1 : 0); }
+    static bool as_##func() { return func(); }
+
+// Immediate-mode calls that go into the recording DisplayList, if any,
+// instead of drawing (op: the tcDisplayList::Op used when baking)
+#define AS_RECORD_0(func, op) \
+    static void as_##func() { \
+        if (tcDisplayList::recording) { \
+            tcDisplayList::recording->record(tcDisplayList::Op::op, \
+                [](const float*, const string*) { func(); }); \
+            return; \
+        } \
+        func(); \
+    }
+
+#define AS_RECORD_1F(func, op) \
+    static void as_##func##_1f(float a) { \
+        if (tcDisplayList::recording) { \
+            tcDisplayList::recording->record(tcDisplayList::Op::op, \
+                [](const float* v, const string*) { func(v[0]); }, {a}); \
+            return; \
+        } \
+        func(a); \
+    }
+
+#define AS_RECORD_2F(func, op) \
+    static void as_##func##_2f(float a, float b) { \
+        if (tcDisplayList::recording) { \
+            tcDisplayList::recording->record(tcDisplayList::Op::op, \
+                [](const float* v, const string*) { func(v[0], v[1]); }, {a, b}); \
+            return; \
+        } \
+        func(a, b); \
+    }
+
+#define AS_RECORD_3F(func, op) \
+    static void as_##func##_3f(float a, float b, float c) { \
+        if (tcDisplayList::recording) { \
+            tcDisplayList::recording->record(tcDisplayList::Op::op, \
+                [](const float* v, const string*) { func(v[0], v[1], v[2]); }, {a, b, c}); \
+            return; \
+        } \
+        func(a, b, c); \
+    }
+
+#define AS_RECORD_4F(func, op) \
+    static void as_##func##_4f(float a, float b, float c, float d) { \
+        if (tcDisplayList::recording) { \
+            tcDisplayList::recording->record(tcDisplayList::Op::op, \
+                [](const float* v, const string*) { func(v[0], v[1], v[2], v[3]); }, {a, b, c, d}); \
+            return; \
+        } \
+        func(a, b, c, d); \
+    }
+
+#define AS_RECORD_5F(func, op) \
+    static void as_##func##_5f(float a, float b, float c, float d, float e) { \
+        if (tcDisplayList::recording) { \
+            tcDisplayList::recording->record(tcDisplayList::Op::op, \
+                [](const float* v, const string*) { func(v[0], v[1], v[2], v[3], v[4]); }, {a, b, c, d, e}); \
+            return; \
+        } \
+        func(a, b, c, d, e); \
+    }
+
+#define AS_RECORD_6F(func, op) \
+    static void as_##func##_6f(float a, float b, float c, float d, float e, float f) { \
+        if (tcDisplayList::recording) { \
+            tcDisplayList::recording->record(tcDisplayList::Op::op, \
+                [](const float* v, const string*) { func(v[0], v[1], v[2], v[3], v[4], v[5]); }, {a, b, c, d, e, f}); \
+            return; \
+        } \
+        func(a, b, c, d, e, f); \
+    }
+
+#define AS_RECORD_1I(func, op) \
+    static void as_##func##_1i(int a) { \
+        if (tcDisplayList::recording) { \
+            tcDisplayList::recording->record(tcDisplayList::Op::op, \
+                [](const float* v, const string*) { func(static_cast<int>(v[0])); }, {static_cast<float>(a)}); \
+            return; \
+        } \
+        func(a); \
+    }
 
 // =============================================================================
 // Graphics - Clear & Color
 // =============================================================================
-AS_VOID_1F(clear)
-AS_VOID_3F(clear)
-AS_VOID_1F(setColor)
-AS_VOID_3F(setColor)
-AS_VOID_4F(setColor)
-AS_VOID_3F(setColorHSB)
-AS_VOID_3F(setColorOKLCH)
-AS_VOID_3F(setColorOKLab)
+AS_RECORD_1F(clear, Other)
+AS_RECORD_3F(clear, Other)
+AS_RECORD_1F(setColor, SetColor1)
+AS_RECORD_3F(setColor, SetColor3)
+AS_RECORD_4F(setColor, SetColor4)
+AS_RECORD_3F(setColorHSB, Other)
+AS_RECORD_3F(setColorOKLCH, Other)
+AS_RECORD_3F(setColorOKLab, Other)
 
 // =============================================================================
 // Graphics - Shapes
 // =============================================================================
-AS_VOID_4F(drawRect)
-AS_VOID_3F(drawCircle)
-AS_VOID_2F(drawPoint)
-AS_VOID_4F(drawEllipse)
-AS_VOID_4F(drawLine)
-AS_VOID_6F(drawTriangle)
-AS_VOID_4F(drawStroke)
+AS_RECORD_4F(drawRect, Rect)
+AS_RECORD_3F(drawCircle, Circle)
+AS_RECORD_2F(drawPoint, Other)
+AS_RECORD_4F(drawEllipse, Other)
+AS_RECORD_4F(drawLine, Line)
+AS_RECORD_6F(drawTriangle, Triangle)
+AS_RECORD_4F(drawStroke, Other)
 
 // 3D shapes
-static void as_drawBox_1f(asIScriptGeneric* gen) { drawBox(gen->GetArgFloat(0)); }
-static void as_drawBox_3f(asIScriptGeneric* gen) { drawBox(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2)); }
-static void as_drawBox_4f(asIScriptGeneric* gen) { drawBox(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2), gen->GetArgFloat(3)); }
-static void as_drawBox_6f(asIScriptGeneric* gen) { drawBox(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2), gen->GetArgFloat(3), gen->GetArgFloat(4), gen->GetArgFloat(5)); }
+AS_RECORD_1F(drawBox, Other)
+AS_RECORD_3F(drawBox, Other)
+AS_RECORD_4F(drawBox, Other)
+AS_RECORD_6F(drawBox, Other)
 
-static void as_drawSphere_1f(asIScriptGeneric* gen) { drawSphere(gen->GetArgFloat(0)); }
-static void as_drawSphere_4f(asIScriptGeneric* gen) { drawSphere(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2), gen->GetArgFloat(3)); }
+AS_RECORD_1F(drawSphere, Other)
+AS_RECORD_4F(drawSphere, Other)
 
-static void as_drawCone_2f(asIScriptGeneric* gen) { drawCone(gen->GetArgFloat(0), gen->GetArgFloat(1)); }
-static void as_drawCone_5f(asIScriptGeneric* gen) { drawCone(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2), gen->GetArgFloat(3), gen->GetArgFloat(4)); }
+AS_RECORD_2F(drawCone, Other)
+AS_RECORD_5F(drawCone, Other)
 
 // Text
-static void as_drawBitmapString(asIScriptGeneric* gen) {
-    string* text = static_cast<string*>(gen->GetArgObject(0));
-    drawBitmapString(*text, gen->GetArgFloat(1), gen->GetArgFloat(2));
+static void as_drawBitmapString(const string& text, float x, float y) {
+    if (tcDisplayList::recording) {
+        tcDisplayList::recording->recordText([](const float* v, const string* t) {
+            drawBitmapString(*t, v[0], v[1]);
+        }, text, x, y);
+        return;
+    }
+    drawBitmapString(text, x, y);
 }
 
 // =============================================================================
 // Graphics - Style
 // =============================================================================
-AS_VOID_0(fill)
-AS_VOID_0(noFill)
-AS_VOID_1F(setStrokeWeight)
+AS_RECORD_0(fill, Fill)
+AS_RECORD_0(noFill, NoFill)
+AS_RECORD_1F(setStrokeWeight, StrokeWeight)
 AS_FLOAT_0(getStrokeWeight)
 
-static void as_setStrokeCap(asIScriptGeneric* gen) {
-    setStrokeCap(static_cast<StrokeCap>(gen->GetArgDWord(0)));
+static void as_setStrokeCap(int cap) {
+    if (tcDisplayList::recording) {
+        tcDisplayList::recording->record(tcDisplayList::Op::Other, [](const float* v, const string*) {
+            setStrokeCap(static_cast<StrokeCap>(static_cast<int>(v[0])));
+        }, {static_cast<float>(cap)});
+        return;
+    }
+    setStrokeCap(static_cast<StrokeCap>(cap));
 }
-static void as_getStrokeCap(asIScriptGeneric* gen) {
-    gen->SetReturnDWord(static_cast<int>(getStrokeCap()));
+static int as_getStrokeCap() {
+    return static_cast<int>(getStrokeCap());
 }
-static void as_setStrokeJoin(asIScriptGeneric* gen) {
-    setStrokeJoin(static_cast<StrokeJoin>(gen->GetArgDWord(0)));
+static void as_setStrokeJoin(int join) {
+    if (tcDisplayList::recording) {
+        tcDisplayList::recording->record(tcDisplayList::Op::Other, [](const float* v, const string*) {
+            setStrokeJoin(static_cast<StrokeJoin>(static_cast<int>(v[0])));
+        }, {static_cast<float>(join)});
+        return;
+    }
+    setStrokeJoin(static_cast<StrokeJoin>(join));
 }
-static void as_getStrokeJoin(asIScriptGeneric* gen) {
-    gen->SetReturnDWord(static_cast<int>(getStrokeJoin()));
+static int as_getStrokeJoin() {
+    return static_cast<int>(getStrokeJoin());
 }
 
-AS_VOID_1I(setCircleResolution)
+AS_RECORD_1I(setCircleResolution, CircleResolution)
 AS_INT_0(getCircleResolution)
 AS_BOOL_0(isFillEnabled)
 AS_BOOL_0(isStrokeEnabled)
-AS_VOID_0(pushStyle)
-AS_VOID_0(popStyle)
+AS_RECORD_0(pushStyle, PushStyle)
+AS_RECORD_0(popStyle, PopStyle)
 
-static void as_getColor(asIScriptGeneric* gen) {
-    Color c = getColor();
-    gen->SetReturnObject(&c);
+static Color as_getColor() {
+    return getColor();
 }
 
 // =============================================================================
 // Shape & Stroke construction
 // =============================================================================
-AS_VOID_0(beginShape)
-AS_VOID_0(endShape)
-static void as_endShape_bool(asIScriptGeneric* gen) { endShape(gen->GetArgByte(0) != 0); }
-AS_VOID_2F(vertex)
-AS_VOID_3F(vertex)
-AS_VOID_0(beginStroke)
-AS_VOID_0(endStroke)
-static void as_endStroke_bool(asIScriptGeneric* gen) { endStroke(gen->GetArgByte(0) != 0); }
+AS_RECORD_0(beginShape, Other)
+AS_RECORD_0(endShape, Other)
+static void as_endShape_bool(bool close) {
+    if (tcDisplayList::recording) {
+        tcDisplayList::recording->record(tcDisplayList::Op::Other, [](const float* v, const string*) {
+            endShape(v[0] != 0.0f);
+        }, {close ? 1.0f : 0.0f});
+        return;
+    }
+    endShape(close);
+}
+AS_RECORD_2F(vertex, Other)
+AS_RECORD_3F(vertex, Other)
+AS_RECORD_0(beginStroke, Other)
+AS_RECORD_0(endStroke, Other)
+static void as_endStroke_bool(bool close) {
+    if (tcDisplayList::recording) {
+        tcDisplayList::recording->record(tcDisplayList::Op::Other, [](const float* v, const string*) {
+            endStroke(v[0] != 0.0f);
+        }, {close ? 1.0f : 0.0f});
+        return;
+    }
+    endStroke(close);
+}
 
 // =============================================================================
 // Transform
 // =============================================================================
-AS_VOID_0(pushMatrix)
-AS_VOID_0(popMatrix)
-AS_VOID_2F(translate)
-AS_VOID_3F(translate)
-AS_VOID_1F(rotate)
-AS_VOID_3F(rotate)
+AS_RECORD_0(pushMatrix, PushMatrix)
+AS_RECORD_0(popMatrix, PopMatrix)
+AS_RECORD_2F(translate, Translate2)
+AS_RECORD_3F(translate, Translate3)
+AS_RECORD_1F(rotate, Rotate)
+AS_RECORD_3F(rotate, Other)
+AS_RECORD_1F(rotateDeg, RotateDeg)
+AS_RECORD_3F(rotateDeg, Other)
+AS_RECORD_1F(rotateX, Other)
+AS_RECORD_1F(rotateY, Other)
+AS_RECORD_1F(rotateZ, RotateZ)
+AS_RECORD_1F(rotateXDeg, Other)
+AS_RECORD_1F(rotateYDeg, Other)
+AS_RECORD_1F(rotateZDeg, RotateZDeg)
+AS_RECORD_0(resetMatrix, ResetMatrix)
+
+static void as_scale_1f(float s) {
+    if (tcDisplayList::recording) {
+        tcDisplayList::recording->record(tcDisplayList::Op::Scale1, [](const float* v, const string*) {
+            scale(v[0], v[0]);
+        }, {s});
+        return;
+    }
+    scale(s, s);
+}
+AS_RECORD_2F(scale, Scale2)
+
+// =============================================================================
+// Graphics - Batched shapes
+// =============================================================================
+// drawCircles / drawRects / drawLines / drawPoints read the packed script
+// array or FloatBuffer in place and draw all items with one mesh. Outlines
+// (noFill), thick lines and DisplayList recording fall back to one
+// immediate call per item, which still saves the script-to-native call for
+// each of them.
+
+// Packed floats of the first argument: an array (floatsPerElement floats
+// per element, e.g. 2 for array<Vec2>) or a FloatBuffer
+template<bool Buffer>
+static const float* batchFloats(asIScriptGeneric* gen, size_t floatsPerElement, size_t& size) {
+    void* arg = gen->GetArgObject(0);
+    size = 0;
+    if (!arg) return nullptr;
+    if constexpr (Buffer) {
+        tcFloatBuffer* buffer = static_cast<tcFloatBuffer*>(arg);
+        size = buffer->size();
+        return buffer->data();
+    } else {
+        CScriptArray* arr = static_cast<CScriptArray*>(arg);
+        size = arr->GetSize() * floatsPerElement;
+        return static_cast<const float*>(arr->GetBuffer());
+    }
+}
+
+// Reads the arguments of a batched call (`stride` floats per item, optional
+// per-item colors). Sets a script exception on a null or mismatched
+// argument; false if there is nothing to draw.
+template<bool Buffer>
+static bool batchArgs(asIScriptGeneric* gen, const char* func, size_t floatsPerElement, asUINT stride,
+                      const float*& values, asUINT& count, const Color*& colors) {
+    asIScriptContext* ctx = asGetActiveContext();
+    char message[128];
+    size_t size;
+    values = batchFloats<Buffer>(gen, floatsPerElement, size);
+    if (!values) {
+        snprintf(message, sizeof(message), "%s() called with a null array", func);
+        ctx->SetException(message);
+        return false;
+    }
+    if (size % stride != 0) {
+        snprintf(message, sizeof(message), "%s() expects %u floats per item", func, stride);
+        ctx->SetException(message);
+        return false;
+    }
+    count = static_cast<asUINT>(size / stride);
+
+    CScriptArray* colorArray = gen->GetArgCount() > 1 ? static_cast<CScriptArray*>(gen->GetArgObject(1)) : nullptr;
+    if (colorArray && colorArray->GetSize() < count) {
+        snprintf(message, sizeof(message), "%s() got %u colors for %u items", func, colorArray->GetSize(), count);
+        ctx->SetException(message);
+        return false;
+    }
+    colors = colorArray ? static_cast<const Color*>(colorArray->GetBuffer()) : nullptr;
+    return count > 0;
+}
+
+// Shared mesh for the batched calls; keeps its capacity between frames
+static Mesh& batchMesh(PrimitiveMode mode) {
+    static Mesh mesh;
+    mesh.clear();
+    mesh.setMode(mode);
+    return mesh;
+}
+
+// Per-item fallback: each call goes through the immediate-mode binding
+template<typename DrawItem>
+static void drawBatchItems(asUINT count, const Color* colors, DrawItem drawItem) {
+    if (colors) as_pushStyle();
+    for (asUINT i = 0; i < count; i++) {
+        if (colors) as_setColor_4f(colors[i].r, colors[i].g, colors[i].b, colors[i].a);
+        drawItem(i);
+    }
+    if (colors) as_popStyle();
+}
+
+template<bool Buffer>
+static void as_drawCircles(asIScriptGeneric* gen) {
+    const float* v;
+    asUINT count;
+    const Color* c;
+    if (!batchArgs<Buffer>(gen, "drawCircles", 1, 3, v, count, c)) return;
+
+    int resolution = getCircleResolution();
+    if (tcDisplayList::recording || !isFillEnabled() || resolution < 3) {
+        drawBatchItems(count, c, [&](asUINT i) { as_drawCircle_3f(v[i * 3], v[i * 3 + 1], v[i * 3 + 2]); });
+        return;
+    }
+
+    // Unit circle, recomputed when the resolution changes
+    static vector<Vec2> unit;
+    if (unit.size() != static_cast<size_t>(resolution)) {
+        unit.resize(resolution);
+        for (int k = 0; k < resolution; k++) {
+            float t = TAU * k / resolution;
+            unit[k] = Vec2(std::cos(t), std::sin(t));
+        }
+    }
+
+    Mesh& mesh = batchMesh(PrimitiveMode::Triangles);
+    uint32_t base = 0;
+    for (asUINT i = 0; i < count; i++, v += 3) {
+        float x = v[0], y = v[1], radius = v[2];
+        mesh.addVertex(x, y);
+        for (const Vec2& u : unit) mesh.addVertex(x + u.x * radius, y + u.y * radius);
+        for (int k = 0; k < resolution; k++) {
+            mesh.addTriangle(base, base + 1 + k, base + 1 + (k + 1) % resolution);
+        }
+        if (c) {
+            for (int k = 0; k <= resolution; k++) mesh.addColor(c[i]);
+        }
+        base += resolution + 1;
+    }
+    mesh.draw();
+}
+
+template<bool Buffer>
+static void as_drawRects(asIScriptGeneric* gen) {
+    const float* v;
+    asUINT count;
+    const Color* c;
+    if (!batchArgs<Buffer>(gen, "drawRects", 1, 4, v, count, c)) return;
+
+    if (tcDisplayList::recording || !isFillEnabled()) {
+        drawBatchItems(count, c, [&](asUINT i) { as_drawRect_4f(v[i * 4], v[i * 4 + 1], v[i * 4 + 2], v[i * 4 + 3]); });
+        return;
+    }
+
+    Mesh& mesh = batchMesh(PrimitiveMode::Triangles);
+    uint32_t base = 0;
+    for (asUINT i = 0; i < count; i++, v += 4, base += 4) {
+        float x = v[0], y = v[1], w = v[2], h = v[3];
+        mesh.addVertex(x, y);
+        mesh.addVertex(x + w, y);
+        mesh.addVertex(x + w, y + h);
+        mesh.addVertex(x, y + h);
+        mesh.addTriangle(base, base + 1, base + 2);
+        mesh.addTriangle(base, base + 2, base + 3);
+        if (c) {
+            for (int k = 0; k < 4; k++) mesh.addColor(c[i]);
+        }
+    }
+    mesh.draw();
+}
+
+template<bool Buffer>
+static void as_drawLines(asIScriptGeneric* gen) {
+    const float* v;
+    asUINT count;
+    const Color* c;
+    if (!batchArgs<Buffer>(gen, "drawLines", 1, 4, v, count, c)) return;
 
-static void as_rotateDeg_1f(asIScriptGeneric* gen) { rotateDeg(gen->GetArgFloat(0)); }
-static void as_rotateDeg_3f(asIScriptGeneric* gen) { rotateDeg(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2)); }
+    // Mesh lines are one pixel wide
+    if (tcDisplayList::recording || getStrokeWeight() != 1.0f) {
+        drawBatchItems(count, c, [&](asUINT i) { as_drawLine_4f(v[i * 4], v[i * 4 + 1], v[i * 4 + 2], v[i * 4 + 3]); });
+        return;
+    }
+
+    Mesh& mesh = batchMesh(PrimitiveMode::Lines);
+    for (asUINT i = 0; i < count; i++, v += 4) {
+        mesh.addVertex(v[0], v[1]);
+        mesh.addVertex(v[2], v[3]);
+        if (c) {
+            mesh.addColor(c[i]);
+            mesh.addColor(c[i]);
+        }
+    }
+    mesh.draw();
+}
 
-AS_VOID_1F(rotateX)
-AS_VOID_1F(rotateY)
-AS_VOID_1F(rotateZ)
-AS_VOID_1F(rotateXDeg)
-AS_VOID_1F(rotateYDeg)
-AS_VOID_1F(rotateZDeg)
-AS_VOID_0(resetMatrix)
+// array<Vec2> or a FloatBuffer of x, y pairs
+template<bool Buffer>
+static void as_drawPoints(asIScriptGeneric* gen) {
+    const float* v;
+    asUINT count;
+    const Color* c;
+    if (!batchArgs<Buffer>(gen, "drawPoints", 2, 2, v, count, c)) return;
+
+    if (tcDisplayList::recording) {
+        drawBatchItems(count, c, [&](asUINT i) { as_drawPoint_2f(v[i * 2], v[i * 2 + 1]); });
+        return;
+    }
 
-static void as_scale_1f(asIScriptGeneric* gen) { scale(gen->GetArgFloat(0), gen->GetArgFloat(0)); }
-AS_VOID_2F(scale)
+    Mesh& mesh = batchMesh(PrimitiveMode::Points);
+    for (asUINT i = 0; i < count; i++, v += 2) {
+        mesh.addVertex(v[0], v[1]);
+        if (c) mesh.addColor(c[i]);
+    }
+    mesh.draw();
+}
 
 // =============================================================================
 // Window & Input
@@ -214,34 +632,33 @@ AS_INT_0(getWindowWidth)
 AS_INT_0(getWindowHeight)
 AS_FLOAT_0(getMouseX)
 AS_FLOAT_0(getMouseY)
-static void as_isMousePressed(asIScriptGeneric* gen) { gen->SetReturnByte(isMousePressed() ? 1 : 0); }
+AS_BOOL_0(isMousePressed)
 
 // =============================================================================
 // Time - Frame
 // =============================================================================
 AS_FLOAT_0(getDeltaTime)
 AS_FLOAT_0(getFrameRate)
-static void as_getFrameCount(asIScriptGeneric* gen) { gen->SetReturnQWord(getFrameCount()); }
+static int64_t as_getFrameCount() { return getFrameCount(); }
 
 // =============================================================================
 // Time - Elapsed
 // =============================================================================
 AS_FLOAT_0(getElapsedTimef)
-static void as_getElapsedTimeMillis(asIScriptGeneric* gen) { gen->SetReturnQWord(getElapsedTimeMillis()); }
-static void as_getElapsedTimeMicros(asIScriptGeneric* gen) { gen->SetReturnQWord(getElapsedTimeMicros()); }
+static int64_t as_getElapsedTimeMillis() { return getElapsedTimeMillis(); }
+static int64_t as_getElapsedTimeMicros() { return getElapsedTimeMicros(); }
 AS_VOID_0(resetElapsedTimeCounter)
 
 // =============================================================================
 // Time - System
 // =============================================================================
-static void as_getSystemTimeMillis(asIScriptGeneric* gen) { gen->SetReturnQWord(getSystemTimeMillis()); }
-static void as_getSystemTimeMicros(asIScriptGeneric* gen) { gen->SetReturnQWord(getSystemTimeMicros()); }
-static void as_getTimestampString_0(asIScriptGeneric* gen) {
-    new(gen->GetAddressOfReturnLocation()) string(getTimestampString());
+static int64_t as_getSystemTimeMillis() { return getSystemTimeMillis(); }
+static int64_t as_getSystemTimeMicros() { return getSystemTimeMicros(); }
+static string as_getTimestampString_0() {
+    return getTimestampString();
 }
-static void as_getTimestampString_1(asIScriptGeneric* gen) {
-    string* fmt = static_cast<string*>(gen->GetArgObject(0));
-    new(gen->GetAddressOfReturnLocation()) string(getTimestampString(*fmt));
+static string as_getTimestampString_1(const string& fmt) {
+    return getTimestampString(fmt);
 }
 
 // =============================================================================
@@ -255,113 +672,242 @@ AS_INT_0(getMonth)
 AS_INT_0(getDay)
 AS_INT_0(getWeekday)
 
+// =============================================================================
+// Asset cache (decoded files kept across reloads, see tcAssetCache.h)
+// =============================================================================
+static tcAssetCache& assetCache(asIScriptGeneric* gen) {
+    return static_cast<tcScriptHost*>(gen->GetEngine()->GetUserData())->getAssetCache();
+}
+
+static size_t pixelBytes(const Pixels& pixels) {
+    if (!pixels.isAllocated()) return 0;
+    return static_cast<size_t>(pixels.getWidth()) * pixels.getHeight() * pixels.getChannels();
+}
+// Estimates - neither type reports its memory
+static size_t soundBytes(const Sound& sound) {
+    return static_cast<size_t>(sound.getDuration() * 44100.0f) * 2 * sizeof(float);
+}
+static size_t fontBytes(int size) {
+    return static_cast<size_t>(size) * size * 256;  // a glyph cell for each of the first 256 characters
+}
+
+// Decoded image file from the cache, or decoded (and cached) now
+static bool loadCachedPixels(tcAssetCache& cache, const string& path, Pixels& out) {
+    if (auto cached = cache.find<Pixels>("pixels", path)) {
+        out = *cached;
+        return true;
+    }
+    if (!out.load(path)) return false;
+    cache.store("pixels", path, 0, out, pixelBytes(out));
+    return true;
+}
+
+// =============================================================================
+// Asynchronous loading
+// =============================================================================
+
+// Objects with a loadAsync() in flight (for isLoading())
+static std::unordered_map<const void*, int> g_pendingLoads;
+
+static bool isLoading(const void* obj) {
+    return g_pendingLoads.count(obj) > 0;
+}
+
+template<typename Result>
+struct AsyncLoad {
+    Result value;
+    bool ok = false;
+};
+
+// Starts a background load on 'self': decode(result) runs on a worker thread
+// and returns whether it succeeded; apply(self, result) then runs on the main
+// thread and returns whether the object is loaded. The LoadCallback (may be
+// null) gets that outcome before the next update(). 'self' and the callback
+// are kept alive until then.
+template<typename T, typename Result, typename Decode, typename Apply>
+static void startAsyncLoad(asIScriptGeneric* gen, T* self, asIScriptFunction* callback, Decode decode, Apply apply) {
+    tcScriptHost* host = static_cast<tcScriptHost*>(gen->GetEngine()->GetUserData());
+    auto load = std::make_shared<AsyncLoad<Result>>();
+
+    tcscript::scriptAddRef(self);
+    if (callback) callback->AddRef();
+    g_pendingLoads[self]++;
+
+    host->startLoad(
+        [load, decode]() { load->ok = decode(load->value); },
+        [host, self, callback, load, apply](bool cancelled) {
+            bool loaded = load->ok && apply(*self, load->value);
+            if (--g_pendingLoads[self] == 0) g_pendingLoads.erase(self);
+            if (callback) {
+                if (!cancelled) host->callLoadCallback(callback, loaded);
+                callback->Release();
+            }
+            tcscript::scriptRelease(self);
+        });
+}
+
+// =============================================================================
+// Debug - Resource tracking
+// =============================================================================
+static int as_getLiveObjectCount() { return static_cast<int>(tcscript::RefStats::live); }
+
+// =============================================================================
+// Coroutines
+// =============================================================================
+static tcScriptHost* activeHost(asIScriptContext* ctx) {
+    return static_cast<tcScriptHost*>(ctx->GetEngine()->GetUserData());
+}
+static void as_waitFrames(int frames) {
+    asIScriptContext* ctx = asGetActiveContext();
+    // A nested call (Pixels.map(), particle hooks) can't be suspended - the
+    // coroutine would be aborted instead
+    if (ctx->IsNested()) {
+        ctx->SetException("yield() / waitFrames() cannot be called from inside a callback");
+        return;
+    }
+    if (!activeHost(ctx)->yieldCoroutine(ctx, frames)) {
+        ctx->SetException("yield() / waitFrames() can only be called from a coroutine");
+    }
+}
+static void as_yield() {
+    as_waitFrames(1);
+}
+static void as_startCoroutine(asIScriptGeneric* gen) {
+    asIScriptFunction* func = static_cast<asIScriptFunction*>(gen->GetArgObject(0));
+    if (!func) {
+        asGetActiveContext()->SetException("startCoroutine() called with a null function");
+        return;
+    }
+    static_cast<tcScriptHost*>(gen->GetEngine()->GetUserData())->startCoroutine(func);
+}
+
+// Calls a script function from inside a binding, as a nested call on the
+// calling script's context; setArgs(ctx) fills in the arguments. An
+// exception or watchdog abort inside the call carries over to the caller.
+// The watchdog never suspends a nested call; should one be suspended anyway
+// it is aborted, since PopState() discards its frames. Returns false if the
+// call did not finish.
+template<typename SetArgs>
+static bool callNested(asIScriptFunction* func, SetArgs setArgs) {
+    asIScriptContext* ctx = asGetActiveContext();
+    if (!ctx || ctx->PushState() < 0) return false;
+    int r = ctx->Prepare(func);
+    if (r >= 0) {
+        setArgs(ctx);
+        r = ctx->Execute();
+    }
+    string exception = r == asEXECUTION_EXCEPTION ? ctx->GetExceptionString() : "";
+    ctx->PopState();
+    if (r == asEXECUTION_EXCEPTION) ctx->SetException(exception.c_str());
+    else if (r == asEXECUTION_ABORTED || r == asEXECUTION_SUSPENDED) ctx->Abort();
+    return r == asEXECUTION_FINISHED;
+}
+
 // =============================================================================
 // Math - Random
 // =============================================================================
-static void as_random_0(asIScriptGeneric* gen) { gen->SetReturnFloat(random(1.0f)); }
+static float as_random_0() { return random(1.0f); }
 AS_FLOAT_1F(random)
 AS_FLOAT_2F(random)
-static void as_randomInt_1(asIScriptGeneric* gen) { gen->SetReturnDWord(randomInt(gen->GetArgDWord(0))); }
-static void as_randomInt_2(asIScriptGeneric* gen) { gen->SetReturnDWord(randomInt(gen->GetArgDWord(0), gen->GetArgDWord(1))); }
-static void as_randomSeed(asIScriptGeneric* gen) { randomSeed(gen->GetArgDWord(0)); }
+static int as_randomInt_1(int max) { return randomInt(max); }
+static int as_randomInt_2(int min, int max) { return randomInt(min, max); }
+static void as_randomSeed(unsigned int seed) { randomSeed(seed); }
 
 // =============================================================================
 // Math - Noise
 // =============================================================================
 AS_FLOAT_1F(noise)
 AS_FLOAT_2F(noise)
-static void as_noise_3f(asIScriptGeneric* gen) { gen->SetReturnFloat(noise(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2))); }
+static float as_noise_3f(float x, float y, float z) { return noise(x, y, z); }
 AS_FLOAT_1F(signedNoise)
 AS_FLOAT_2F(signedNoise)
-static void as_signedNoise_3f(asIScriptGeneric* gen) { gen->SetReturnFloat(signedNoise(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2))); }
+static float as_signedNoise_3f(float x, float y, float z) { return signedNoise(x, y, z); }
 
 // fbm - with default parameters
-static void as_fbm_2f(asIScriptGeneric* gen) { gen->SetReturnFloat(fbm(gen->GetArgFloat(0), gen->GetArgFloat(1))); }
-static void as_fbm_5f(asIScriptGeneric* gen) { gen->SetReturnFloat(fbm(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgDWord(2), gen->GetArgFloat(3), gen->GetArgFloat(4))); }
+static float as_fbm_2f(float x, float y) { return fbm(x, y); }
+static float as_fbm_5f(float x, float y, int octaves, float lacunarity, float gain) { return fbm(x, y, octaves, lacunarity, gain); }
 
 // =============================================================================
 // Math - Interpolation
 // =============================================================================
-static void as_lerp(asIScriptGeneric* gen) { gen->SetReturnFloat(tc::lerp(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2))); }
-static void as_clamp(asIScriptGeneric* gen) { gen->SetReturnFloat(clamp(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2))); }
-static void as_map(asIScriptGeneric* gen) { gen->SetReturnFloat(tc::map(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2), gen->GetArgFloat(3), gen->GetArgFloat(4))); }
+static float as_lerp(float a, float b, float t) { return tc::lerp(a, b, t); }
+static float as_clamp(float v, float lo, float hi) { return clamp(v, lo, hi); }
+static float as_map(float v, float inMin, float inMax, float outMin, float outMax) { return tc::map(v, inMin, inMax, outMin, outMax); }
 
 // =============================================================================
 // Math - Trigonometry
 // =============================================================================
-static void as_sin(asIScriptGeneric* gen) { gen->SetReturnFloat(std::sin(gen->GetArgFloat(0))); }
-static void as_cos(asIScriptGeneric* gen) { gen->SetReturnFloat(std::cos(gen->GetArgFloat(0))); }
-static void as_tan(asIScriptGeneric* gen) { gen->SetReturnFloat(std::tan(gen->GetArgFloat(0))); }
-static void as_asin(asIScriptGeneric* gen) { gen->SetReturnFloat(std::asin(gen->GetArgFloat(0))); }
-static void as_acos(asIScriptGeneric* gen) { gen->SetReturnFloat(std::acos(gen->GetArgFloat(0))); }
-static void as_atan(asIScriptGeneric* gen) { gen->SetReturnFloat(std::atan(gen->GetArgFloat(0))); }
-static void as_atan2(asIScriptGeneric* gen) { gen->SetReturnFloat(std::atan2(gen->GetArgFloat(0), gen->GetArgFloat(1))); }
-static void as_deg2rad(asIScriptGeneric* gen) { gen->SetReturnFloat(deg2rad(gen->GetArgFloat(0))); }
-static void as_rad2deg(asIScriptGeneric* gen) { gen->SetReturnFloat(rad2deg(gen->GetArgFloat(0))); }
+static float as_sin(float x) { return std::sin(x); }
+static float as_cos(float x) { return std::cos(x); }
+static float as_tan(float x) { return std::tan(x); }
+static float as_asin(float x) { return std::asin(x); }
+static float as_acos(float x) { return std::acos(x); }
+static float as_atan(float x) { return std::atan(x); }
+static float as_atan2(float y, float x) { return std::atan2(y, x); }
+static float as_deg2rad(float deg) { return deg2rad(deg); }
+static float as_rad2deg(float rad) { return rad2deg(rad); }
 
 // =============================================================================
 // Math - General
 // =============================================================================
-static void as_abs(asIScriptGeneric* gen) { gen->SetReturnFloat(std::fabs(gen->GetArgFloat(0))); }
-static void as_sqrt(asIScriptGeneric* gen) { gen->SetReturnFloat(std::sqrt(gen->GetArgFloat(0))); }
-static void as_sq(asIScriptGeneric* gen) { float x = gen->GetArgFloat(0); gen->SetReturnFloat(x * x); }
-static void as_pow(asIScriptGeneric* gen) { gen->SetReturnFloat(std::pow(gen->GetArgFloat(0), gen->GetArgFloat(1))); }
-static void as_log(asIScriptGeneric* gen) { gen->SetReturnFloat(std::log(gen->GetArgFloat(0))); }
-static void as_exp(asIScriptGeneric* gen) { gen->SetReturnFloat(std::exp(gen->GetArgFloat(0))); }
-static void as_min(asIScriptGeneric* gen) { gen->SetReturnFloat(std::min(gen->GetArgFloat(0), gen->GetArgFloat(1))); }
-static void as_max(asIScriptGeneric* gen) { gen->SetReturnFloat(std::max(gen->GetArgFloat(0), gen->GetArgFloat(1))); }
-static void as_floor(asIScriptGeneric* gen) { gen->SetReturnFloat(std::floor(gen->GetArgFloat(0))); }
-static void as_ceil(asIScriptGeneric* gen) { gen->SetReturnFloat(std::ceil(gen->GetArgFloat(0))); }
-static void as_round(asIScriptGeneric* gen) { gen->SetReturnFloat(std::round(gen->GetArgFloat(0))); }
-static void as_fmod(asIScriptGeneric* gen) { gen->SetReturnFloat(std::fmod(gen->GetArgFloat(0), gen->GetArgFloat(1))); }
-static void as_sign(asIScriptGeneric* gen) { gen->SetReturnFloat(sign(gen->GetArgFloat(0))); }
-static void as_fract(asIScriptGeneric* gen) { gen->SetReturnFloat(fract(gen->GetArgFloat(0))); }
+static float as_abs(float x) { return std::fabs(x); }
+static float as_sqrt(float x) { return std::sqrt(x); }
+static float as_sq(float x) { return x * x; }
+static float as_pow(float x, float y) { return std::pow(x, y); }
+static float as_log(float x) { return std::log(x); }
+static float as_exp(float x) { return std::exp(x); }
+static float as_min(float a, float b) { return std::min(a, b); }
+static float as_max(float a, float b) { return std::max(a, b); }
+static float as_floor(float x) { return std::floor(x); }
+static float as_ceil(float x) { return std::ceil(x); }
+static float as_round(float x) { return std::round(x); }
+static float as_fmod(float x, float y) { return std::fmod(x, y); }
+static float as_sign(float x) { return sign(x); }
+static float as_fract(float x) { return fract(x); }
 
 // =============================================================================
 // Math - Geometry
 // =============================================================================
-static void as_dist(asIScriptGeneric* gen) { gen->SetReturnFloat(dist(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2), gen->GetArgFloat(3))); }
-static void as_distSquared(asIScriptGeneric* gen) { gen->SetReturnFloat(distSquared(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2), gen->GetArgFloat(3))); }
+static float as_dist(float x1, float y1, float x2, float y2) { return dist(x1, y1, x2, y2); }
+static float as_distSquared(float x1, float y1, float x2, float y2) { return distSquared(x1, y1, x2, y2); }
 
 // =============================================================================
 // System
 // =============================================================================
 AS_VOID_0(toggleFullscreen)
-static void as_setClipboardString(asIScriptGeneric* gen) {
-    string* text = static_cast<string*>(gen->GetArgObject(0));
-    setClipboardString(*text);
+static void as_setClipboardString(const string& text) {
+    setClipboardString(text);
 }
-static void as_getClipboardString(asIScriptGeneric* gen) {
-    new(gen->GetAddressOfReturnLocation()) string(getClipboardString());
+static string as_getClipboardString() {
+    return getClipboardString();
 }
 
 // =============================================================================
 // Utility
 // =============================================================================
-static void as_logNotice(asIScriptGeneric* gen) {
-    string* str = static_cast<string*>(gen->GetArgObject(0));
-    logNotice(*str);
+static void as_logNotice(const string& str) {
+    logNotice(str);
 }
-static void as_toString_int(asIScriptGeneric* gen) {
-    new(gen->GetAddressOfReturnLocation()) string(to_string(gen->GetArgDWord(0)));
+static string as_toString_int(int value) {
+    return to_string(value);
 }
-static void as_toString_float(asIScriptGeneric* gen) {
-    new(gen->GetAddressOfReturnLocation()) string(to_string(gen->GetArgFloat(0)));
+static string as_toString_float(float value) {
+    return to_string(value);
 }
 AS_VOID_0(beep)
-static void as_beep_1f(asIScriptGeneric* gen) { beep(gen->GetArgFloat(0)); }
+AS_VOID_1F(beep)
 
 // =============================================================================
 // 3D Projection
 // =============================================================================
 AS_VOID_0(setupScreenPerspective)
-static void as_setupScreenPerspective_1f(asIScriptGeneric* gen) { setupScreenPerspective(gen->GetArgFloat(0)); }
-static void as_setupScreenPerspective_3f(asIScriptGeneric* gen) { setupScreenPerspective(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2)); }
+AS_VOID_1F(setupScreenPerspective)
+AS_VOID_3F(setupScreenPerspective)
 AS_VOID_0(setupScreenOrtho)
-static void as_setupScreenFov_1f(asIScriptGeneric* gen) { setupScreenFov(gen->GetArgFloat(0)); }
-static void as_setupScreenFov_3f(asIScriptGeneric* gen) { setupScreenFov(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2)); }
-static void as_setDefaultScreenFov(asIScriptGeneric* gen) { setDefaultScreenFov(gen->GetArgFloat(0)); }
-static void as_getDefaultScreenFov(asIScriptGeneric* gen) { gen->SetReturnFloat(getDefaultScreenFov()); }
+AS_VOID_1F(setupScreenFov)
+AS_VOID_3F(setupScreenFov)
+static void as_setDefaultScreenFov(float fov) { setDefaultScreenFov(fov); }
+static float as_getDefaultScreenFov() { return getDefaultScreenFov(); }
 
 // =============================================================================
 // Constants
@@ -396,560 +942,427 @@ static const float kQuarterTau = TAU / 4.0f;
 // =============================================================================
 // Vec2 type for AngelScript
 // =============================================================================
-static void Vec2_Construct(asIScriptGeneric* gen) {
-    new(gen->GetObject()) Vec2();
+static void Vec2_Construct(Vec2* self) {
+    new(self) Vec2();
 }
-static void Vec2_Construct_2f(asIScriptGeneric* gen) {
-    new(gen->GetObject()) Vec2(gen->GetArgFloat(0), gen->GetArgFloat(1));
+static void Vec2_Construct_2f(Vec2* self, float x, float y) {
+    new(self) Vec2(x, y);
 }
-static void Vec2_Construct_1f(asIScriptGeneric* gen) {
-    float v = gen->GetArgFloat(0);
-    new(gen->GetObject()) Vec2(v, v);
+static void Vec2_Construct_1f(Vec2* self, float v) {
+    new(self) Vec2(v, v);
 }
-static void Vec2_CopyConstruct(asIScriptGeneric* gen) {
-    Vec2* other = static_cast<Vec2*>(gen->GetArgObject(0));
-    new(gen->GetObject()) Vec2(*other);
+static void Vec2_CopyConstruct(Vec2* self, const Vec2& other) {
+    new(self) Vec2(other);
 }
-static void Vec2_Set(asIScriptGeneric* gen) {
-    Vec2* self = static_cast<Vec2*>(gen->GetObject());
-    self->x = gen->GetArgFloat(0);
-    self->y = gen->GetArgFloat(1);
-    gen->SetReturnObject(self);
+static Vec2& Vec2_Set(Vec2* self, float x, float y) {
+    self->x = x;
+    self->y = y;
+    return *self;
 }
-static void Vec2_Length(asIScriptGeneric* gen) {
-    Vec2* self = static_cast<Vec2*>(gen->GetObject());
-    gen->SetReturnFloat(self->length());
+static float Vec2_Length(Vec2* self) {
+    return self->length();
 }
-static void Vec2_LengthSquared(asIScriptGeneric* gen) {
-    Vec2* self = static_cast<Vec2*>(gen->GetObject());
-    gen->SetReturnFloat(self->lengthSquared());
+static float Vec2_LengthSquared(Vec2* self) {
+    return self->lengthSquared();
 }
-static void Vec2_Normalize(asIScriptGeneric* gen) {
-    Vec2* self = static_cast<Vec2*>(gen->GetObject());
-    gen->SetReturnObject(&self->normalize());
+static Vec2& Vec2_Normalize(Vec2* self) {
+    return self->normalize();
 }
-static void Vec2_Normalized(asIScriptGeneric* gen) {
-    Vec2* self = static_cast<Vec2*>(gen->GetObject());
-    new(gen->GetAddressOfReturnLocation()) Vec2(self->normalized());
+static Vec2 Vec2_Normalized(Vec2* self) {
+    return self->normalized();
 }
-static void Vec2_Dot(asIScriptGeneric* gen) {
-    Vec2* self = static_cast<Vec2*>(gen->GetObject());
-    Vec2* other = static_cast<Vec2*>(gen->GetArgObject(0));
-    gen->SetReturnFloat(self->dot(*other));
+static float Vec2_Dot(Vec2* self, const Vec2& other) {
+    return self->dot(other);
 }
-static void Vec2_Distance(asIScriptGeneric* gen) {
-    Vec2* self = static_cast<Vec2*>(gen->GetObject());
-    Vec2* other = static_cast<Vec2*>(gen->GetArgObject(0));
-    gen->SetReturnFloat(self->distance(*other));
+static float Vec2_Distance(Vec2* self, const Vec2& other) {
+    return self->distance(other);
 }
-static void Vec2_Angle(asIScriptGeneric* gen) {
-    Vec2* self = static_cast<Vec2*>(gen->GetObject());
-    gen->SetReturnFloat(self->angle());
+static float Vec2_Angle(Vec2* self) {
+    return self->angle();
 }
-static void Vec2_Rotate(asIScriptGeneric* gen) {
-    Vec2* self = static_cast<Vec2*>(gen->GetObject());
-    gen->SetReturnObject(&self->rotate(gen->GetArgFloat(0)));
+static Vec2& Vec2_Rotate(Vec2* self, float radians) {
+    return self->rotate(radians);
 }
-static void Vec2_Rotated(asIScriptGeneric* gen) {
-    Vec2* self = static_cast<Vec2*>(gen->GetObject());
-    new(gen->GetAddressOfReturnLocation()) Vec2(self->rotated(gen->GetArgFloat(0)));
+static Vec2 Vec2_Rotated(Vec2* self, float radians) {
+    return self->rotated(radians);
 }
-static void Vec2_fromAngle_1f(asIScriptGeneric* gen) {
-    new(gen->GetAddressOfReturnLocation()) Vec2(Vec2::fromAngle(gen->GetArgFloat(0)));
+static Vec2 Vec2_fromAngle_1f(float radians) {
+    return Vec2::fromAngle(radians);
 }
-static void Vec2_fromAngle_2f(asIScriptGeneric* gen) {
-    new(gen->GetAddressOfReturnLocation()) Vec2(Vec2::fromAngle(gen->GetArgFloat(0), gen->GetArgFloat(1)));
+static Vec2 Vec2_fromAngle_2f(float radians, float length) {
+    return Vec2::fromAngle(radians, length);
 }
 // Operators
-static void Vec2_OpAdd(asIScriptGeneric* gen) {
-    Vec2* a = static_cast<Vec2*>(gen->GetObject());
-    Vec2* b = static_cast<Vec2*>(gen->GetArgObject(0));
-    new(gen->GetAddressOfReturnLocation()) Vec2(*a + *b);
-}
-static void Vec2_OpSub(asIScriptGeneric* gen) {
-    Vec2* a = static_cast<Vec2*>(gen->GetObject());
-    Vec2* b = static_cast<Vec2*>(gen->GetArgObject(0));
-    new(gen->GetAddressOfReturnLocation()) Vec2(*a - *b);
-}
-static void Vec2_OpMulScalar(asIScriptGeneric* gen) {
-    Vec2* a = static_cast<Vec2*>(gen->GetObject());
-    float s = gen->GetArgFloat(0);
-    new(gen->GetAddressOfReturnLocation()) Vec2(*a * s);
-}
-static void Vec2_OpDivScalar(asIScriptGeneric* gen) {
-    Vec2* a = static_cast<Vec2*>(gen->GetObject());
-    float s = gen->GetArgFloat(0);
-    new(gen->GetAddressOfReturnLocation()) Vec2(*a / s);
-}
-static void Vec2_OpNeg(asIScriptGeneric* gen) {
-    Vec2* a = static_cast<Vec2*>(gen->GetObject());
-    new(gen->GetAddressOfReturnLocation()) Vec2(-*a);
-}
-static void Vec2_Limit(asIScriptGeneric* gen) {
-    Vec2* self = static_cast<Vec2*>(gen->GetObject());
-    float maxLen = gen->GetArgFloat(0);
+static Vec2 Vec2_OpAdd(Vec2* a, const Vec2& b) {
+    return *a + b;
+}
+static Vec2 Vec2_OpSub(Vec2* a, const Vec2& b) {
+    return *a - b;
+}
+static Vec2 Vec2_OpMulScalar(Vec2* a, float s) {
+    return *a * s;
+}
+static Vec2 Vec2_OpDivScalar(Vec2* a, float s) {
+    return *a / s;
+}
+static Vec2 Vec2_OpNeg(Vec2* a) {
+    return -*a;
+}
+static Vec2& Vec2_Limit(Vec2* self, float maxLen) {
     self->limit(maxLen);
-    gen->SetReturnObject(self);
+    return *self;
 }
-static void Vec2_Cross(asIScriptGeneric* gen) {
-    Vec2* self = static_cast<Vec2*>(gen->GetObject());
-    Vec2* other = static_cast<Vec2*>(gen->GetArgObject(0));
-    gen->SetReturnFloat(self->cross(*other));
+static float Vec2_Cross(Vec2* self, const Vec2& other) {
+    return self->cross(other);
 }
-static void Vec2_DistanceSquared(asIScriptGeneric* gen) {
-    Vec2* self = static_cast<Vec2*>(gen->GetObject());
-    Vec2* other = static_cast<Vec2*>(gen->GetArgObject(0));
-    gen->SetReturnFloat(self->distanceSquared(*other));
+static float Vec2_DistanceSquared(Vec2* self, const Vec2& other) {
+    return self->distanceSquared(other);
 }
-static void Vec2_Lerp(asIScriptGeneric* gen) {
-    Vec2* self = static_cast<Vec2*>(gen->GetObject());
-    Vec2* other = static_cast<Vec2*>(gen->GetArgObject(0));
-    float t = gen->GetArgFloat(1);
-    new(gen->GetAddressOfReturnLocation()) Vec2(self->lerp(*other, t));
+static Vec2 Vec2_Lerp(Vec2* self, const Vec2& other, float t) {
+    return self->lerp(other, t);
 }
-static void Vec2_Perpendicular(asIScriptGeneric* gen) {
-    Vec2* self = static_cast<Vec2*>(gen->GetObject());
-    new(gen->GetAddressOfReturnLocation()) Vec2(self->perpendicular());
+static Vec2 Vec2_Perpendicular(Vec2* self) {
+    return self->perpendicular();
 }
-static void Vec2_Reflected(asIScriptGeneric* gen) {
-    Vec2* self = static_cast<Vec2*>(gen->GetObject());
-    Vec2* normal = static_cast<Vec2*>(gen->GetArgObject(0));
-    new(gen->GetAddressOfReturnLocation()) Vec2(self->reflected(*normal));
+static Vec2 Vec2_Reflected(Vec2* self, const Vec2& normal) {
+    return self->reflected(normal);
 }
-static void Vec2_AngleWith(asIScriptGeneric* gen) {
-    Vec2* self = static_cast<Vec2*>(gen->GetObject());
-    Vec2* other = static_cast<Vec2*>(gen->GetArgObject(0));
-    gen->SetReturnFloat(self->angle(*other));
+static float Vec2_AngleWith(Vec2* self, const Vec2& other) {
+    return self->angle(other);
 }
 
 // =============================================================================
 // Vec3 type for AngelScript
 // =============================================================================
-static void Vec3_Construct(asIScriptGeneric* gen) {
-    new(gen->GetObject()) Vec3();
+static void Vec3_Construct(Vec3* self) {
+    new(self) Vec3();
 }
-static void Vec3_Construct_3f(asIScriptGeneric* gen) {
-    new(gen->GetObject()) Vec3(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2));
+static void Vec3_Construct_3f(Vec3* self, float x, float y, float z) {
+    new(self) Vec3(x, y, z);
 }
-static void Vec3_Construct_1f(asIScriptGeneric* gen) {
-    float v = gen->GetArgFloat(0);
-    new(gen->GetObject()) Vec3(v, v, v);
+static void Vec3_Construct_1f(Vec3* self, float v) {
+    new(self) Vec3(v, v, v);
 }
-static void Vec3_CopyConstruct(asIScriptGeneric* gen) {
-    Vec3* other = static_cast<Vec3*>(gen->GetArgObject(0));
-    new(gen->GetObject()) Vec3(*other);
+static void Vec3_CopyConstruct(Vec3* self, const Vec3& other) {
+    new(self) Vec3(other);
 }
-static void Vec3_Set(asIScriptGeneric* gen) {
-    Vec3* self = static_cast<Vec3*>(gen->GetObject());
-    self->x = gen->GetArgFloat(0);
-    self->y = gen->GetArgFloat(1);
-    self->z = gen->GetArgFloat(2);
-    gen->SetReturnObject(self);
+static Vec3& Vec3_Set(Vec3* self, float x, float y, float z) {
+    self->x = x;
+    self->y = y;
+    self->z = z;
+    return *self;
 }
-static void Vec3_Length(asIScriptGeneric* gen) {
-    Vec3* self = static_cast<Vec3*>(gen->GetObject());
-    gen->SetReturnFloat(self->length());
+static float Vec3_Length(Vec3* self) {
+    return self->length();
 }
-static void Vec3_LengthSquared(asIScriptGeneric* gen) {
-    Vec3* self = static_cast<Vec3*>(gen->GetObject());
-    gen->SetReturnFloat(self->lengthSquared());
+static float Vec3_LengthSquared(Vec3* self) {
+    return self->lengthSquared();
 }
-static void Vec3_Normalize(asIScriptGeneric* gen) {
-    Vec3* self = static_cast<Vec3*>(gen->GetObject());
-    gen->SetReturnObject(&self->normalize());
+static Vec3& Vec3_Normalize(Vec3* self) {
+    return self->normalize();
 }
-static void Vec3_Normalized(asIScriptGeneric* gen) {
-    Vec3* self = static_cast<Vec3*>(gen->GetObject());
-    new(gen->GetAddressOfReturnLocation()) Vec3(self->normalized());
+static Vec3 Vec3_Normalized(Vec3* self) {
+    return self->normalized();
 }
-static void Vec3_Dot(asIScriptGeneric* gen) {
-    Vec3* self = static_cast<Vec3*>(gen->GetObject());
-    Vec3* other = static_cast<Vec3*>(gen->GetArgObject(0));
-    gen->SetReturnFloat(self->dot(*other));
+static float Vec3_Dot(Vec3* self, const Vec3& other) {
+    return self->dot(other);
 }
-static void Vec3_Cross(asIScriptGeneric* gen) {
-    Vec3* self = static_cast<Vec3*>(gen->GetObject());
-    Vec3* other = static_cast<Vec3*>(gen->GetArgObject(0));
-    new(gen->GetAddressOfReturnLocation()) Vec3(self->cross(*other));
+static Vec3 Vec3_Cross(Vec3* self, const Vec3& other) {
+    return self->cross(other);
 }
 // Operators
-static void Vec3_OpAdd(asIScriptGeneric* gen) {
-    Vec3* a = static_cast<Vec3*>(gen->GetObject());
-    Vec3* b = static_cast<Vec3*>(gen->GetArgObject(0));
-    new(gen->GetAddressOfReturnLocation()) Vec3(*a + *b);
-}
-static void Vec3_OpSub(asIScriptGeneric* gen) {
-    Vec3* a = static_cast<Vec3*>(gen->GetObject());
-    Vec3* b = static_cast<Vec3*>(gen->GetArgObject(0));
-    new(gen->GetAddressOfReturnLocation()) Vec3(*a - *b);
-}
-static void Vec3_OpMulScalar(asIScriptGeneric* gen) {
-    Vec3* a = static_cast<Vec3*>(gen->GetObject());
-    float s = gen->GetArgFloat(0);
-    new(gen->GetAddressOfReturnLocation()) Vec3(*a * s);
-}
-static void Vec3_OpDivScalar(asIScriptGeneric* gen) {
-    Vec3* a = static_cast<Vec3*>(gen->GetObject());
-    float s = gen->GetArgFloat(0);
-    new(gen->GetAddressOfReturnLocation()) Vec3(*a / s);
-}
-static void Vec3_OpNeg(asIScriptGeneric* gen) {
-    Vec3* a = static_cast<Vec3*>(gen->GetObject());
-    new(gen->GetAddressOfReturnLocation()) Vec3(-*a);
-}
-static void Vec3_Limit(asIScriptGeneric* gen) {
-    Vec3* self = static_cast<Vec3*>(gen->GetObject());
-    float maxLen = gen->GetArgFloat(0);
+static Vec3 Vec3_OpAdd(Vec3* a, const Vec3& b) {
+    return *a + b;
+}
+static Vec3 Vec3_OpSub(Vec3* a, const Vec3& b) {
+    return *a - b;
+}
+static Vec3 Vec3_OpMulScalar(Vec3* a, float s) {
+    return *a * s;
+}
+static Vec3 Vec3_OpDivScalar(Vec3* a, float s) {
+    return *a / s;
+}
+static Vec3 Vec3_OpNeg(Vec3* a) {
+    return -*a;
+}
+static Vec3& Vec3_Limit(Vec3* self, float maxLen) {
     self->limit(maxLen);
-    gen->SetReturnObject(self);
+    return *self;
 }
-static void Vec3_Distance(asIScriptGeneric* gen) {
-    Vec3* self = static_cast<Vec3*>(gen->GetObject());
-    Vec3* other = static_cast<Vec3*>(gen->GetArgObject(0));
-    gen->SetReturnFloat(self->distance(*other));
+static float Vec3_Distance(Vec3* self, const Vec3& other) {
+    return self->distance(other);
 }
-static void Vec3_DistanceSquared(asIScriptGeneric* gen) {
-    Vec3* self = static_cast<Vec3*>(gen->GetObject());
-    Vec3* other = static_cast<Vec3*>(gen->GetArgObject(0));
-    gen->SetReturnFloat(self->distanceSquared(*other));
+static float Vec3_DistanceSquared(Vec3* self, const Vec3& other) {
+    return self->distanceSquared(other);
 }
-static void Vec3_Lerp(asIScriptGeneric* gen) {
-    Vec3* self = static_cast<Vec3*>(gen->GetObject());
-    Vec3* other = static_cast<Vec3*>(gen->GetArgObject(0));
-    float t = gen->GetArgFloat(1);
-    new(gen->GetAddressOfReturnLocation()) Vec3(self->lerp(*other, t));
+static Vec3 Vec3_Lerp(Vec3* self, const Vec3& other, float t) {
+    return self->lerp(other, t);
 }
-static void Vec3_Reflected(asIScriptGeneric* gen) {
-    Vec3* self = static_cast<Vec3*>(gen->GetObject());
-    Vec3* normal = static_cast<Vec3*>(gen->GetArgObject(0));
-    new(gen->GetAddressOfReturnLocation()) Vec3(self->reflected(*normal));
+static Vec3 Vec3_Reflected(Vec3* self, const Vec3& normal) {
+    return self->reflected(normal);
 }
-static void Vec3_XY(asIScriptGeneric* gen) {
-    Vec3* self = static_cast<Vec3*>(gen->GetObject());
-    new(gen->GetAddressOfReturnLocation()) Vec2(self->xy());
+static Vec2 Vec3_XY(Vec3* self) {
+    return self->xy();
 }
 
 // =============================================================================
 // Color type for AngelScript
 // =============================================================================
-static void Color_Construct(asIScriptGeneric* gen) {
-    new(gen->GetObject()) Color();
+static void Color_Construct(Color* self) {
+    new(self) Color();
 }
-static void Color_Construct_3f(asIScriptGeneric* gen) {
-    new(gen->GetObject()) Color(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2));
+static void Color_Construct_3f(Color* self, float r, float g, float b) {
+    new(self) Color(r, g, b);
 }
-static void Color_Construct_4f(asIScriptGeneric* gen) {
-    new(gen->GetObject()) Color(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2), gen->GetArgFloat(3));
+static void Color_Construct_4f(Color* self, float r, float g, float b, float a) {
+    new(self) Color(r, g, b, a);
 }
-static void Color_Construct_1f(asIScriptGeneric* gen) {
-    float v = gen->GetArgFloat(0);
-    new(gen->GetObject()) Color(v, v, v);
+static void Color_Construct_1f(Color* self, float v) {
+    new(self) Color(v, v, v);
 }
-static void Color_CopyConstruct(asIScriptGeneric* gen) {
-    Color* other = static_cast<Color*>(gen->GetArgObject(0));
-    new(gen->GetObject()) Color(*other);
+static void Color_CopyConstruct(Color* self, const Color& other) {
+    new(self) Color(other);
 }
-static void Color_Set_3f(asIScriptGeneric* gen) {
-    Color* self = static_cast<Color*>(gen->GetObject());
-    self->r = gen->GetArgFloat(0);
-    self->g = gen->GetArgFloat(1);
-    self->b = gen->GetArgFloat(2);
-    gen->SetReturnObject(self);
+static Color& Color_Set_3f(Color* self, float r, float g, float b) {
+    self->r = r;
+    self->g = g;
+    self->b = b;
+    return *self;
 }
-static void Color_Set_4f(asIScriptGeneric* gen) {
-    Color* self = static_cast<Color*>(gen->GetObject());
-    self->r = gen->GetArgFloat(0);
-    self->g = gen->GetArgFloat(1);
-    self->b = gen->GetArgFloat(2);
-    self->a = gen->GetArgFloat(3);
-    gen->SetReturnObject(self);
+static Color& Color_Set_4f(Color* self, float r, float g, float b, float a) {
+    self->r = r;
+    self->g = g;
+    self->b = b;
+    self->a = a;
+    return *self;
 }
-static void Color_Lerp(asIScriptGeneric* gen) {
-    Color* self = static_cast<Color*>(gen->GetObject());
-    Color* target = static_cast<Color*>(gen->GetArgObject(0));
-    float t = gen->GetArgFloat(1);
-    new(gen->GetAddressOfReturnLocation()) Color(self->lerp(*target, t));
+static Color Color_Lerp(Color* self, const Color& target, float t) {
+    return self->lerp(target, t);
 }
-static void Color_fromHSB_3f(asIScriptGeneric* gen) {
-    new(gen->GetAddressOfReturnLocation()) Color(Color::fromHSB(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2)));
+static Color Color_fromHSB_3f(float h, float s, float b) {
+    return Color::fromHSB(h, s, b);
 }
-static void Color_fromHSB_4f(asIScriptGeneric* gen) {
-    new(gen->GetAddressOfReturnLocation()) Color(Color::fromHSB(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2), gen->GetArgFloat(3)));
+static Color Color_fromHSB_4f(float h, float s, float b, float a) {
+    return Color::fromHSB(h, s, b, a);
 }
-static void Color_fromOKLCH_3f(asIScriptGeneric* gen) {
-    new(gen->GetAddressOfReturnLocation()) Color(Color::fromOKLCH(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2)));
+static Color Color_fromOKLCH_3f(float l, float c, float h) {
+    return Color::fromOKLCH(l, c, h);
 }
-static void Color_fromOKLCH_4f(asIScriptGeneric* gen) {
-    new(gen->GetAddressOfReturnLocation()) Color(Color::fromOKLCH(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2), gen->GetArgFloat(3)));
+static Color Color_fromOKLCH_4f(float l, float c, float h, float a) {
+    return Color::fromOKLCH(l, c, h, a);
 }
-static void Color_fromOKLab_3f(asIScriptGeneric* gen) {
-    new(gen->GetAddressOfReturnLocation()) Color(Color::fromOKLab(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2)));
+static Color Color_fromOKLab_3f(float l, float a, float b) {
+    return Color::fromOKLab(l, a, b);
 }
-static void Color_fromOKLab_4f(asIScriptGeneric* gen) {
-    new(gen->GetAddressOfReturnLocation()) Color(Color::fromOKLab(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2), gen->GetArgFloat(3)));
+static Color Color_fromOKLab_4f(float l, float a, float b, float alpha) {
+    return Color::fromOKLab(l, a, b, alpha);
 }
-static void Color_ToHex_0(asIScriptGeneric* gen) {
-    Color* self = static_cast<Color*>(gen->GetObject());
-    gen->SetReturnDWord(self->toHex(false));
+static unsigned int Color_ToHex_0(Color* self) {
+    return self->toHex(false);
 }
-static void Color_ToHex_1b(asIScriptGeneric* gen) {
-    Color* self = static_cast<Color*>(gen->GetObject());
-    bool includeAlpha = gen->GetArgByte(0) != 0;
-    gen->SetReturnDWord(self->toHex(includeAlpha));
+static unsigned int Color_ToHex_1b(Color* self, bool includeAlpha) {
+    return self->toHex(includeAlpha);
 }
-static void Color_LerpRGB(asIScriptGeneric* gen) {
-    Color* self = static_cast<Color*>(gen->GetObject());
-    Color* target = static_cast<Color*>(gen->GetArgObject(0));
-    float t = gen->GetArgFloat(1);
-    new(gen->GetAddressOfReturnLocation()) Color(self->lerpRGB(*target, t));
+static Color Color_LerpRGB(Color* self, const Color& target, float t) {
+    return self->lerpRGB(target, t);
 }
-static void Color_Clamped(asIScriptGeneric* gen) {
-    Color* self = static_cast<Color*>(gen->GetObject());
-    new(gen->GetAddressOfReturnLocation()) Color(self->clamped());
+static Color Color_Clamped(Color* self) {
+    return self->clamped();
 }
 
 // =============================================================================
 // Rect type for AngelScript
 // =============================================================================
-static void Rect_Construct(asIScriptGeneric* gen) {
-    new(gen->GetObject()) Rect();
+static void Rect_Construct(Rect* self) {
+    new(self) Rect();
 }
-static void Rect_Construct_4f(asIScriptGeneric* gen) {
-    new(gen->GetObject()) Rect(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2), gen->GetArgFloat(3));
+static void Rect_Construct_4f(Rect* self, float x, float y, float w, float h) {
+    new(self) Rect(x, y, w, h);
 }
-static void Rect_CopyConstruct(asIScriptGeneric* gen) {
-    Rect* other = static_cast<Rect*>(gen->GetArgObject(0));
-    new(gen->GetObject()) Rect(*other);
+static void Rect_CopyConstruct(Rect* self, const Rect& other) {
+    new(self) Rect(other);
 }
-static void Rect_Set(asIScriptGeneric* gen) {
-    Rect* self = static_cast<Rect*>(gen->GetObject());
-    self->x = gen->GetArgFloat(0);
-    self->y = gen->GetArgFloat(1);
-    self->width = gen->GetArgFloat(2);
-    self->height = gen->GetArgFloat(3);
-    gen->SetReturnObject(self);
+static Rect& Rect_Set(Rect* self, float x, float y, float w, float h) {
+    self->x = x;
+    self->y = y;
+    self->width = w;
+    self->height = h;
+    return *self;
 }
-static void Rect_Contains(asIScriptGeneric* gen) {
-    Rect* self = static_cast<Rect*>(gen->GetObject());
-    gen->SetReturnByte(self->contains(gen->GetArgFloat(0), gen->GetArgFloat(1)) ? 1 : 0);
+static bool Rect_Contains(Rect* self, float x, float y) {
+    return self->contains(x, y);
 }
-static void Rect_Intersects(asIScriptGeneric* gen) {
-    Rect* self = static_cast<Rect*>(gen->GetObject());
-    Rect* other = static_cast<Rect*>(gen->GetArgObject(0));
-    gen->SetReturnByte(self->intersects(*other) ? 1 : 0);
+static bool Rect_Intersects(Rect* self, const Rect& other) {
+    return self->intersects(other);
 }
-static void Rect_GetCenterX(asIScriptGeneric* gen) {
-    Rect* self = static_cast<Rect*>(gen->GetObject());
-    gen->SetReturnFloat(self->getCenterX());
+static float Rect_GetCenterX(Rect* self) {
+    return self->getCenterX();
 }
-static void Rect_GetCenterY(asIScriptGeneric* gen) {
-    Rect* self = static_cast<Rect*>(gen->GetObject());
-    gen->SetReturnFloat(self->getCenterY());
+static float Rect_GetCenterY(Rect* self) {
+    return self->getCenterY();
 }
-static void Rect_GetRight(asIScriptGeneric* gen) {
-    Rect* self = static_cast<Rect*>(gen->GetObject());
-    gen->SetReturnFloat(self->getRight());
+static float Rect_GetRight(Rect* self) {
+    return self->getRight();
 }
-static void Rect_GetBottom(asIScriptGeneric* gen) {
-    Rect* self = static_cast<Rect*>(gen->GetObject());
-    gen->SetReturnFloat(self->getBottom());
+static float Rect_GetBottom(Rect* self) {
+    return self->getBottom();
 }
 
 // =============================================================================
 // Mat4 value type wrappers
 // =============================================================================
-static void Mat4_Construct(asIScriptGeneric* gen) {
-    new (gen->GetAddressOfReturnLocation()) Mat4();
+static void Mat4_Construct(Mat4* self) {
+    new (self) Mat4();
 }
-static void Mat4_CopyConstruct(asIScriptGeneric* gen) {
-    Mat4* other = static_cast<Mat4*>(gen->GetArgObject(0));
-    new (gen->GetAddressOfReturnLocation()) Mat4(*other);
+static void Mat4_CopyConstruct(Mat4* self, const Mat4& other) {
+    new (self) Mat4(other);
 }
-static void Mat4_OpMul_Mat4(asIScriptGeneric* gen) {
-    Mat4* self = static_cast<Mat4*>(gen->GetObject());
-    Mat4* other = static_cast<Mat4*>(gen->GetArgObject(0));
-    new (gen->GetAddressOfReturnLocation()) Mat4(*self * *other);
+static Mat4 Mat4_OpMul_Mat4(Mat4* self, const Mat4& other) {
+    return *self * other;
 }
-static void Mat4_OpMul_Vec3(asIScriptGeneric* gen) {
-    Mat4* self = static_cast<Mat4*>(gen->GetObject());
-    Vec3* v = static_cast<Vec3*>(gen->GetArgObject(0));
-    new (gen->GetAddressOfReturnLocation()) Vec3(*self * *v);
+static Vec3 Mat4_OpMul_Vec3(Mat4* self, const Vec3& v) {
+    return *self * v;
 }
-static void Mat4_Transposed(asIScriptGeneric* gen) {
-    Mat4* self = static_cast<Mat4*>(gen->GetObject());
-    new (gen->GetAddressOfReturnLocation()) Mat4(self->transposed());
+static Mat4 Mat4_Transposed(Mat4* self) {
+    return self->transposed();
 }
-static void Mat4_Inverted(asIScriptGeneric* gen) {
-    Mat4* self = static_cast<Mat4*>(gen->GetObject());
-    new (gen->GetAddressOfReturnLocation()) Mat4(self->inverted());
+static Mat4 Mat4_Inverted(Mat4* self) {
+    return self->inverted();
 }
 // Static factory functions for Mat4
-static void Mat4_Identity(asIScriptGeneric* gen) {
-    new (gen->GetAddressOfReturnLocation()) Mat4(Mat4::identity());
+static Mat4 Mat4_Identity() {
+    return Mat4::identity();
 }
-static void Mat4_Translate_3f(asIScriptGeneric* gen) {
-    new (gen->GetAddressOfReturnLocation()) Mat4(Mat4::translate(
-        gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2)));
+static Mat4 Mat4_Translate_3f(float x, float y, float z) {
+    return Mat4::translate(x, y, z);
 }
-static void Mat4_Translate_Vec3(asIScriptGeneric* gen) {
-    Vec3* v = static_cast<Vec3*>(gen->GetArgObject(0));
-    new (gen->GetAddressOfReturnLocation()) Mat4(Mat4::translate(*v));
+static Mat4 Mat4_Translate_Vec3(const Vec3& v) {
+    return Mat4::translate(v);
 }
-static void Mat4_RotateX(asIScriptGeneric* gen) {
-    new (gen->GetAddressOfReturnLocation()) Mat4(Mat4::rotateX(gen->GetArgFloat(0)));
+static Mat4 Mat4_RotateX(float radians) {
+    return Mat4::rotateX(radians);
 }
-static void Mat4_RotateY(asIScriptGeneric* gen) {
-    new (gen->GetAddressOfReturnLocation()) Mat4(Mat4::rotateY(gen->GetArgFloat(0)));
+static Mat4 Mat4_RotateY(float radians) {
+    return Mat4::rotateY(radians);
 }
-static void Mat4_RotateZ(asIScriptGeneric* gen) {
-    new (gen->GetAddressOfReturnLocation()) Mat4(Mat4::rotateZ(gen->GetArgFloat(0)));
+static Mat4 Mat4_RotateZ(float radians) {
+    return Mat4::rotateZ(radians);
 }
-static void Mat4_Scale_1f(asIScriptGeneric* gen) {
-    new (gen->GetAddressOfReturnLocation()) Mat4(Mat4::scale(gen->GetArgFloat(0)));
+static Mat4 Mat4_Scale_1f(float s) {
+    return Mat4::scale(s);
 }
-static void Mat4_Scale_3f(asIScriptGeneric* gen) {
-    new (gen->GetAddressOfReturnLocation()) Mat4(Mat4::scale(
-        gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2)));
+static Mat4 Mat4_Scale_3f(float x, float y, float z) {
+    return Mat4::scale(x, y, z);
 }
-static void Mat4_LookAt(asIScriptGeneric* gen) {
-    Vec3* eye = static_cast<Vec3*>(gen->GetArgObject(0));
-    Vec3* target = static_cast<Vec3*>(gen->GetArgObject(1));
-    Vec3* up = static_cast<Vec3*>(gen->GetArgObject(2));
-    new (gen->GetAddressOfReturnLocation()) Mat4(Mat4::lookAt(*eye, *target, *up));
+static Mat4 Mat4_LookAt(const Vec3& eye, const Vec3& target, const Vec3& up) {
+    return Mat4::lookAt(eye, target, up);
 }
-static void Mat4_Ortho(asIScriptGeneric* gen) {
-    new (gen->GetAddressOfReturnLocation()) Mat4(Mat4::ortho(
-        gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2),
-        gen->GetArgFloat(3), gen->GetArgFloat(4), gen->GetArgFloat(5)));
+static Mat4 Mat4_Ortho(float left, float right, float bottom, float top, float nearVal, float farVal) {
+    return Mat4::ortho(left, right, bottom, top, nearVal, farVal);
 }
-static void Mat4_Perspective(asIScriptGeneric* gen) {
-    new (gen->GetAddressOfReturnLocation()) Mat4(Mat4::perspective(
-        gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2), gen->GetArgFloat(3)));
+static Mat4 Mat4_Perspective(float fovY, float aspect, float nearVal, float farVal) {
+    return Mat4::perspective(fovY, aspect, nearVal, farVal);
 }
 
 // =============================================================================
 // Quaternion value type wrappers
 // =============================================================================
-static void Quaternion_Construct(asIScriptGeneric* gen) {
-    new (gen->GetAddressOfReturnLocation()) Quaternion();
+static void Quaternion_Construct(Quaternion* self) {
+    new (self) Quaternion();
 }
-static void Quaternion_Construct_4f(asIScriptGeneric* gen) {
-    new (gen->GetAddressOfReturnLocation()) Quaternion(
-        gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2), gen->GetArgFloat(3));
+static void Quaternion_Construct_4f(Quaternion* self, float w, float x, float y, float z) {
+    new (self) Quaternion(w, x, y, z);
 }
-static void Quaternion_CopyConstruct(asIScriptGeneric* gen) {
-    Quaternion* other = static_cast<Quaternion*>(gen->GetArgObject(0));
-    new (gen->GetAddressOfReturnLocation()) Quaternion(*other);
+static void Quaternion_CopyConstruct(Quaternion* self, const Quaternion& other) {
+    new (self) Quaternion(other);
 }
-static void Quaternion_OpMul(asIScriptGeneric* gen) {
-    Quaternion* self = static_cast<Quaternion*>(gen->GetObject());
-    Quaternion* other = static_cast<Quaternion*>(gen->GetArgObject(0));
-    new (gen->GetAddressOfReturnLocation()) Quaternion(*self * *other);
+static Quaternion Quaternion_OpMul(Quaternion* self, const Quaternion& other) {
+    return *self * other;
 }
-static void Quaternion_Rotate(asIScriptGeneric* gen) {
-    Quaternion* self = static_cast<Quaternion*>(gen->GetObject());
-    Vec3* v = static_cast<Vec3*>(gen->GetArgObject(0));
-    new (gen->GetAddressOfReturnLocation()) Vec3(self->rotate(*v));
+static Vec3 Quaternion_Rotate(Quaternion* self, const Vec3& v) {
+    return self->rotate(v);
 }
-static void Quaternion_ToEuler(asIScriptGeneric* gen) {
-    Quaternion* self = static_cast<Quaternion*>(gen->GetObject());
-    new (gen->GetAddressOfReturnLocation()) Vec3(self->toEuler());
+static Vec3 Quaternion_ToEuler(Quaternion* self) {
+    return self->toEuler();
 }
-static void Quaternion_ToMatrix(asIScriptGeneric* gen) {
-    Quaternion* self = static_cast<Quaternion*>(gen->GetObject());
-    new (gen->GetAddressOfReturnLocation()) Mat4(self->toMatrix());
+static Mat4 Quaternion_ToMatrix(Quaternion* self) {
+    return self->toMatrix();
 }
-static void Quaternion_Normalized(asIScriptGeneric* gen) {
-    Quaternion* self = static_cast<Quaternion*>(gen->GetObject());
-    new (gen->GetAddressOfReturnLocation()) Quaternion(self->normalized());
+static Quaternion Quaternion_Normalized(Quaternion* self) {
+    return self->normalized();
 }
-static void Quaternion_Length(asIScriptGeneric* gen) {
-    Quaternion* self = static_cast<Quaternion*>(gen->GetObject());
-    gen->SetReturnFloat(self->length());
+static float Quaternion_Length(Quaternion* self) {
+    return self->length();
 }
-static void Quaternion_Conjugate(asIScriptGeneric* gen) {
-    Quaternion* self = static_cast<Quaternion*>(gen->GetObject());
-    new (gen->GetAddressOfReturnLocation()) Quaternion(self->conjugate());
+static Quaternion Quaternion_Conjugate(Quaternion* self) {
+    return self->conjugate();
 }
 // Static factory functions for Quaternion
-static void Quaternion_Identity(asIScriptGeneric* gen) {
-    new (gen->GetAddressOfReturnLocation()) Quaternion(Quaternion::identity());
+static Quaternion Quaternion_Identity() {
+    return Quaternion::identity();
 }
-static void Quaternion_FromAxisAngle(asIScriptGeneric* gen) {
-    Vec3* axis = static_cast<Vec3*>(gen->GetArgObject(0));
-    float radians = gen->GetArgFloat(1);
-    new (gen->GetAddressOfReturnLocation()) Quaternion(Quaternion::fromAxisAngle(*axis, radians));
+static Quaternion Quaternion_FromAxisAngle(const Vec3& axis, float radians) {
+    return Quaternion::fromAxisAngle(axis, radians);
 }
-static void Quaternion_FromEuler_3f(asIScriptGeneric* gen) {
-    new (gen->GetAddressOfReturnLocation()) Quaternion(Quaternion::fromEuler(
-        gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2)));
+static Quaternion Quaternion_FromEuler_3f(float x, float y, float z) {
+    return Quaternion::fromEuler(x, y, z);
 }
-static void Quaternion_FromEuler_Vec3(asIScriptGeneric* gen) {
-    Vec3* euler = static_cast<Vec3*>(gen->GetArgObject(0));
-    new (gen->GetAddressOfReturnLocation()) Quaternion(Quaternion::fromEuler(*euler));
+static Quaternion Quaternion_FromEuler_Vec3(const Vec3& euler) {
+    return Quaternion::fromEuler(euler);
 }
-static void Quaternion_Slerp(asIScriptGeneric* gen) {
-    Quaternion* a = static_cast<Quaternion*>(gen->GetArgObject(0));
-    Quaternion* b = static_cast<Quaternion*>(gen->GetArgObject(1));
-    float t = gen->GetArgFloat(2);
-    new (gen->GetAddressOfReturnLocation()) Quaternion(Quaternion::slerp(*a, *b, t));
+static Quaternion Quaternion_Slerp(const Quaternion& a, const Quaternion& b, float t) {
+    return Quaternion::slerp(a, b, t);
 }
 
 // =============================================================================
 // Window functions
 // =============================================================================
-static void as_setWindowTitle(asIScriptGeneric* gen) {
-    string* title = static_cast<string*>(gen->GetArgObject(0));
-    setWindowTitle(*title);
+static void as_setWindowTitle(const string& title) {
+    setWindowTitle(title);
 }
-static void as_setWindowSize(asIScriptGeneric* gen) {
-    setWindowSize(gen->GetArgDWord(0), gen->GetArgDWord(1));
+static void as_setWindowSize(int width, int height) {
+    setWindowSize(width, height);
 }
-static void as_getWindowSize(asIScriptGeneric* gen) {
-    new (gen->GetAddressOfReturnLocation()) Vec2(getWindowSize());
+static Vec2 as_getWindowSize() {
+    return getWindowSize();
 }
-static void as_getMousePos(asIScriptGeneric* gen) {
-    new (gen->GetAddressOfReturnLocation()) Vec2(getMousePos());
+static Vec2 as_getMousePos() {
+    return getMousePos();
 }
-static void as_getGlobalMousePos(asIScriptGeneric* gen) {
-    new (gen->GetAddressOfReturnLocation()) Vec2(getGlobalMousePos());
+static Vec2 as_getGlobalMousePos() {
+    return getGlobalMousePos();
 }
 
 // Transform matrix functions
-static void as_getCurrentMatrix(asIScriptGeneric* gen) {
-    new (gen->GetAddressOfReturnLocation()) Mat4(getCurrentMatrix());
+static Mat4 as_getCurrentMatrix() {
+    return getCurrentMatrix();
 }
-static void as_setMatrix(asIScriptGeneric* gen) {
-    Mat4* mat = static_cast<Mat4*>(gen->GetArgObject(0));
-    setMatrix(*mat);
+static void as_setMatrix(const Mat4& mat) {
+    setMatrix(mat);
 }
 
 // Text alignment functions
-static void as_setTextAlign(asIScriptGeneric* gen) {
-    int h = gen->GetArgDWord(0);
-    int v = gen->GetArgDWord(1);
+static void as_setTextAlign(int h, int v) {
     setTextAlign(static_cast<Direction>(h), static_cast<Direction>(v));
 }
-static void as_getTextAlignH(asIScriptGeneric* gen) {
-    gen->SetReturnDWord(static_cast<int>(getTextAlignH()));
+static int as_getTextAlignH() {
+    return static_cast<int>(getTextAlignH());
 }
-static void as_getTextAlignV(asIScriptGeneric* gen) {
-    gen->SetReturnDWord(static_cast<int>(getTextAlignV()));
+static int as_getTextAlignV() {
+    return static_cast<int>(getTextAlignV());
 }
-static void as_getBitmapFontHeight(asIScriptGeneric* gen) {
-    gen->SetReturnFloat(getBitmapFontHeight());
+static float as_getBitmapFontHeight() {
+    return getBitmapFontHeight();
 }
-static void as_getBitmapStringWidth(asIScriptGeneric* gen) {
-    string* text = static_cast<string*>(gen->GetArgObject(0));
-    gen->SetReturnFloat(getBitmapStringWidth(*text));
+static float as_getBitmapStringWidth(const string& text) {
+    return getBitmapStringWidth(text);
 }
-static void as_getBitmapStringHeight(asIScriptGeneric* gen) {
-    string* text = static_cast<string*>(gen->GetArgObject(0));
-    gen->SetReturnFloat(getBitmapStringHeight(*text));
+static float as_getBitmapStringHeight(const string& text) {
+    return getBitmapStringHeight(text);
 }
-static void as_getBitmapStringBBox(asIScriptGeneric* gen) {
-    string* text = static_cast<string*>(gen->GetArgObject(0));
-    new (gen->GetAddressOfReturnLocation()) Rect(getBitmapStringBBox(*text));
+static Rect as_getBitmapStringBBox(const string& text) {
+    return getBitmapStringBBox(text);
 }
 
 // Graphics advanced functions
@@ -970,53 +1383,38 @@ static void as_drawTexture_5f(asIScriptGeneric* gen) {
     tex->draw(gen->GetArgFloat(1), gen->GetArgFloat(2), gen->GetArgFloat(3), gen->GetArgFloat(4));
 }
 static void as_createBox_1f(asIScriptGeneric* gen) {
-    g_meshes.push_back(make_unique<Mesh>(createBox(gen->GetArgFloat(0))));
-    gen->SetReturnObject(g_meshes.back().get());
+    gen->SetReturnAddress(ScriptObject<Mesh>::create(createBox(gen->GetArgFloat(0))));
 }
 static void as_createBox_3f(asIScriptGeneric* gen) {
-    g_meshes.push_back(make_unique<Mesh>(createBox(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2))));
-    gen->SetReturnObject(g_meshes.back().get());
+    gen->SetReturnAddress(ScriptObject<Mesh>::create(createBox(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2))));
 }
 static void as_createSphere_1f(asIScriptGeneric* gen) {
-    g_meshes.push_back(make_unique<Mesh>(createSphere(gen->GetArgFloat(0))));
-    gen->SetReturnObject(g_meshes.back().get());
+    gen->SetReturnAddress(ScriptObject<Mesh>::create(createSphere(gen->GetArgFloat(0))));
 }
 static void as_createSphere_2(asIScriptGeneric* gen) {
-    g_meshes.push_back(make_unique<Mesh>(createSphere(gen->GetArgFloat(0), gen->GetArgDWord(1))));
-    gen->SetReturnObject(g_meshes.back().get());
-}
-
-// Vec2 static factory functions
-static void Vec2_FromAngle_1f(asIScriptGeneric* gen) {
-    new (gen->GetAddressOfReturnLocation()) Vec2(Vec2::fromAngle(gen->GetArgFloat(0)));
-}
-static void Vec2_FromAngle_2f(asIScriptGeneric* gen) {
-    new (gen->GetAddressOfReturnLocation()) Vec2(Vec2::fromAngle(gen->GetArgFloat(0), gen->GetArgFloat(1)));
+    gen->SetReturnAddress(ScriptObject<Mesh>::create(createSphere(gen->GetArgFloat(0), gen->GetArgDWord(1))));
 }
 
 // Color static factory functions
-static void Color_FromHex_1u(asIScriptGeneric* gen) {
-    new (gen->GetAddressOfReturnLocation()) Color(Color::fromHex(gen->GetArgDWord(0)));
+static Color Color_FromHex_1u(unsigned int hex) {
+    return Color::fromHex(hex);
 }
-static void Color_FromHex_1u1b(asIScriptGeneric* gen) {
-    new (gen->GetAddressOfReturnLocation()) Color(Color::fromHex(gen->GetArgDWord(0), gen->GetArgByte(1) != 0));
+static Color Color_FromHex_1u1b(unsigned int hex, bool hasAlpha) {
+    return Color::fromHex(hex, hasAlpha);
 }
-static void Color_FromBytes_3i(asIScriptGeneric* gen) {
-    new (gen->GetAddressOfReturnLocation()) Color(Color::fromBytes(gen->GetArgDWord(0), gen->GetArgDWord(1), gen->GetArgDWord(2)));
+static Color Color_FromBytes_3i(int r, int g, int b) {
+    return Color::fromBytes(r, g, b);
 }
-static void Color_FromBytes_4i(asIScriptGeneric* gen) {
-    new (gen->GetAddressOfReturnLocation()) Color(Color::fromBytes(gen->GetArgDWord(0), gen->GetArgDWord(1), gen->GetArgDWord(2), gen->GetArgDWord(3)));
+static Color Color_FromBytes_4i(int r, int g, int b, int a) {
+    return Color::fromBytes(r, g, b, a);
 }
 
 // =============================================================================
 // Texture type for AngelScript (reference type)
 // =============================================================================
 static void Texture_Factory(asIScriptGeneric* gen) {
-    g_textures.push_back(make_unique<Texture>());
-    gen->SetReturnObject(g_textures.back().get());
+    gen->SetReturnAddress(ScriptObject<Texture>::create());
 }
-static void Texture_AddRef(asIScriptGeneric*) { /* no-op, managed by global container */ }
-static void Texture_Release(asIScriptGeneric*) { /* no-op, cleaned up on script reload */ }
 
 static void Texture_Allocate_2i(asIScriptGeneric* gen) {
     Texture* self = static_cast<Texture*>(gen->GetObject());
@@ -1059,17 +1457,44 @@ static void Texture_LoadData(asIScriptGeneric* gen) {
     Texture* self = static_cast<Texture*>(gen->GetObject());
     Pixels* pixels = static_cast<Pixels*>(gen->GetArgObject(0));
     self->loadData(*pixels);
+    tcUploadStats::add(pixelBytes(*pixels), pixelBytes(*pixels));
+}
+// Upload after the script changed only 'rect' of the pixels: just that part
+// is sent where the backend allows it. Nothing is sent if the rect lies
+// outside the pixels.
+static void Texture_LoadData_Rect(asIScriptGeneric* gen) {
+    Texture* self = static_cast<Texture*>(gen->GetObject());
+    Pixels* pixels = static_cast<Pixels*>(gen->GetArgObject(0));
+    Rect* rect = static_cast<Rect*>(gen->GetArgObject(1));
+    if (!pixels) {
+        asGetActiveContext()->SetException("Texture.loadData() called with null pixels");
+        return;
+    }
+    if (!pixels->isAllocated()) return;
+
+    tcDirtyRegion region;
+    region.add(static_cast<int>(std::floor(rect->x)), static_cast<int>(std::floor(rect->y)),
+        static_cast<int>(std::ceil(rect->width)), static_cast<int>(std::ceil(rect->height)),
+        pixels->getWidth(), pixels->getHeight());
+    if (region.empty()) {
+        tcUploadStats::skipped++;
+        return;
+    }
+    size_t dirty = static_cast<size_t>(region.area()) * pixels->getChannels();
+    if (region.upload(*self, *pixels)) {
+        tcUploadStats::add(dirty, dirty);
+        return;
+    }
+    self->loadData(*pixels);
+    tcUploadStats::add(pixelBytes(*pixels), dirty);
 }
 
 // =============================================================================
 // Fbo type for AngelScript (reference type)
 // =============================================================================
 static void Fbo_Factory(asIScriptGeneric* gen) {
-    g_fbos.push_back(make_unique<Fbo>());
-    gen->SetReturnObject(g_fbos.back().get());
+    gen->SetReturnAddress(ScriptObject<Fbo>::create());
 }
-static void Fbo_AddRef(asIScriptGeneric*) { /* no-op */ }
-static void Fbo_Release(asIScriptGeneric*) { /* no-op */ }
 
 static void Fbo_Allocate_2i(asIScriptGeneric* gen) {
     Fbo* self = static_cast<Fbo*>(gen->GetObject());
@@ -1089,7 +1514,7 @@ static void Fbo_End(asIScriptGeneric* gen) {
 }
 static void Fbo_GetTexture(asIScriptGeneric* gen) {
     Fbo* self = static_cast<Fbo*>(gen->GetObject());
-    gen->SetReturnObject(&self->getTexture());
+    gen->SetReturnObject(BorrowedRefs<Texture>::borrow(&self->getTexture(), self));
 }
 static void Fbo_GetWidth(asIScriptGeneric* gen) {
     Fbo* self = static_cast<Fbo*>(gen->GetObject());
@@ -1112,15 +1537,164 @@ static void Fbo_Draw_4f(asIScriptGeneric* gen) {
     self->draw(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2), gen->GetArgFloat(3));
 }
 
+// =============================================================================
+// FloatBuffer type for AngelScript (reference type)
+// =============================================================================
+static void FloatBuffer_Factory(asIScriptGeneric* gen) {
+    gen->SetReturnAddress(ScriptObject<tcFloatBuffer>::create());
+}
+static void FloatBuffer_Factory_1i(asIScriptGeneric* gen) {
+    int size = static_cast<int>(gen->GetArgDWord(0));
+    if (size < 0) {
+        asGetActiveContext()->SetException("createFloatBuffer() called with a negative size");
+        return;
+    }
+    gen->SetReturnAddress(ScriptObject<tcFloatBuffer>::create(static_cast<size_t>(size)));
+}
+
+// Reads the offset / stride pair starting at argument `arg`
+static bool FloatBuffer_Range(asIScriptGeneric* gen, int arg, size_t& offset, size_t& stride) {
+    int o = static_cast<int>(gen->GetArgDWord(arg));
+    int s = static_cast<int>(gen->GetArgDWord(arg + 1));
+    if (o < 0 || s < 1) {
+        asGetActiveContext()->SetException("FloatBuffer: offset must be >= 0 and stride >= 1");
+        return false;
+    }
+    offset = static_cast<size_t>(o);
+    stride = static_cast<size_t>(s);
+    return true;
+}
+
+// Reads a FloatBuffer@ argument
+static tcFloatBuffer* FloatBuffer_Arg(asIScriptGeneric* gen, int arg) {
+    tcFloatBuffer* other = static_cast<tcFloatBuffer*>(gen->GetArgObject(arg));
+    if (!other) asGetActiveContext()->SetException("FloatBuffer: null buffer argument");
+    return other;
+}
+
+static void FloatBuffer_Resize(asIScriptGeneric* gen) {
+    tcFloatBuffer* self = static_cast<tcFloatBuffer*>(gen->GetObject());
+    int size = static_cast<int>(gen->GetArgDWord(0));
+    if (size < 0) {
+        asGetActiveContext()->SetException("FloatBuffer.resize() called with a negative size");
+        return;
+    }
+    self->resize(static_cast<size_t>(size));
+}
+static void FloatBuffer_Size(asIScriptGeneric* gen) {
+    tcFloatBuffer* self = static_cast<tcFloatBuffer*>(gen->GetObject());
+    gen->SetReturnDWord(static_cast<asDWORD>(self->size()));
+}
+static void FloatBuffer_Index(asIScriptGeneric* gen) {
+    tcFloatBuffer* self = static_cast<tcFloatBuffer*>(gen->GetObject());
+    asUINT i = gen->GetArgDWord(0);
+    if (i >= self->size()) {
+        asGetActiveContext()->SetException("FloatBuffer index out of range");
+        return;
+    }
+    gen->SetReturnAddress(&(*self)[i]);
+}
+static void FloatBuffer_Fill(asIScriptGeneric* gen) {
+    tcFloatBuffer* self = static_cast<tcFloatBuffer*>(gen->GetObject());
+    size_t offset, stride;
+    if (FloatBuffer_Range(gen, 1, offset, stride)) self->fill(gen->GetArgFloat(0), offset, stride);
+}
+static void FloatBuffer_Add_Value(asIScriptGeneric* gen) {
+    tcFloatBuffer* self = static_cast<tcFloatBuffer*>(gen->GetObject());
+    size_t offset, stride;
+    if (FloatBuffer_Range(gen, 1, offset, stride)) self->add(gen->GetArgFloat(0), offset, stride);
+}
+static void FloatBuffer_Mul_Value(asIScriptGeneric* gen) {
+    tcFloatBuffer* self = static_cast<tcFloatBuffer*>(gen->GetObject());
+    size_t offset, stride;
+    if (FloatBuffer_Range(gen, 1, offset, stride)) self->mul(gen->GetArgFloat(0), offset, stride);
+}
+static void FloatBuffer_Clamp(asIScriptGeneric* gen) {
+    tcFloatBuffer* self = static_cast<tcFloatBuffer*>(gen->GetObject());
+    size_t offset, stride;
+    if (FloatBuffer_Range(gen, 2, offset, stride)) self->clamp(gen->GetArgFloat(0), gen->GetArgFloat(1), offset, stride);
+}
+static void FloatBuffer_Sin(asIScriptGeneric* gen) {
+    tcFloatBuffer* self = static_cast<tcFloatBuffer*>(gen->GetObject());
+    size_t offset, stride;
+    if (FloatBuffer_Range(gen, 0, offset, stride)) self->sin(offset, stride);
+}
+static void FloatBuffer_Cos(asIScriptGeneric* gen) {
+    tcFloatBuffer* self = static_cast<tcFloatBuffer*>(gen->GetObject());
+    size_t offset, stride;
+    if (FloatBuffer_Range(gen, 0, offset, stride)) self->cos(offset, stride);
+}
+static void FloatBuffer_Add_Buffer(asIScriptGeneric* gen) {
+    tcFloatBuffer* self = static_cast<tcFloatBuffer*>(gen->GetObject());
+    tcFloatBuffer* other = FloatBuffer_Arg(gen, 0);
+    size_t offset, stride;
+    if (other && FloatBuffer_Range(gen, 1, offset, stride)) self->add(*other, offset, stride);
+}
+static void FloatBuffer_Mul_Buffer(asIScriptGeneric* gen) {
+    tcFloatBuffer* self = static_cast<tcFloatBuffer*>(gen->GetObject());
+    tcFloatBuffer* other = FloatBuffer_Arg(gen, 0);
+    size_t offset, stride;
+    if (other && FloatBuffer_Range(gen, 1, offset, stride)) self->mul(*other, offset, stride);
+}
+static void FloatBuffer_Fma(asIScriptGeneric* gen) {
+    tcFloatBuffer* self = static_cast<tcFloatBuffer*>(gen->GetObject());
+    tcFloatBuffer* other = FloatBuffer_Arg(gen, 0);
+    size_t offset, stride;
+    if (other && FloatBuffer_Range(gen, 2, offset, stride)) self->fma(*other, gen->GetArgFloat(1), offset, stride);
+}
+static void FloatBuffer_Lerp(asIScriptGeneric* gen) {
+    tcFloatBuffer* self = static_cast<tcFloatBuffer*>(gen->GetObject());
+    tcFloatBuffer* other = FloatBuffer_Arg(gen, 0);
+    size_t offset, stride;
+    if (other && FloatBuffer_Range(gen, 2, offset, stride)) self->lerp(*other, gen->GetArgFloat(1), offset, stride);
+}
+static void FloatBuffer_FillRandom(asIScriptGeneric* gen) {
+    tcFloatBuffer* self = static_cast<tcFloatBuffer*>(gen->GetObject());
+    size_t offset, stride;
+    if (FloatBuffer_Range(gen, 2, offset, stride)) self->fillRandom(gen->GetArgFloat(0), gen->GetArgFloat(1), offset, stride);
+}
+static void FloatBuffer_FillNoise(asIScriptGeneric* gen) {
+    tcFloatBuffer* self = static_cast<tcFloatBuffer*>(gen->GetObject());
+    size_t offset, stride;
+    if (FloatBuffer_Range(gen, 3, offset, stride)) {
+        self->fillNoise(gen->GetArgFloat(0), gen->GetArgFloat(1), gen->GetArgFloat(2), offset, stride);
+    }
+}
+static void FloatBuffer_CopyFrom(asIScriptGeneric* gen) {
+    tcFloatBuffer* self = static_cast<tcFloatBuffer*>(gen->GetObject());
+    tcFloatBuffer* src = FloatBuffer_Arg(gen, 0);
+    size_t srcOffset, srcStride, offset, stride;
+    if (src && FloatBuffer_Range(gen, 1, srcOffset, srcStride) && FloatBuffer_Range(gen, 3, offset, stride)) {
+        self->copyFrom(*src, srcOffset, srcStride, offset, stride);
+    }
+}
+static void FloatBuffer_FromArray(asIScriptGeneric* gen) {
+    tcFloatBuffer* self = static_cast<tcFloatBuffer*>(gen->GetObject());
+    CScriptArray* arr = static_cast<CScriptArray*>(gen->GetArgObject(0));
+    if (!arr) {
+        asGetActiveContext()->SetException("FloatBuffer.fromArray() called with a null array");
+        return;
+    }
+    self->resize(arr->GetSize());
+    if (arr->GetSize() > 0) std::memcpy(self->data(), arr->GetBuffer(), arr->GetSize() * sizeof(float));
+}
+static void FloatBuffer_ToArray(asIScriptGeneric* gen) {
+    tcFloatBuffer* self = static_cast<tcFloatBuffer*>(gen->GetObject());
+    asITypeInfo* type = gen->GetEngine()->GetTypeInfoByDecl("array<float>");
+    CScriptArray* arr = CScriptArray::Create(type, static_cast<asUINT>(self->size()));
+    if (self->size() > 0) std::memcpy(arr->GetBuffer(), self->data(), self->size() * sizeof(float));
+    gen->SetReturnAddress(arr);
+}
+
 // =============================================================================
 // Mesh type for AngelScript (reference type)
 // =============================================================================
 static void Mesh_Factory(asIScriptGeneric* gen) {
-    g_meshes.push_back(make_unique<Mesh>());
-    gen->SetReturnObject(g_meshes.back().get());
+    gen->SetReturnAddress(ScriptObject<Mesh>::create());
+}
+static void Mesh_TempFactory(asIScriptGeneric* gen) {
+    gen->SetReturnObject(FramePool<Mesh>::acquire());
 }
-static void Mesh_AddRef(asIScriptGeneric*) { /* no-op */ }
-static void Mesh_Release(asIScriptGeneric*) { /* no-op */ }
 
 static void Mesh_SetMode(asIScriptGeneric* gen) {
     Mesh* self = static_cast<Mesh*>(gen->GetObject());
@@ -1300,6 +1874,22 @@ static void Mesh_AddVertices_Vec2Array(asIScriptGeneric* gen) {
     }
     gen->SetReturnObject(self);
 }
+static void Mesh_AddVertices_Buffer(asIScriptGeneric* gen) {
+    Mesh* self = static_cast<Mesh*>(gen->GetObject());
+    tcFloatBuffer* buffer = FloatBuffer_Arg(gen, 0);
+    int components = static_cast<int>(gen->GetArgDWord(1));
+    if (!buffer) return;
+    if (components != 2 && components != 3) {
+        asGetActiveContext()->SetException("Mesh.addVertices() expects 2 or 3 components per vertex");
+        return;
+    }
+    const float* v = buffer->data();
+    size_t count = buffer->size() / components;
+    for (size_t i = 0; i < count; i++, v += components) {
+        self->addVertex(v[0], v[1], components == 3 ? v[2] : 0.0f);
+    }
+    gen->SetReturnObject(self);
+}
 static void Mesh_AddColors_Array(asIScriptGeneric* gen) {
     Mesh* self = static_cast<Mesh*>(gen->GetObject());
     CScriptArray* arr = static_cast<CScriptArray*>(gen->GetArgObject(0));
@@ -1332,11 +1922,11 @@ static void Mesh_AddNormals_Array(asIScriptGeneric* gen) {
 // Path (Polyline) type for AngelScript (reference type)
 // =============================================================================
 static void Path_Factory(asIScriptGeneric* gen) {
-    g_paths.push_back(make_unique<Path>());
-    gen->SetReturnObject(g_paths.back().get());
+    gen->SetReturnAddress(ScriptObject<Path>::create());
+}
+static void Path_TempFactory(asIScriptGeneric* gen) {
+    gen->SetReturnObject(FramePool<Path>::acquire());
 }
-static void Path_AddRef(asIScriptGeneric*) { /* no-op */ }
-static void Path_Release(asIScriptGeneric*) { /* no-op */ }
 
 static void Path_AddVertex_2f(asIScriptGeneric* gen) {
     Path* self = static_cast<Path*>(gen->GetObject());
@@ -1464,11 +2054,8 @@ static void Path_AddVertices_Vec2Array(asIScriptGeneric* gen) {
 // StrokeMesh type for AngelScript (reference type)
 // =============================================================================
 static void StrokeMesh_Factory(asIScriptGeneric* gen) {
-    g_strokeMeshes.push_back(make_unique<StrokeMesh>());
-    gen->SetReturnObject(g_strokeMeshes.back().get());
+    gen->SetReturnAddress(ScriptObject<StrokeMesh>::create());
 }
-static void StrokeMesh_AddRef(asIScriptGeneric*) { /* no-op */ }
-static void StrokeMesh_Release(asIScriptGeneric*) { /* no-op */ }
 
 static void StrokeMesh_SetWidth(asIScriptGeneric* gen) {
     StrokeMesh* self = static_cast<StrokeMesh*>(gen->GetObject());
@@ -1551,78 +2138,352 @@ static void StrokeMesh_Draw(asIScriptGeneric* gen) {
 }
 
 // =============================================================================
-// Image type for AngelScript (reference type)
+// DisplayList type for AngelScript (reference type)
 // =============================================================================
-static void Image_Factory(asIScriptGeneric* gen) {
-    g_images.push_back(make_unique<Image>());
-    gen->SetReturnObject(g_images.back().get());
+static void DisplayList_Factory(asIScriptGeneric* gen) {
+    gen->SetReturnAddress(ScriptObject<tcDisplayList>::create());
 }
-static void Image_AddRef(asIScriptGeneric*) { /* no-op */ }
-static void Image_Release(asIScriptGeneric*) { /* no-op */ }
-
-static void Image_Load(asIScriptGeneric* gen) {
-    Image* self = static_cast<Image*>(gen->GetObject());
-    string* path = static_cast<string*>(gen->GetArgObject(0));
-    gen->SetReturnByte(self->load(*path) ? 1 : 0);
+static void DisplayList_Begin(asIScriptGeneric* gen) {
+    tcDisplayList* self = static_cast<tcDisplayList*>(gen->GetObject());
+    self->begin();
 }
-static void Image_Save(asIScriptGeneric* gen) {
-    Image* self = static_cast<Image*>(gen->GetObject());
-    string* path = static_cast<string*>(gen->GetArgObject(0));
-    gen->SetReturnByte(self->save(*path) ? 1 : 0);
+static void DisplayList_End(asIScriptGeneric* gen) {
+    tcDisplayList* self = static_cast<tcDisplayList*>(gen->GetObject());
+    self->end();
 }
-static void Image_Allocate_2i(asIScriptGeneric* gen) {
-    Image* self = static_cast<Image*>(gen->GetObject());
-    self->allocate(gen->GetArgDWord(0), gen->GetArgDWord(1));
+static void DisplayList_IsRecording(asIScriptGeneric* gen) {
+    tcDisplayList* self = static_cast<tcDisplayList*>(gen->GetObject());
+    gen->SetReturnByte(self->isRecording());
 }
-static void Image_Allocate_3i(asIScriptGeneric* gen) {
-    Image* self = static_cast<Image*>(gen->GetObject());
-    self->allocate(gen->GetArgDWord(0), gen->GetArgDWord(1), gen->GetArgDWord(2));
+static void DisplayList_Draw(asIScriptGeneric* gen) {
+    tcDisplayList* self = static_cast<tcDisplayList*>(gen->GetObject());
+    self->draw();
 }
-static void Image_Clear(asIScriptGeneric* gen) {
-    Image* self = static_cast<Image*>(gen->GetObject());
+static void DisplayList_Clear(asIScriptGeneric* gen) {
+    tcDisplayList* self = static_cast<tcDisplayList*>(gen->GetObject());
     self->clear();
 }
-static void Image_IsAllocated(asIScriptGeneric* gen) {
-    Image* self = static_cast<Image*>(gen->GetObject());
-    gen->SetReturnByte(self->isAllocated() ? 1 : 0);
+static void DisplayList_Size(asIScriptGeneric* gen) {
+    tcDisplayList* self = static_cast<tcDisplayList*>(gen->GetObject());
+    gen->SetReturnDWord(static_cast<asDWORD>(self->size()));
 }
-static void Image_GetWidth(asIScriptGeneric* gen) {
-    Image* self = static_cast<Image*>(gen->GetObject());
-    gen->SetReturnDWord(self->getWidth());
+static void DisplayList_Bake(asIScriptGeneric* gen) {
+    tcDisplayList* self = static_cast<tcDisplayList*>(gen->GetObject());
+    gen->SetReturnByte(self->bake());
 }
-static void Image_GetHeight(asIScriptGeneric* gen) {
-    Image* self = static_cast<Image*>(gen->GetObject());
-    gen->SetReturnDWord(self->getHeight());
+static void DisplayList_IsBaked(asIScriptGeneric* gen) {
+    tcDisplayList* self = static_cast<tcDisplayList*>(gen->GetObject());
+    gen->SetReturnByte(self->isBaked());
 }
-static void Image_GetChannels(asIScriptGeneric* gen) {
-    Image* self = static_cast<Image*>(gen->GetObject());
-    gen->SetReturnDWord(self->getChannels());
+
+// =============================================================================
+// ParticleSystem type for AngelScript (reference type)
+// =============================================================================
+// ParticleSystem is GC-tracked (its hooks can close a cycle), so every new
+// system is handed to the garbage collector
+static void notifyParticleSystemGC(asIScriptGeneric* gen, tcParticleSystem* system) {
+    asIScriptEngine* engine = gen->GetEngine();
+    engine->NotifyGarbageCollectorOfNewObject(system, engine->GetTypeInfoByName("ParticleSystem"));
+}
+static void ParticleSystem_Factory(asIScriptGeneric* gen) {
+    tcParticleSystem* system = ScriptObject<tcParticleSystem>::create();
+    notifyParticleSystemGC(gen, system);
+    gen->SetReturnAddress(system);
+}
+static void ParticleSystem_Factory_1i(asIScriptGeneric* gen) {
+    int max = static_cast<int>(gen->GetArgDWord(0));
+    tcParticleSystem* system = ScriptObject<tcParticleSystem>::create(static_cast<size_t>(std::max(max, 0)));
+    notifyParticleSystemGC(gen, system);
+    gen->SetReturnAddress(system);
+}
+
+static void trackParticleHooks(tcParticleSystem* system) {
+    if (std::find(g_hookedParticles.begin(), g_hookedParticles.end(), system) == g_hookedParticles.end()) {
+        g_hookedParticles.push_back(system);
+    }
 }
-static void Image_GetPixels(asIScriptGeneric* gen) {
-    Image* self = static_cast<Image*>(gen->GetObject());
-    gen->SetReturnObject(&self->getPixels());
+static void ParticleSystem_Destroyed(tcParticleSystem* self) {
+    g_hookedParticles.erase(std::remove(g_hookedParticles.begin(), g_hookedParticles.end(), self), g_hookedParticles.end());
 }
-static void Image_GetColor(asIScriptGeneric* gen) {
-    Image* self = static_cast<Image*>(gen->GetObject());
-    Color c = self->getColor(gen->GetArgDWord(0), gen->GetArgDWord(1));
+
+// A ParticleBatchFunc handle as a hook; holds a reference to the function
+struct ScriptParticleHook {
+    std::shared_ptr<asIScriptFunction> func;
+
+    void operator()(tcParticleSystem& system, size_t first, size_t count) const {
+        callNested(func.get(), [&](asIScriptContext* ctx) {
+            ctx->SetArgObject(0, &system);
+            ctx->SetArgDWord(1, static_cast<asDWORD>(first));
+            ctx->SetArgDWord(2, static_cast<asDWORD>(count));
+        });
+    }
+};
+
+static tcParticleSystem::BatchHook particleHook(asIScriptFunction* func) {
+    if (!func) return nullptr;
+    func->AddRef();
+    return ScriptParticleHook{std::shared_ptr<asIScriptFunction>(func, [](asIScriptFunction* f) { f->Release(); })};
+}
+
+// Garbage collector behaviours: the hooks are the only script references
+static void ParticleSystem_GetRefCount(asIScriptGeneric* gen) {
+    tcParticleSystem* self = static_cast<tcParticleSystem*>(gen->GetObject());
+    gen->SetReturnDWord(static_cast<asDWORD>(ScriptObject<tcParticleSystem>::refCount(self)));
+}
+static void ParticleSystem_SetGCFlag(asIScriptGeneric* gen) {
+    ScriptObject<tcParticleSystem>::setGCFlag(static_cast<tcParticleSystem*>(gen->GetObject()));
+}
+static void ParticleSystem_GetGCFlag(asIScriptGeneric* gen) {
+    tcParticleSystem* self = static_cast<tcParticleSystem*>(gen->GetObject());
+    gen->SetReturnByte(ScriptObject<tcParticleSystem>::gcFlag(self) ? 1 : 0);
+}
+static void ParticleSystem_EnumRefs(asIScriptGeneric* gen) {
+    tcParticleSystem* self = static_cast<tcParticleSystem*>(gen->GetObject());
+    asIScriptEngine* engine = *static_cast<asIScriptEngine**>(gen->GetAddressOfArg(0));
+    for (const tcParticleSystem::BatchHook* hook : {&self->getEmitHook(), &self->getUpdateHook()}) {
+        if (const ScriptParticleHook* scriptHook = hook->target<ScriptParticleHook>()) {
+            engine->GCEnumCallback(scriptHook->func.get());
+        }
+    }
+}
+static void ParticleSystem_ReleaseRefs(asIScriptGeneric* gen) {
+    tcParticleSystem* self = static_cast<tcParticleSystem*>(gen->GetObject());
+    self->setEmitHook(nullptr);
+    self->setUpdateHook(nullptr);
+}
+
+static void ParticleSystem_Emit(asIScriptGeneric* gen) {
+    tcParticleSystem* self = static_cast<tcParticleSystem*>(gen->GetObject());
+    int count = static_cast<int>(gen->GetArgDWord(0));
+    size_t emitted = count > 0 ? self->emit(static_cast<size_t>(count), gen->GetArgFloat(1), gen->GetArgFloat(2)) : 0;
+    gen->SetReturnDWord(static_cast<asDWORD>(emitted));
+}
+static void ParticleSystem_Update(asIScriptGeneric* gen) {
+    tcParticleSystem* self = static_cast<tcParticleSystem*>(gen->GetObject());
+    self->update(gen->GetArgFloat(0));
+}
+static void ParticleSystem_Draw(asIScriptGeneric* gen) {
+    tcParticleSystem* self = static_cast<tcParticleSystem*>(gen->GetObject());
+    self->draw();
+}
+static void ParticleSystem_Clear(asIScriptGeneric* gen) {
+    tcParticleSystem* self = static_cast<tcParticleSystem*>(gen->GetObject());
+    self->clear();
+}
+static void ParticleSystem_Size(asIScriptGeneric* gen) {
+    tcParticleSystem* self = static_cast<tcParticleSystem*>(gen->GetObject());
+    gen->SetReturnDWord(static_cast<asDWORD>(self->size()));
+}
+static void ParticleSystem_SetMaxParticles(asIScriptGeneric* gen) {
+    tcParticleSystem* self = static_cast<tcParticleSystem*>(gen->GetObject());
+    int max = static_cast<int>(gen->GetArgDWord(0));
+    self->setMaxParticles(static_cast<size_t>(std::max(max, 0)));
+}
+static void ParticleSystem_GetMaxParticles(asIScriptGeneric* gen) {
+    tcParticleSystem* self = static_cast<tcParticleSystem*>(gen->GetObject());
+    gen->SetReturnDWord(static_cast<asDWORD>(self->getMaxParticles()));
+}
+static void ParticleSystem_SetSpeed(asIScriptGeneric* gen) {
+    tcParticleSystem* self = static_cast<tcParticleSystem*>(gen->GetObject());
+    self->setSpeed(gen->GetArgFloat(0), gen->GetArgFloat(1));
+}
+static void ParticleSystem_SetDirection(asIScriptGeneric* gen) {
+    tcParticleSystem* self = static_cast<tcParticleSystem*>(gen->GetObject());
+    self->setDirection(gen->GetArgFloat(0), gen->GetArgFloat(1));
+}
+static void ParticleSystem_SetLife(asIScriptGeneric* gen) {
+    tcParticleSystem* self = static_cast<tcParticleSystem*>(gen->GetObject());
+    self->setLife(gen->GetArgFloat(0), gen->GetArgFloat(1));
+}
+static void ParticleSystem_SetSize(asIScriptGeneric* gen) {
+    tcParticleSystem* self = static_cast<tcParticleSystem*>(gen->GetObject());
+    self->setSize(gen->GetArgFloat(0), gen->GetArgFloat(1));
+}
+static void ParticleSystem_SetColor(asIScriptGeneric* gen) {
+    tcParticleSystem* self = static_cast<tcParticleSystem*>(gen->GetObject());
+    self->setColor(*static_cast<Color*>(gen->GetArgObject(0)));
+}
+static void ParticleSystem_SetGravity(asIScriptGeneric* gen) {
+    tcParticleSystem* self = static_cast<tcParticleSystem*>(gen->GetObject());
+    self->setGravity(gen->GetArgFloat(0), gen->GetArgFloat(1));
+}
+static void ParticleSystem_SetDrag(asIScriptGeneric* gen) {
+    tcParticleSystem* self = static_cast<tcParticleSystem*>(gen->GetObject());
+    self->setDrag(gen->GetArgFloat(0));
+}
+static void ParticleSystem_SetNoiseForce(asIScriptGeneric* gen) {
+    tcParticleSystem* self = static_cast<tcParticleSystem*>(gen->GetObject());
+    self->setNoiseForce(gen->GetArgFloat(0), gen->GetArgFloat(1));
+}
+static void ParticleSystem_SetFadeOut(asIScriptGeneric* gen) {
+    tcParticleSystem* self = static_cast<tcParticleSystem*>(gen->GetObject());
+    self->setFadeOut(gen->GetArgByte(0) != 0);
+}
+static void ParticleSystem_SetResolution(asIScriptGeneric* gen) {
+    tcParticleSystem* self = static_cast<tcParticleSystem*>(gen->GetObject());
+    self->setResolution(static_cast<int>(gen->GetArgDWord(0)));
+}
+static void ParticleSystem_GetColumn(asIScriptGeneric* gen) {
+    tcParticleSystem* self = static_cast<tcParticleSystem*>(gen->GetObject());
+    int column = static_cast<int>(gen->GetArgDWord(0));
+    if (column < 0 || column >= tcParticleSystem::ColumnCount) {
+        asGetActiveContext()->SetException("ParticleSystem.getColumn() called with an invalid column");
+        return;
+    }
+    tcFloatBuffer* buffer = &self->column(static_cast<tcParticleSystem::Column>(column));
+    gen->SetReturnObject(BorrowedRefs<tcFloatBuffer>::borrow(buffer, self));
+}
+static void ParticleSystem_SetOnEmit(asIScriptGeneric* gen) {
+    tcParticleSystem* self = static_cast<tcParticleSystem*>(gen->GetObject());
+    asIScriptFunction* func = static_cast<asIScriptFunction*>(gen->GetArgObject(0));
+    if (func) trackParticleHooks(self);
+    self->setEmitHook(particleHook(func));
+}
+static void ParticleSystem_SetOnUpdate(asIScriptGeneric* gen) {
+    tcParticleSystem* self = static_cast<tcParticleSystem*>(gen->GetObject());
+    asIScriptFunction* func = static_cast<asIScriptFunction*>(gen->GetArgObject(0));
+    if (func) trackParticleHooks(self);
+    self->setUpdateHook(particleHook(func));
+}
+
+// =============================================================================
+// Image type for AngelScript (reference type)
+// =============================================================================
+
+// Pixels changed since each Image's last upload
+static std::unordered_map<const Image*, tcDirtyRegion> g_imageDirty;
+
+static void Image_MarkAllDirty(Image* self) {
+    g_imageDirty[self].addAll(self->getWidth(), self->getHeight());
+}
+
+static void Image_Factory(asIScriptGeneric* gen) {
+    gen->SetReturnAddress(ScriptObject<Image>::create());
+}
+static void Image_Destroyed(Image* self) {
+    g_imageDirty.erase(self);
+}
+
+// Copies decoded pixels in and uploads them
+static void Image_SetFromPixels(Image& image, const Pixels& pixels) {
+    image.allocate(pixels.getWidth(), pixels.getHeight(), pixels.getChannels());
+    std::memcpy(image.getPixels().getData(), pixels.getData(), pixelBytes(pixels));
+    image.update();
+    g_imageDirty.erase(&image);
+}
+static void Image_Load(asIScriptGeneric* gen) {
+    Image* self = static_cast<Image*>(gen->GetObject());
+    string* path = static_cast<string*>(gen->GetArgObject(0));
+    Pixels pixels;
+    bool loaded = loadCachedPixels(assetCache(gen), *path, pixels);
+    if (loaded) Image_SetFromPixels(*self, pixels);
+    gen->SetReturnByte(loaded ? 1 : 0);
+}
+// Decodes on a worker; the pixels are copied in and uploaded on the main thread
+static void Image_LoadAsync(asIScriptGeneric* gen) {
+    Image* self = static_cast<Image*>(gen->GetObject());
+    string path = *static_cast<string*>(gen->GetArgObject(0));
+    tcAssetCache* cache = &assetCache(gen);
+    auto cached = cache->find<Pixels>("pixels", path);
+    startAsyncLoad<Image, Pixels>(gen, self, static_cast<asIScriptFunction*>(gen->GetArgObject(1)),
+        [path, cached](Pixels& pixels) {
+            if (!cached) return pixels.load(path);
+            pixels = *cached;
+            return true;
+        },
+        [path, cached, cache](Image& image, Pixels& pixels) {
+            if (!cached) cache->store("pixels", path, 0, pixels, pixelBytes(pixels));
+            Image_SetFromPixels(image, pixels);
+            return true;
+        });
+}
+static void Image_IsLoading(asIScriptGeneric* gen) {
+    gen->SetReturnByte(isLoading(gen->GetObject()) ? 1 : 0);
+}
+static void Image_Save(asIScriptGeneric* gen) {
+    Image* self = static_cast<Image*>(gen->GetObject());
+    string* path = static_cast<string*>(gen->GetArgObject(0));
+    gen->SetReturnByte(self->save(*path) ? 1 : 0);
+}
+static void Image_Allocate_2i(asIScriptGeneric* gen) {
+    Image* self = static_cast<Image*>(gen->GetObject());
+    self->allocate(gen->GetArgDWord(0), gen->GetArgDWord(1));
+    Image_MarkAllDirty(self);
+}
+static void Image_Allocate_3i(asIScriptGeneric* gen) {
+    Image* self = static_cast<Image*>(gen->GetObject());
+    self->allocate(gen->GetArgDWord(0), gen->GetArgDWord(1), gen->GetArgDWord(2));
+    Image_MarkAllDirty(self);
+}
+static void Image_Clear(asIScriptGeneric* gen) {
+    Image* self = static_cast<Image*>(gen->GetObject());
+    self->clear();
+    g_imageDirty.erase(self);
+}
+static void Image_IsAllocated(asIScriptGeneric* gen) {
+    Image* self = static_cast<Image*>(gen->GetObject());
+    gen->SetReturnByte(self->isAllocated() ? 1 : 0);
+}
+static void Image_GetWidth(asIScriptGeneric* gen) {
+    Image* self = static_cast<Image*>(gen->GetObject());
+    gen->SetReturnDWord(self->getWidth());
+}
+static void Image_GetHeight(asIScriptGeneric* gen) {
+    Image* self = static_cast<Image*>(gen->GetObject());
+    gen->SetReturnDWord(self->getHeight());
+}
+static void Image_GetChannels(asIScriptGeneric* gen) {
+    Image* self = static_cast<Image*>(gen->GetObject());
+    gen->SetReturnDWord(self->getChannels());
+}
+// The script may change anything through the handle, so the whole image is
+// dirty (and stays so while the handle is held - see Image_Update)
+static void Image_GetPixels(asIScriptGeneric* gen) {
+    Image* self = static_cast<Image*>(gen->GetObject());
+    Image_MarkAllDirty(self);
+    gen->SetReturnObject(BorrowedRefs<Pixels>::borrow(&self->getPixels(), self));
+}
+static void Image_GetColor(asIScriptGeneric* gen) {
+    Image* self = static_cast<Image*>(gen->GetObject());
+    Color c = self->getColor(gen->GetArgDWord(0), gen->GetArgDWord(1));
     new(gen->GetAddressOfReturnLocation()) Color(c);
 }
 static void Image_SetColor(asIScriptGeneric* gen) {
     Image* self = static_cast<Image*>(gen->GetObject());
     Color* c = static_cast<Color*>(gen->GetArgObject(2));
-    self->setColor(gen->GetArgDWord(0), gen->GetArgDWord(1), *c);
+    int x = static_cast<int>(gen->GetArgDWord(0));
+    int y = static_cast<int>(gen->GetArgDWord(1));
+    self->setColor(x, y, *c);
+    g_imageDirty[self].add(x, y, 1, 1, self->getWidth(), self->getHeight());
 }
+// Uploads only if pixels changed since the last upload, and only the changed
+// boxes where the backend allows it
 static void Image_Update(asIScriptGeneric* gen) {
     Image* self = static_cast<Image*>(gen->GetObject());
-    self->update();
+    const Pixels& pixels = self->getPixels();
+    tcDirtyRegion& region = g_imageDirty[self];
+    if (BorrowedRefs<Pixels>::isBorrowed(&pixels)) region.addAll(self->getWidth(), self->getHeight());
+    if (region.empty()) {
+        tcUploadStats::skipped++;
+        return;
+    }
+    size_t dirty = static_cast<size_t>(region.area()) * pixels.getChannels();
+    if (region.upload(self->getTexture(), pixels)) {
+        tcUploadStats::add(dirty, dirty);
+    } else {
+        self->update();
+        tcUploadStats::add(pixelBytes(pixels), dirty);
+    }
+    region.clear();
 }
 static void Image_SetDirty(asIScriptGeneric* gen) {
     Image* self = static_cast<Image*>(gen->GetObject());
     self->setDirty();
+    Image_MarkAllDirty(self);
 }
 static void Image_GetTexture(asIScriptGeneric* gen) {
     Image* self = static_cast<Image*>(gen->GetObject());
-    gen->SetReturnObject(&self->getTexture());
+    gen->SetReturnObject(BorrowedRefs<Texture>::borrow(&self->getTexture(), self));
 }
 static void Image_Draw_0(asIScriptGeneric* gen) {
     Image* self = static_cast<Image*>(gen->GetObject());
@@ -1641,11 +2502,8 @@ static void Image_Draw_4f(asIScriptGeneric* gen) {
 // EasyCam type for AngelScript (reference type)
 // =============================================================================
 static void EasyCam_Factory(asIScriptGeneric* gen) {
-    g_easyCams.push_back(make_unique<EasyCam>());
-    gen->SetReturnObject(g_easyCams.back().get());
+    gen->SetReturnAddress(ScriptObject<EasyCam>::create());
 }
-static void EasyCam_AddRef(asIScriptGeneric*) { /* no-op */ }
-static void EasyCam_Release(asIScriptGeneric*) { /* no-op */ }
 
 static void EasyCam_Begin(asIScriptGeneric* gen) {
     EasyCam* self = static_cast<EasyCam*>(gen->GetObject());
@@ -1751,11 +2609,8 @@ static void EasyCam_SetPanSensitivity(asIScriptGeneric* gen) {
 // Pixels type for AngelScript (reference type)
 // =============================================================================
 static void Pixels_Factory(asIScriptGeneric* gen) {
-    g_pixels.push_back(make_unique<Pixels>());
-    gen->SetReturnObject(g_pixels.back().get());
+    gen->SetReturnAddress(ScriptObject<Pixels>::create());
 }
-static void Pixels_AddRef(asIScriptGeneric*) { /* no-op */ }
-static void Pixels_Release(asIScriptGeneric*) { /* no-op */ }
 
 static void Pixels_Allocate_2i(asIScriptGeneric* gen) {
     Pixels* self = static_cast<Pixels*>(gen->GetObject());
@@ -1778,7 +2633,27 @@ static void Pixels_SetColor(asIScriptGeneric* gen) {
 static void Pixels_Load(asIScriptGeneric* gen) {
     Pixels* self = static_cast<Pixels*>(gen->GetObject());
     string* path = static_cast<string*>(gen->GetArgObject(0));
-    gen->SetReturnByte(self->load(*path) ? 1 : 0);
+    gen->SetReturnByte(loadCachedPixels(assetCache(gen), *path, *self) ? 1 : 0);
+}
+static void Pixels_LoadAsync(asIScriptGeneric* gen) {
+    Pixels* self = static_cast<Pixels*>(gen->GetObject());
+    string path = *static_cast<string*>(gen->GetArgObject(0));
+    tcAssetCache* cache = &assetCache(gen);
+    auto cached = cache->find<Pixels>("pixels", path);
+    startAsyncLoad<Pixels, Pixels>(gen, self, static_cast<asIScriptFunction*>(gen->GetArgObject(1)),
+        [path, cached](Pixels& pixels) {
+            if (!cached) return pixels.load(path);
+            pixels = *cached;
+            return true;
+        },
+        [path, cached, cache](Pixels& target, Pixels& pixels) {
+            if (!cached) cache->store("pixels", path, 0, pixels, pixelBytes(pixels));
+            target = std::move(pixels);
+            return true;
+        });
+}
+static void Pixels_IsLoading(asIScriptGeneric* gen) {
+    gen->SetReturnByte(isLoading(gen->GetObject()) ? 1 : 0);
 }
 static void Pixels_GetWidth(asIScriptGeneric* gen) {
     Pixels* self = static_cast<Pixels*>(gen->GetObject());
@@ -1792,35 +2667,182 @@ static void Pixels_IsAllocated(asIScriptGeneric* gen) {
     Pixels* self = static_cast<Pixels*>(gen->GetObject());
     gen->SetReturnByte(self->isAllocated() ? 1 : 0);
 }
+// Channel values as 0-1 floats, interleaved like the pixel data
+static void Pixels_FromFloatBuffer(asIScriptGeneric* gen) {
+    Pixels* self = static_cast<Pixels*>(gen->GetObject());
+    tcFloatBuffer* buffer = FloatBuffer_Arg(gen, 0);
+    if (!buffer || !self->isAllocated()) return;
+    size_t n = std::min(buffer->size(), static_cast<size_t>(self->getWidth()) * self->getHeight() * self->getChannels());
+    const float* src = buffer->data();
+    unsigned char* dst = self->getData();
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = static_cast<unsigned char>(std::min(std::max(src[i], 0.0f), 1.0f) * 255.0f + 0.5f);
+    }
+}
+static void Pixels_ToFloatBuffer(asIScriptGeneric* gen) {
+    Pixels* self = static_cast<Pixels*>(gen->GetObject());
+    tcFloatBuffer* buffer = FloatBuffer_Arg(gen, 0);
+    if (!buffer) return;
+    size_t n = self->isAllocated() ? static_cast<size_t>(self->getWidth()) * self->getHeight() * self->getChannels() : 0;
+    buffer->resize(n);
+    const unsigned char* src = self->getData();
+    float* dst = buffer->data();
+    for (size_t i = 0; i < n; i++) dst[i] = src[i] * (1.0f / 255.0f);
+}
 static void Pixels_Save(asIScriptGeneric* gen) {
     Pixels* self = static_cast<Pixels*>(gen->GetObject());
     string* path = static_cast<string*>(gen->GetArgObject(0));
     gen->SetReturnByte(self->save(*path) ? 1 : 0);
 }
+static void Pixels_GetChannels(asIScriptGeneric* gen) {
+    Pixels* self = static_cast<Pixels*>(gen->GetObject());
+    gen->SetReturnDWord(self->getChannels());
+}
+static void Pixels_GetData(asIScriptGeneric* gen) {
+    Pixels* self = static_cast<Pixels*>(gen->GetObject());
+    size_t size = pixelBytes(*self);
+    asITypeInfo* type = gen->GetEngine()->GetTypeInfoByDecl("array<uint8>");
+    CScriptArray* arr = CScriptArray::Create(type, static_cast<asUINT>(size));
+    if (size > 0) std::memcpy(arr->GetBuffer(), self->getData(), size);
+    gen->SetReturnAddress(arr);
+}
+static void Pixels_SetData(asIScriptGeneric* gen) {
+    Pixels* self = static_cast<Pixels*>(gen->GetObject());
+    CScriptArray* arr = static_cast<CScriptArray*>(gen->GetArgObject(0));
+    if (!arr) {
+        asGetActiveContext()->SetException("Pixels.setData() called with a null array");
+        return;
+    }
+    size_t size = std::min(pixelBytes(*self), static_cast<size_t>(arr->GetSize()));
+    if (size > 0) std::memcpy(self->getData(), arr->GetBuffer(), size);
+}
+static void Pixels_Fill(asIScriptGeneric* gen) {
+    Pixels* self = static_cast<Pixels*>(gen->GetObject());
+    tcpixels::fill(*self, *static_cast<Color*>(gen->GetArgObject(0)));
+}
+// Calls the script once per row with the row as 0-1 floats (interleaved
+// channels); the row is written back after each call
+static void Pixels_Map(asIScriptGeneric* gen) {
+    Pixels* self = static_cast<Pixels*>(gen->GetObject());
+    asIScriptFunction* func = static_cast<asIScriptFunction*>(gen->GetArgObject(0));
+    if (!func) {
+        asGetActiveContext()->SetException("Pixels.map() called with a null function");
+        return;
+    }
+    if (!self->isAllocated()) return;
+
+    size_t rowBytes = static_cast<size_t>(self->getWidth()) * self->getChannels();
+    tcFloatBuffer* row = ScriptObject<tcFloatBuffer>::create(rowBytes);
+    for (int y = 0; y < self->getHeight(); y++) {
+        unsigned char* bytes = self->getData() + y * rowBytes;
+        row->resize(rowBytes);  // in case the script resized it
+        float* values = row->data();
+        for (size_t i = 0; i < rowBytes; i++) values[i] = bytes[i] * (1.0f / 255.0f);
+        bool finished = callNested(func, [&](asIScriptContext* ctx) {
+            ctx->SetArgObject(0, row);
+            ctx->SetArgDWord(1, static_cast<asDWORD>(y));
+        });
+        if (!finished) break;
+        size_t n = std::min(rowBytes, row->size());
+        values = row->data();
+        for (size_t i = 0; i < n; i++) bytes[i] = static_cast<unsigned char>(std::min(std::max(values[i], 0.0f), 1.0f) * 255.0f + 0.5f);
+    }
+    ScriptObject<tcFloatBuffer>::release(row);
+}
+static void Pixels_Blur(asIScriptGeneric* gen) {
+    Pixels* self = static_cast<Pixels*>(gen->GetObject());
+    tcpixels::blur(*self, static_cast<int>(gen->GetArgDWord(0)));
+}
+static void Pixels_Threshold(asIScriptGeneric* gen) {
+    Pixels* self = static_cast<Pixels*>(gen->GetObject());
+    tcpixels::threshold(*self, gen->GetArgFloat(0));
+}
+static void Pixels_Convolve(asIScriptGeneric* gen) {
+    Pixels* self = static_cast<Pixels*>(gen->GetObject());
+    CScriptArray* kernel = static_cast<CScriptArray*>(gen->GetArgObject(0));
+    asUINT size = kernel ? kernel->GetSize() : 0;
+    int side = static_cast<int>(std::lround(std::sqrt(static_cast<double>(size))));
+    if (size == 0 || static_cast<asUINT>(side * side) != size || side % 2 == 0) {
+        asGetActiveContext()->SetException("Pixels.convolve() expects a 3x3, 5x5, ... kernel");
+        return;
+    }
+    tcpixels::convolve(*self, static_cast<const float*>(kernel->GetBuffer()), side);
+}
+static void Pixels_Blend(asIScriptGeneric* gen) {
+    Pixels* self = static_cast<Pixels*>(gen->GetObject());
+    Pixels* src = static_cast<Pixels*>(gen->GetArgObject(0));
+    if (!src) {
+        asGetActiveContext()->SetException("Pixels.blend() called with null pixels");
+        return;
+    }
+    if (src->getWidth() != self->getWidth() || src->getHeight() != self->getHeight() ||
+        src->getChannels() != self->getChannels()) {
+        asGetActiveContext()->SetException("Pixels.blend() needs pixels of the same size and channel count");
+        return;
+    }
+    tcpixels::blend(*self, *src, static_cast<tcpixels::Blend>(gen->GetArgDWord(1)), gen->GetArgFloat(2));
+}
 
 // =============================================================================
 // Sound type for AngelScript (reference type)
 // =============================================================================
 static void Sound_Factory(asIScriptGeneric* gen) {
-    g_sounds.push_back(make_unique<Sound>());
-    gen->SetReturnObject(g_sounds.back().get());
+    gen->SetReturnAddress(ScriptObject<Sound>::create());
 }
-static void Sound_AddRef(asIScriptGeneric*) { /* no-op */ }
-static void Sound_Release(asIScriptGeneric*) { /* no-op */ }
 
 static void Sound_Load(asIScriptGeneric* gen) {
     Sound* self = static_cast<Sound*>(gen->GetObject());
     string* path = static_cast<string*>(gen->GetArgObject(0));
-    gen->SetReturnByte(self->load(*path) ? 1 : 0);
+    tcAssetCache& cache = assetCache(gen);
+    if (auto cached = cache.find<Sound>("sound", *path)) {
+        self->stop();
+        *self = *cached;
+        gen->SetReturnByte(1);
+        return;
+    }
+    bool loaded = self->load(*path);
+    if (loaded) cache.store("sound", *path, 0, *self, soundBytes(*self));
+    gen->SetReturnByte(loaded ? 1 : 0);
+}
+// Sound.play(), also used for Sequencer sound events
+static void playSound(Sound* sound) {
+    if (isLoading(sound)) {
+        playWhenReady(sound);
+        return;
+    }
+    sound->play();
+    keepPlayingSound(sound);
 }
 static void Sound_Play(asIScriptGeneric* gen) {
-    Sound* self = static_cast<Sound*>(gen->GetObject());
-    self->play();
+    playSound(static_cast<Sound*>(gen->GetObject()));
 }
 static void Sound_Stop(asIScriptGeneric* gen) {
     Sound* self = static_cast<Sound*>(gen->GetObject());
+    cancelPlayWhenReady(self);
     self->stop();
 }
+static void Sound_LoadAsync(asIScriptGeneric* gen) {
+    Sound* self = static_cast<Sound*>(gen->GetObject());
+    string path = *static_cast<string*>(gen->GetArgObject(0));
+    tcAssetCache* cache = &assetCache(gen);
+    auto cached = cache->find<Sound>("sound", path);
+    startAsyncLoad<Sound, Sound>(gen, self, static_cast<asIScriptFunction*>(gen->GetArgObject(1)),
+        [path, cached](Sound& sound) {
+            if (!cached) return sound.load(path);
+            sound = *cached;
+            return true;
+        },
+        [path, cached, cache](Sound& target, Sound& sound) {
+            if (!cached) cache->store("sound", path, 0, sound, soundBytes(sound));
+            target.stop();
+            target = std::move(sound);
+            soundReady(&target);
+            return true;
+        });
+}
+static void Sound_IsLoading(asIScriptGeneric* gen) {
+    gen->SetReturnByte(isLoading(gen->GetObject()) ? 1 : 0);
+}
 static void Sound_IsLoaded(asIScriptGeneric* gen) {
     Sound* self = static_cast<Sound*>(gen->GetObject());
     gen->SetReturnByte(self->isLoaded() ? 1 : 0);
@@ -1864,6 +2886,7 @@ static void Sound_Pause(asIScriptGeneric* gen) {
 static void Sound_Resume(asIScriptGeneric* gen) {
     Sound* self = static_cast<Sound*>(gen->GetObject());
     self->resume();
+    keepPlayingSound(self);
 }
 static void Sound_IsPaused(asIScriptGeneric* gen) {
     Sound* self = static_cast<Sound*>(gen->GetObject());
@@ -1890,6 +2913,93 @@ static const int kWaveNoise = static_cast<int>(Wave::Noise);
 static const int kWavePinkNoise = static_cast<int>(Wave::PinkNoise);
 static const int kWaveSilent = static_cast<int>(Wave::Silent);
 
+// Built sounds are memoized in the asset cache by a hash of everything that
+// shapes the waveform. A miss is synthesized on a loader thread: build()
+// returns the Sound at once and it fills in before the next update() (play()
+// called before then starts it when it is ready).
+constexpr uint64_t kChipHashSeed = 14695981039346656037ull;  // FNV-1a 64-bit
+
+static void hashChipValue(uint64_t& h, const void* data, size_t size) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+}
+static void hashChipFloat(uint64_t& h, float v) {
+    hashChipValue(h, &v, sizeof(v));
+}
+static void hashChipNote(uint64_t& h, const ChipSoundNote& note) {
+    int wave = static_cast<int>(note.wave);
+    hashChipValue(h, &wave, sizeof(wave));
+    for (float v : {note.hz, note.volume, note.duration, note.attack, note.decay, note.sustain, note.release}) {
+        hashChipFloat(h, v);
+    }
+}
+
+// Running hash of each bundle's add() calls (its volume is added at build())
+static std::unordered_map<const ChipSoundBundle*, uint64_t> g_bundleHashes;
+
+// Builds in flight, by hash. Sounds returned by a build() of the same hash
+// meanwhile wait here and get a copy of the result instead of starting
+// another synthesis.
+static std::unordered_map<uint64_t, vector<Sound*>> g_chipBuilds;
+
+// 'built' is null if the build never ran (cancelled before it started)
+static void finishChipBuild(uint64_t hash, const Sound* built) {
+    auto it = g_chipBuilds.find(hash);
+    if (it == g_chipBuilds.end()) return;
+    vector<Sound*> waiting = std::move(it->second);
+    g_chipBuilds.erase(it);
+    for (Sound* sound : waiting) {
+        if (--g_pendingLoads[sound] == 0) g_pendingLoads.erase(sound);
+        if (built) {
+            *sound = *built;
+            soundReady(sound);
+        } else {
+            cancelPlayWhenReady(sound);
+        }
+        ScriptObject<Sound>::release(sound);
+    }
+}
+// After tcAsyncLoader::cancelAll(): builds it skipped never finish
+static void dropChipBuilds() {
+    while (!g_chipBuilds.empty()) finishChipBuild(g_chipBuilds.begin()->first, nullptr);
+}
+
+template<typename Source>
+static void buildChipSound(asIScriptGeneric* gen, const Source& source, uint64_t hash) {
+    tcAssetCache* cache = &assetCache(gen);
+    if (auto cached = cache->find<Sound>("chip", hash)) {
+        gen->SetReturnAddress(ScriptObject<Sound>::create(*cached));
+        return;
+    }
+    auto pending = g_chipBuilds.find(hash);
+    if (pending != g_chipBuilds.end()) {
+        Sound* sound = ScriptObject<Sound>::create();
+        ScriptObject<Sound>::addRef(sound);     // held until the build finishes
+        g_pendingLoads[sound]++;                // isLoading(), play() before ready
+        pending->second.push_back(sound);
+        gen->SetReturnAddress(sound);
+        return;
+    }
+    g_chipBuilds[hash];
+    Sound* sound = ScriptObject<Sound>::create();
+    startAsyncLoad<Sound, Sound>(gen, sound, nullptr,
+        [source](Sound& built) {
+            built = source.build();
+            return true;
+        },
+        [hash, cache](Sound& target, Sound& built) {
+            cache->store("chip", hash, built, soundBytes(built));
+            finishChipBuild(hash, &built);
+            target = std::move(built);
+            soundReady(&target);
+            return true;
+        });
+    gen->SetReturnAddress(sound);
+}
+
 static void ChipNote_Construct(asIScriptGeneric* gen) {
     ChipSoundNote* note = new(gen->GetObject()) ChipSoundNote();
     note->wave = Wave::Square;
@@ -1913,8 +3023,9 @@ static void ChipNote_Destruct(asIScriptGeneric* gen) {
 }
 static void ChipNote_Build(asIScriptGeneric* gen) {
     ChipSoundNote* self = static_cast<ChipSoundNote*>(gen->GetObject());
-    g_sounds.push_back(make_unique<Sound>(self->build()));
-    gen->SetReturnObject(g_sounds.back().get());
+    uint64_t hash = kChipHashSeed;
+    hashChipNote(hash, *self);
+    buildChipSound(gen, *self, hash);
 }
 static void ChipNote_SetWave(asIScriptGeneric* gen) {
     ChipSoundNote* self = static_cast<ChipSoundNote*>(gen->GetObject());
@@ -1969,17 +3080,23 @@ static void ChipNote_SetADSR(asIScriptGeneric* gen) {
 // ChipSoundBundle type for AngelScript (reference type)
 // =============================================================================
 static void ChipBundle_Factory(asIScriptGeneric* gen) {
-    g_chipBundles.push_back(make_unique<ChipSoundBundle>());
-    gen->SetReturnObject(g_chipBundles.back().get());
+    ChipSoundBundle* bundle = ScriptObject<ChipSoundBundle>::create();
+    g_bundleHashes[bundle] = kChipHashSeed;
+    gen->SetReturnAddress(bundle);
+}
+static void ChipBundle_Release(ChipSoundBundle* self) {
+    if (ScriptObject<ChipSoundBundle>::refCount(self) == 1) g_bundleHashes.erase(self);
+    tcscript::scriptRelease(self);
 }
-static void ChipBundle_AddRef(asIScriptGeneric*) { /* no-op */ }
-static void ChipBundle_Release(asIScriptGeneric*) { /* no-op */ }
 
 static void ChipBundle_Add(asIScriptGeneric* gen) {
     ChipSoundBundle* self = static_cast<ChipSoundBundle*>(gen->GetObject());
     ChipSoundNote* note = static_cast<ChipSoundNote*>(gen->GetArgObject(0));
     float time = gen->GetArgFloat(1);
     self->add(*note, time);
+    uint64_t& hash = g_bundleHashes[self];
+    hashChipNote(hash, *note);
+    hashChipFloat(hash, time);
     gen->SetReturnObject(self);
 }
 static void ChipBundle_Add_5(asIScriptGeneric* gen) {
@@ -1990,11 +3107,15 @@ static void ChipBundle_Add_5(asIScriptGeneric* gen) {
     float time = gen->GetArgFloat(3);
     float vol = gen->GetArgFloat(4);
     self->add(static_cast<Wave>(w), hz, dur, time, vol);
+    uint64_t& hash = g_bundleHashes[self];
+    hashChipNote(hash, ChipSoundNote(static_cast<Wave>(w), hz, dur, vol));
+    hashChipFloat(hash, time);
     gen->SetReturnObject(self);
 }
 static void ChipBundle_Clear(asIScriptGeneric* gen) {
     ChipSoundBundle* self = static_cast<ChipSoundBundle*>(gen->GetObject());
     self->clear();
+    g_bundleHashes[self] = kChipHashSeed;
 }
 static void ChipBundle_GetDuration(asIScriptGeneric* gen) {
     ChipSoundBundle* self = static_cast<ChipSoundBundle*>(gen->GetObject());
@@ -2007,33 +3128,184 @@ static void ChipBundle_SetVolume(asIScriptGeneric* gen) {
 }
 static void ChipBundle_Build(asIScriptGeneric* gen) {
     ChipSoundBundle* self = static_cast<ChipSoundBundle*>(gen->GetObject());
-    g_sounds.push_back(make_unique<Sound>(self->build()));
-    gen->SetReturnObject(g_sounds.back().get());
+    uint64_t hash = g_bundleHashes[self];
+    hashChipFloat(hash, self->volume);
+    buildChipSound(gen, *self, hash);
+}
+
+// =============================================================================
+// ChipSynth type for AngelScript (reference type, see tcChipSynth.h)
+// =============================================================================
+static void ChipSynth_Factory(asIScriptGeneric* gen) {
+    int voices = gen->GetArgDWord(0);
+    if (voices < 1 || voices > tcChipSynth::kMaxVoices) {
+        asGetActiveContext()->SetException("createChipSynth() voice count must be 1 to 64");
+        return;
+    }
+    if (!tcAudioOutput::start()) {
+        asGetActiveContext()->SetException("createChipSynth() has no audio output on this platform");
+        return;
+    }
+    gen->SetReturnAddress(ScriptObject<tcChipSynth>::create(voices));
+}
+static void ChipSynth_Play(asIScriptGeneric* gen) {
+    tcChipSynth* self = static_cast<tcChipSynth*>(gen->GetObject());
+    ChipSoundNote* note = static_cast<ChipSoundNote*>(gen->GetArgObject(0));
+    gen->SetReturnByte(self->play(*note, gen->GetArgFloat(1)));
+}
+static void ChipSynth_StopAll(asIScriptGeneric* gen) {
+    tcChipSynth* self = static_cast<tcChipSynth*>(gen->GetObject());
+    self->stopAll();
+}
+static void ChipSynth_SetVolume(asIScriptGeneric* gen) {
+    tcChipSynth* self = static_cast<tcChipSynth*>(gen->GetObject());
+    self->setVolume(gen->GetArgFloat(0));
+}
+static void ChipSynth_GetVolume(asIScriptGeneric* gen) {
+    tcChipSynth* self = static_cast<tcChipSynth*>(gen->GetObject());
+    gen->SetReturnFloat(self->getVolume());
+}
+static void ChipSynth_GetVoiceCount(asIScriptGeneric* gen) {
+    tcChipSynth* self = static_cast<tcChipSynth*>(gen->GetObject());
+    gen->SetReturnDWord(self->getVoiceCount());
+}
+static void ChipSynth_GetActiveVoices(asIScriptGeneric* gen) {
+    tcChipSynth* self = static_cast<tcChipSynth*>(gen->GetObject());
+    gen->SetReturnDWord(self->getActiveVoices());
+}
+// Seconds of audio rendered since the synth was created
+static void ChipSynth_GetTime(asIScriptGeneric* gen) {
+    tcChipSynth* self = static_cast<tcChipSynth*>(gen->GetObject());
+    gen->SetReturnDouble(static_cast<double>(self->getFrame()) / tcChipSynth::getSampleRate());
+}
+
+// =============================================================================
+// Sequencer type for AngelScript (reference type, see tcSequencer.h)
+// =============================================================================
+// Live sequencers, advanced by the host every frame before update(). Each
+// holds a reference to its synth and to every Sound it was given.
+static vector<tcSequencer*> g_sequencers;
+
+static void updateSequencers() {
+    for (tcSequencer* sequencer : g_sequencers) sequencer->update(playSound);
+}
+
+static void Sequencer_Factory(asIScriptGeneric* gen) {
+    tcChipSynth* synth = static_cast<tcChipSynth*>(gen->GetArgObject(0));
+    if (synth) ScriptObject<tcChipSynth>::addRef(synth);
+    tcSequencer* sequencer = ScriptObject<tcSequencer>::create(synth, gen->GetArgFloat(1));
+    g_sequencers.push_back(sequencer);
+    gen->SetReturnAddress(sequencer);
+}
+static void Sequencer_ReleaseSounds(tcSequencer* self) {
+    for (const tcSequencer::Event& event : self->getEvents()) {
+        if (event.sound) ScriptObject<Sound>::release(event.sound);
+    }
+}
+static void Sequencer_Release(tcSequencer* self) {
+    if (ScriptObject<tcSequencer>::refCount(self) == 1) {
+        g_sequencers.erase(std::remove(g_sequencers.begin(), g_sequencers.end(), self), g_sequencers.end());
+        Sequencer_ReleaseSounds(self);
+        if (self->getSynth()) ScriptObject<tcChipSynth>::release(self->getSynth());
+    }
+    tcscript::scriptRelease(self);
+}
+
+static void Sequencer_Add(asIScriptGeneric* gen) {
+    tcSequencer* self = static_cast<tcSequencer*>(gen->GetObject());
+    if (!self->getSynth()) {
+        asGetActiveContext()->SetException("Sequencer.add(): notes need a sequencer created with a ChipSynth");
+        return;
+    }
+    ChipSoundNote* note = static_cast<ChipSoundNote*>(gen->GetArgObject(0));
+    self->add(*note, gen->GetArgFloat(1));
+    gen->SetReturnObject(self);
+}
+static void Sequencer_Add_5(asIScriptGeneric* gen) {
+    tcSequencer* self = static_cast<tcSequencer*>(gen->GetObject());
+    if (!self->getSynth()) {
+        asGetActiveContext()->SetException("Sequencer.add(): notes need a sequencer created with a ChipSynth");
+        return;
+    }
+    int w = gen->GetArgDWord(0);
+    float hz = gen->GetArgFloat(1);
+    float dur = gen->GetArgFloat(2);
+    float beat = gen->GetArgFloat(3);
+    float vol = gen->GetArgFloat(4);
+    self->add(ChipSoundNote(static_cast<Wave>(w), hz, dur, vol), beat);
+    gen->SetReturnObject(self);
+}
+static void Sequencer_Add_Sound(asIScriptGeneric* gen) {
+    tcSequencer* self = static_cast<tcSequencer*>(gen->GetObject());
+    Sound* sound = static_cast<Sound*>(gen->GetArgObject(0));
+    if (!sound) {
+        asGetActiveContext()->SetException("Sequencer.add(): null sound");
+        return;
+    }
+    ScriptObject<Sound>::addRef(sound);
+    self->add(sound, gen->GetArgFloat(1));
+    gen->SetReturnObject(self);
+}
+static void Sequencer_Clear(asIScriptGeneric* gen) {
+    tcSequencer* self = static_cast<tcSequencer*>(gen->GetObject());
+    Sequencer_ReleaseSounds(self);
+    self->clear();
+}
+static void Sequencer_SetBpm(asIScriptGeneric* gen) {
+    tcSequencer* self = static_cast<tcSequencer*>(gen->GetObject());
+    self->setBpm(gen->GetArgFloat(0));
+}
+static void Sequencer_GetBpm(asIScriptGeneric* gen) {
+    tcSequencer* self = static_cast<tcSequencer*>(gen->GetObject());
+    gen->SetReturnFloat(self->getBpm());
+}
+static void Sequencer_SetLoop(asIScriptGeneric* gen) {
+    tcSequencer* self = static_cast<tcSequencer*>(gen->GetObject());
+    self->setLoop(gen->GetArgFloat(0));
+}
+static void Sequencer_GetLoop(asIScriptGeneric* gen) {
+    tcSequencer* self = static_cast<tcSequencer*>(gen->GetObject());
+    gen->SetReturnFloat(self->getLoop());
+}
+static void Sequencer_SetLookahead(asIScriptGeneric* gen) {
+    tcSequencer* self = static_cast<tcSequencer*>(gen->GetObject());
+    self->setLookahead(gen->GetArgFloat(0));
+}
+static void Sequencer_GetLookahead(asIScriptGeneric* gen) {
+    tcSequencer* self = static_cast<tcSequencer*>(gen->GetObject());
+    gen->SetReturnFloat(static_cast<float>(self->getLookahead()));
+}
+static void Sequencer_Start(asIScriptGeneric* gen) {
+    tcSequencer* self = static_cast<tcSequencer*>(gen->GetObject());
+    self->start();
+}
+static void Sequencer_Stop(asIScriptGeneric* gen) {
+    tcSequencer* self = static_cast<tcSequencer*>(gen->GetObject());
+    self->stop();
+}
+static void Sequencer_IsPlaying(asIScriptGeneric* gen) {
+    tcSequencer* self = static_cast<tcSequencer*>(gen->GetObject());
+    gen->SetReturnByte(self->isPlaying());
+}
+static void Sequencer_GetBeat(asIScriptGeneric* gen) {
+    tcSequencer* self = static_cast<tcSequencer*>(gen->GetObject());
+    gen->SetReturnDouble(self->getBeat());
 }
 
 // =============================================================================
 // Easing functions
 // =============================================================================
-static void as_ease(asIScriptGeneric* gen) {
-    float t = gen->GetArgFloat(0);
-    int type = gen->GetArgDWord(1);
-    int mode = gen->GetArgDWord(2);
-    gen->SetReturnFloat(ease(t, static_cast<EaseType>(type), static_cast<EaseMode>(mode)));
+static float as_ease(float t, int type, int mode) {
+    return ease(t, static_cast<EaseType>(type), static_cast<EaseMode>(mode));
 }
-static void as_easeIn(asIScriptGeneric* gen) {
-    float t = gen->GetArgFloat(0);
-    int type = gen->GetArgDWord(1);
-    gen->SetReturnFloat(easeIn(t, static_cast<EaseType>(type)));
+static float as_easeIn(float t, int type) {
+    return easeIn(t, static_cast<EaseType>(type));
 }
-static void as_easeOut(asIScriptGeneric* gen) {
-    float t = gen->GetArgFloat(0);
-    int type = gen->GetArgDWord(1);
-    gen->SetReturnFloat(easeOut(t, static_cast<EaseType>(type)));
+static float as_easeOut(float t, int type) {
+    return easeOut(t, static_cast<EaseType>(type));
 }
-static void as_easeInOut(asIScriptGeneric* gen) {
-    float t = gen->GetArgFloat(0);
-    int type = gen->GetArgDWord(1);
-    gen->SetReturnFloat(easeInOut(t, static_cast<EaseType>(type)));
+static float as_easeInOut(float t, int type) {
+    return easeInOut(t, static_cast<EaseType>(type));
 }
 
 // =============================================================================
@@ -2041,8 +3313,7 @@ static void as_easeInOut(asIScriptGeneric* gen) {
 // =============================================================================
 
 static void TweenFloat_Factory(asIScriptGeneric* gen) {
-    g_tweens.push_back(make_unique<Tween<float>>());
-    gen->SetReturnObject(g_tweens.back().get());
+    gen->SetReturnAddress(ScriptObject<Tween<float>>::create());
 }
 static void TweenFloat_From(asIScriptGeneric* gen) {
     Tween<float>* self = static_cast<Tween<float>*>(gen->GetObject());
@@ -2138,15 +3409,50 @@ static void TweenFloat_GetEnd(asIScriptGeneric* gen) {
 // Font type for AngelScript (reference type)
 // =============================================================================
 static void Font_Factory(asIScriptGeneric* gen) {
-    g_fonts.push_back(make_unique<Font>());
-    gen->SetReturnObject(g_fonts.back().get());
+    gen->SetReturnAddress(ScriptObject<Font>::create());
 }
 
 static void Font_Load(asIScriptGeneric* gen) {
     Font* self = static_cast<Font*>(gen->GetObject());
     string* path = static_cast<string*>(gen->GetArgObject(0));
     int size = gen->GetArgDWord(1);
-    gen->SetReturnByte(self->load(*path, size) ? 1 : 0);
+    tcAssetCache& cache = assetCache(gen);
+    if (auto cached = cache.find<Font>("font", *path, size)) {
+        *self = *cached;
+        gen->SetReturnByte(1);
+        return;
+    }
+    bool loaded = self->load(*path, size);
+    if (loaded) cache.store("font", *path, size, *self, fontBytes(size));
+    gen->SetReturnByte(loaded ? 1 : 0);
+}
+// The glyph atlas is a GPU texture, so the font is built on the main thread;
+// the worker only reads the file ahead of it to warm the file cache
+static void Font_LoadAsync(asIScriptGeneric* gen) {
+    Font* self = static_cast<Font*>(gen->GetObject());
+    string path = *static_cast<string*>(gen->GetArgObject(0));
+    int size = gen->GetArgDWord(1);
+    tcAssetCache* cache = &assetCache(gen);
+    auto cached = cache->find<Font>("font", path, size);
+    startAsyncLoad<Font, string>(gen, self, static_cast<asIScriptFunction*>(gen->GetArgObject(2)),
+        [path, cached](string& bytes) {
+            if (cached) return true;
+            std::ifstream file(path, std::ios::binary);
+            bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            return true;
+        },
+        [path, size, cached, cache](Font& font, string&) {
+            if (cached) {
+                font = *cached;
+                return true;
+            }
+            if (!font.load(path, size)) return false;
+            cache->store("font", path, size, font, fontBytes(size));
+            return true;
+        });
+}
+static void Font_IsLoading(asIScriptGeneric* gen) {
+    gen->SetReturnByte(isLoading(gen->GetObject()) ? 1 : 0);
 }
 static void Font_IsLoaded(asIScriptGeneric* gen) {
     Font* self = static_cast<Font*>(gen->GetObject());
@@ -2181,6 +3487,7 @@ static void Font_GetSize(asIScriptGeneric* gen) {
 // =============================================================================
 
 tcScriptHost::tcScriptHost() {
+    tcScriptAllocator::install();  // before the first engine allocates anything
     engine_ = asCreateScriptEngine();
     if (!engine_) {
         lastError_ = "Failed to create AngelScript engine";
@@ -2188,15 +3495,25 @@ tcScriptHost::tcScriptHost() {
     }
 
     engine_->SetMessageCallback(asFUNCTION(messageCallbackStatic), this, asCALL_CDECL);
+    engine_->SetUserData(this);  // lets global functions reach the host
+    engine_->SetEngineProperty(asEP_AUTO_GARBAGE_COLLECT, false);  // see collectGarbage()
     RegisterStdString(engine_);
     RegisterScriptArray(engine_, true);  // true = register 'array<T>' as default array type
     registerTrussCFunctions();
-    ctx_ = engine_->CreateContext();
+    ctx_ = createContext();
 }
 
 tcScriptHost::~tcScriptHost() {
+    loader_.cancelAll();
+    dropChipBuilds();
+    stopCoroutines();
+    for (asIScriptContext* ctx : contextPool_) ctx->Release();
+    contextPool_.clear();
+    abortSuspended();
+    clearScriptResources();
     if (ctx_) ctx_->Release();
     if (engine_) engine_->ShutDownAndRelease();
+    tcAudioOutput::stop();
 }
 
 void tcScriptHost::registerTrussCFunctions() {
@@ -2209,158 +3526,174 @@ void tcScriptHost::registerTrussCFunctions() {
         return result;
     };
 
+    // Typed bindings: native calling convention when the library supports it,
+    // generated asCALL_GENERIC thunks otherwise (see tcScriptBind.h)
+    tcbind::Binder bind(engine_);
+
+    // Profiler categories: global functions registered after category() belong
+    // to it until the next call (methods are grouped by their object type)
+    asUINT categoryBegin = engine_->GetGlobalFunctionCount();
+    const char* currentCategory = "types";
+    auto category = [&](const char* next) {
+        for (asUINT i = categoryBegin; i < engine_->GetGlobalFunctionCount(); i++) {
+            engine_->GetGlobalFunctionByIndex(i)->SetUserData(const_cast<char*>(currentCategory), tcProfiler::kCategoryUserData);
+        }
+        categoryBegin = engine_->GetGlobalFunctionCount();
+        currentCategory = next;
+    };
+
     // =========================================================================
     // Value types: Vec2, Vec3, Color, Rect
     // =========================================================================
 
     // Vec2
-    r = engine_->RegisterObjectType("Vec2", sizeof(Vec2), asOBJ_VALUE | asOBJ_POD | asGetTypeTraits<Vec2>()); assert(r >= 0);
+    r = engine_->RegisterObjectType("Vec2", sizeof(Vec2), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_ALLFLOATS | asGetTypeTraits<Vec2>()); assert(r >= 0);
     r = engine_->RegisterObjectProperty("Vec2", "float x", offsetof(Vec2, x)); assert(r >= 0);
     r = engine_->RegisterObjectProperty("Vec2", "float y", offsetof(Vec2, y)); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("Vec2", asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(Vec2_Construct), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("Vec2", asBEHAVE_CONSTRUCT, "void f(float, float)", asFUNCTION(Vec2_Construct_2f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("Vec2", asBEHAVE_CONSTRUCT, "void f(float)", asFUNCTION(Vec2_Construct_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("Vec2", asBEHAVE_CONSTRUCT, "void f(const Vec2 &in)", asFUNCTION(Vec2_CopyConstruct), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec2", "Vec2& set(float, float)", asFUNCTION(Vec2_Set), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec2", "float length() const", asFUNCTION(Vec2_Length), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec2", "float lengthSquared() const", asFUNCTION(Vec2_LengthSquared), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec2", "Vec2& normalize()", asFUNCTION(Vec2_Normalize), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec2", "Vec2 normalized() const", asFUNCTION(Vec2_Normalized), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec2", "float dot(const Vec2 &in) const", asFUNCTION(Vec2_Dot), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec2", "float distance(const Vec2 &in) const", asFUNCTION(Vec2_Distance), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec2", "float angle() const", asFUNCTION(Vec2_Angle), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec2", "Vec2& rotate(float)", asFUNCTION(Vec2_Rotate), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec2", "Vec2 rotated(float) const", asFUNCTION(Vec2_Rotated), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec2", "Vec2 opAdd(const Vec2 &in) const", asFUNCTION(Vec2_OpAdd), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec2", "Vec2 opSub(const Vec2 &in) const", asFUNCTION(Vec2_OpSub), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec2", "Vec2 opMul(float) const", asFUNCTION(Vec2_OpMulScalar), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec2", "Vec2 opDiv(float) const", asFUNCTION(Vec2_OpDivScalar), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec2", "Vec2 opNeg() const", asFUNCTION(Vec2_OpNeg), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Vec2 Vec2_fromAngle(float)", asFUNCTION(Vec2_fromAngle_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Vec2 Vec2_fromAngle(float, float)", asFUNCTION(Vec2_fromAngle_2f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec2", "Vec2& limit(float)", asFUNCTION(Vec2_Limit), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec2", "float cross(const Vec2 &in) const", asFUNCTION(Vec2_Cross), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec2", "float distanceSquared(const Vec2 &in) const", asFUNCTION(Vec2_DistanceSquared), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec2", "Vec2 lerp(const Vec2 &in, float) const", asFUNCTION(Vec2_Lerp), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec2", "Vec2 perpendicular() const", asFUNCTION(Vec2_Perpendicular), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec2", "Vec2 reflected(const Vec2 &in) const", asFUNCTION(Vec2_Reflected), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec2", "float angle(const Vec2 &in) const", asFUNCTION(Vec2_AngleWith), asCALL_GENERIC); assert(r >= 0);
+    r = bind.behaviour<Vec2_Construct>("Vec2", asBEHAVE_CONSTRUCT, "void f()"); assert(r >= 0);
+    r = bind.behaviour<Vec2_Construct_2f>("Vec2", asBEHAVE_CONSTRUCT, "void f(float, float)"); assert(r >= 0);
+    r = bind.behaviour<Vec2_Construct_1f>("Vec2", asBEHAVE_CONSTRUCT, "void f(float)"); assert(r >= 0);
+    r = bind.behaviour<Vec2_CopyConstruct>("Vec2", asBEHAVE_CONSTRUCT, "void f(const Vec2 &in)"); assert(r >= 0);
+    r = bind.method<Vec2_Set>("Vec2", "Vec2& set(float, float)"); assert(r >= 0);
+    r = bind.method<Vec2_Length>("Vec2", "float length() const"); assert(r >= 0);
+    r = bind.method<Vec2_LengthSquared>("Vec2", "float lengthSquared() const"); assert(r >= 0);
+    r = bind.method<Vec2_Normalize>("Vec2", "Vec2& normalize()"); assert(r >= 0);
+    r = bind.method<Vec2_Normalized>("Vec2", "Vec2 normalized() const"); assert(r >= 0);
+    r = bind.method<Vec2_Dot>("Vec2", "float dot(const Vec2 &in) const"); assert(r >= 0);
+    r = bind.method<Vec2_Distance>("Vec2", "float distance(const Vec2 &in) const"); assert(r >= 0);
+    r = bind.method<Vec2_Angle>("Vec2", "float angle() const"); assert(r >= 0);
+    r = bind.method<Vec2_Rotate>("Vec2", "Vec2& rotate(float)"); assert(r >= 0);
+    r = bind.method<Vec2_Rotated>("Vec2", "Vec2 rotated(float) const"); assert(r >= 0);
+    r = bind.method<Vec2_OpAdd>("Vec2", "Vec2 opAdd(const Vec2 &in) const"); assert(r >= 0);
+    r = bind.method<Vec2_OpSub>("Vec2", "Vec2 opSub(const Vec2 &in) const"); assert(r >= 0);
+    r = bind.method<Vec2_OpMulScalar>("Vec2", "Vec2 opMul(float) const"); assert(r >= 0);
+    r = bind.method<Vec2_OpDivScalar>("Vec2", "Vec2 opDiv(float) const"); assert(r >= 0);
+    r = bind.method<Vec2_OpNeg>("Vec2", "Vec2 opNeg() const"); assert(r >= 0);
+    r = bind.function<Vec2_fromAngle_1f>("Vec2 Vec2_fromAngle(float)"); assert(r >= 0);
+    r = bind.function<Vec2_fromAngle_2f>("Vec2 Vec2_fromAngle(float, float)"); assert(r >= 0);
+    r = bind.method<Vec2_Limit>("Vec2", "Vec2& limit(float)"); assert(r >= 0);
+    r = bind.method<Vec2_Cross>("Vec2", "float cross(const Vec2 &in) const"); assert(r >= 0);
+    r = bind.method<Vec2_DistanceSquared>("Vec2", "float distanceSquared(const Vec2 &in) const"); assert(r >= 0);
+    r = bind.method<Vec2_Lerp>("Vec2", "Vec2 lerp(const Vec2 &in, float) const"); assert(r >= 0);
+    r = bind.method<Vec2_Perpendicular>("Vec2", "Vec2 perpendicular() const"); assert(r >= 0);
+    r = bind.method<Vec2_Reflected>("Vec2", "Vec2 reflected(const Vec2 &in) const"); assert(r >= 0);
+    r = bind.method<Vec2_AngleWith>("Vec2", "float angle(const Vec2 &in) const"); assert(r >= 0);
 
     // Vec3
-    r = engine_->RegisterObjectType("Vec3", sizeof(Vec3), asOBJ_VALUE | asOBJ_POD | asGetTypeTraits<Vec3>()); assert(r >= 0);
+    r = engine_->RegisterObjectType("Vec3", sizeof(Vec3), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_ALLFLOATS | asGetTypeTraits<Vec3>()); assert(r >= 0);
     r = engine_->RegisterObjectProperty("Vec3", "float x", offsetof(Vec3, x)); assert(r >= 0);
     r = engine_->RegisterObjectProperty("Vec3", "float y", offsetof(Vec3, y)); assert(r >= 0);
     r = engine_->RegisterObjectProperty("Vec3", "float z", offsetof(Vec3, z)); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("Vec3", asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(Vec3_Construct), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("Vec3", asBEHAVE_CONSTRUCT, "void f(float, float, float)", asFUNCTION(Vec3_Construct_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("Vec3", asBEHAVE_CONSTRUCT, "void f(float)", asFUNCTION(Vec3_Construct_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("Vec3", asBEHAVE_CONSTRUCT, "void f(const Vec3 &in)", asFUNCTION(Vec3_CopyConstruct), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec3", "Vec3& set(float, float, float)", asFUNCTION(Vec3_Set), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec3", "float length() const", asFUNCTION(Vec3_Length), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec3", "float lengthSquared() const", asFUNCTION(Vec3_LengthSquared), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec3", "Vec3& normalize()", asFUNCTION(Vec3_Normalize), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec3", "Vec3 normalized() const", asFUNCTION(Vec3_Normalized), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec3", "float dot(const Vec3 &in) const", asFUNCTION(Vec3_Dot), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec3", "Vec3 cross(const Vec3 &in) const", asFUNCTION(Vec3_Cross), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec3", "Vec3 opAdd(const Vec3 &in) const", asFUNCTION(Vec3_OpAdd), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec3", "Vec3 opSub(const Vec3 &in) const", asFUNCTION(Vec3_OpSub), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec3", "Vec3 opMul(float) const", asFUNCTION(Vec3_OpMulScalar), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec3", "Vec3 opDiv(float) const", asFUNCTION(Vec3_OpDivScalar), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec3", "Vec3 opNeg() const", asFUNCTION(Vec3_OpNeg), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec3", "Vec3& limit(float)", asFUNCTION(Vec3_Limit), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec3", "float distance(const Vec3 &in) const", asFUNCTION(Vec3_Distance), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec3", "float distanceSquared(const Vec3 &in) const", asFUNCTION(Vec3_DistanceSquared), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec3", "Vec3 lerp(const Vec3 &in, float) const", asFUNCTION(Vec3_Lerp), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec3", "Vec3 reflected(const Vec3 &in) const", asFUNCTION(Vec3_Reflected), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Vec3", "Vec2 xy() const", asFUNCTION(Vec3_XY), asCALL_GENERIC); assert(r >= 0);
+    r = bind.behaviour<Vec3_Construct>("Vec3", asBEHAVE_CONSTRUCT, "void f()"); assert(r >= 0);
+    r = bind.behaviour<Vec3_Construct_3f>("Vec3", asBEHAVE_CONSTRUCT, "void f(float, float, float)"); assert(r >= 0);
+    r = bind.behaviour<Vec3_Construct_1f>("Vec3", asBEHAVE_CONSTRUCT, "void f(float)"); assert(r >= 0);
+    r = bind.behaviour<Vec3_CopyConstruct>("Vec3", asBEHAVE_CONSTRUCT, "void f(const Vec3 &in)"); assert(r >= 0);
+    r = bind.method<Vec3_Set>("Vec3", "Vec3& set(float, float, float)"); assert(r >= 0);
+    r = bind.method<Vec3_Length>("Vec3", "float length() const"); assert(r >= 0);
+    r = bind.method<Vec3_LengthSquared>("Vec3", "float lengthSquared() const"); assert(r >= 0);
+    r = bind.method<Vec3_Normalize>("Vec3", "Vec3& normalize()"); assert(r >= 0);
+    r = bind.method<Vec3_Normalized>("Vec3", "Vec3 normalized() const"); assert(r >= 0);
+    r = bind.method<Vec3_Dot>("Vec3", "float dot(const Vec3 &in) const"); assert(r >= 0);
+    r = bind.method<Vec3_Cross>("Vec3", "Vec3 cross(const Vec3 &in) const"); assert(r >= 0);
+    r = bind.method<Vec3_OpAdd>("Vec3", "Vec3 opAdd(const Vec3 &in) const"); assert(r >= 0);
+    r = bind.method<Vec3_OpSub>("Vec3", "Vec3 opSub(const Vec3 &in) const"); assert(r >= 0);
+    r = bind.method<Vec3_OpMulScalar>("Vec3", "Vec3 opMul(float) const"); assert(r >= 0);
+    r = bind.method<Vec3_OpDivScalar>("Vec3", "Vec3 opDiv(float) const"); assert(r >= 0);
+    r = bind.method<Vec3_OpNeg>("Vec3", "Vec3 opNeg() const"); assert(r >= 0);
+    r = bind.method<Vec3_Limit>("Vec3", "Vec3& limit(float)"); assert(r >= 0);
+    r = bind.method<Vec3_Distance>("Vec3", "float distance(const Vec3 &in) const"); assert(r >= 0);
+    r = bind.method<Vec3_DistanceSquared>("Vec3", "float distanceSquared(const Vec3 &in) const"); assert(r >= 0);
+    r = bind.method<Vec3_Lerp>("Vec3", "Vec3 lerp(const Vec3 &in, float) const"); assert(r >= 0);
+    r = bind.method<Vec3_Reflected>("Vec3", "Vec3 reflected(const Vec3 &in) const"); assert(r >= 0);
+    r = bind.method<Vec3_XY>("Vec3", "Vec2 xy() const"); assert(r >= 0);
 
     // Color
-    r = engine_->RegisterObjectType("Color", sizeof(Color), asOBJ_VALUE | asOBJ_POD | asGetTypeTraits<Color>()); assert(r >= 0);
+    r = engine_->RegisterObjectType("Color", sizeof(Color), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_ALLFLOATS | asGetTypeTraits<Color>()); assert(r >= 0);
     r = engine_->RegisterObjectProperty("Color", "float r", offsetof(Color, r)); assert(r >= 0);
     r = engine_->RegisterObjectProperty("Color", "float g", offsetof(Color, g)); assert(r >= 0);
     r = engine_->RegisterObjectProperty("Color", "float b", offsetof(Color, b)); assert(r >= 0);
     r = engine_->RegisterObjectProperty("Color", "float a", offsetof(Color, a)); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("Color", asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(Color_Construct), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("Color", asBEHAVE_CONSTRUCT, "void f(float, float, float)", asFUNCTION(Color_Construct_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("Color", asBEHAVE_CONSTRUCT, "void f(float, float, float, float)", asFUNCTION(Color_Construct_4f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("Color", asBEHAVE_CONSTRUCT, "void f(float)", asFUNCTION(Color_Construct_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("Color", asBEHAVE_CONSTRUCT, "void f(const Color &in)", asFUNCTION(Color_CopyConstruct), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Color", "Color& set(float, float, float)", asFUNCTION(Color_Set_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Color", "Color& set(float, float, float, float)", asFUNCTION(Color_Set_4f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Color", "Color lerp(const Color &in, float) const", asFUNCTION(Color_Lerp), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Color", "uint toHex() const", asFUNCTION(Color_ToHex_0), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Color", "uint toHex(bool) const", asFUNCTION(Color_ToHex_1b), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Color", "Color lerpRGB(const Color &in, float) const", asFUNCTION(Color_LerpRGB), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Color", "Color clamped() const", asFUNCTION(Color_Clamped), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Color Color_fromHSB(float, float, float)", asFUNCTION(Color_fromHSB_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Color Color_fromHSB(float, float, float, float)", asFUNCTION(Color_fromHSB_4f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Color colorFromHSB(float, float, float)", asFUNCTION(Color_fromHSB_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Color colorFromHSB(float, float, float, float)", asFUNCTION(Color_fromHSB_4f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Color Color_fromOKLCH(float, float, float)", asFUNCTION(Color_fromOKLCH_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Color Color_fromOKLCH(float, float, float, float)", asFUNCTION(Color_fromOKLCH_4f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Color Color_fromOKLab(float, float, float)", asFUNCTION(Color_fromOKLab_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Color Color_fromOKLab(float, float, float, float)", asFUNCTION(Color_fromOKLab_4f), asCALL_GENERIC); assert(r >= 0);
+    r = bind.behaviour<Color_Construct>("Color", asBEHAVE_CONSTRUCT, "void f()"); assert(r >= 0);
+    r = bind.behaviour<Color_Construct_3f>("Color", asBEHAVE_CONSTRUCT, "void f(float, float, float)"); assert(r >= 0);
+    r = bind.behaviour<Color_Construct_4f>("Color", asBEHAVE_CONSTRUCT, "void f(float, float, float, float)"); assert(r >= 0);
+    r = bind.behaviour<Color_Construct_1f>("Color", asBEHAVE_CONSTRUCT, "void f(float)"); assert(r >= 0);
+    r = bind.behaviour<Color_CopyConstruct>("Color", asBEHAVE_CONSTRUCT, "void f(const Color &in)"); assert(r >= 0);
+    r = bind.method<Color_Set_3f>("Color", "Color& set(float, float, float)"); assert(r >= 0);
+    r = bind.method<Color_Set_4f>("Color", "Color& set(float, float, float, float)"); assert(r >= 0);
+    r = bind.method<Color_Lerp>("Color", "Color lerp(const Color &in, float) const"); assert(r >= 0);
+    r = bind.method<Color_ToHex_0>("Color", "uint toHex() const"); assert(r >= 0);
+    r = bind.method<Color_ToHex_1b>("Color", "uint toHex(bool) const"); assert(r >= 0);
+    r = bind.method<Color_LerpRGB>("Color", "Color lerpRGB(const Color &in, float) const"); assert(r >= 0);
+    r = bind.method<Color_Clamped>("Color", "Color clamped() const"); assert(r >= 0);
+    r = bind.function<Color_fromHSB_3f>("Color Color_fromHSB(float, float, float)"); assert(r >= 0);
+    r = bind.function<Color_fromHSB_4f>("Color Color_fromHSB(float, float, float, float)"); assert(r >= 0);
+    r = bind.function<Color_fromHSB_3f>("Color colorFromHSB(float, float, float)"); assert(r >= 0);
+    r = bind.function<Color_fromHSB_4f>("Color colorFromHSB(float, float, float, float)"); assert(r >= 0);
+    r = bind.function<Color_fromOKLCH_3f>("Color Color_fromOKLCH(float, float, float)"); assert(r >= 0);
+    r = bind.function<Color_fromOKLCH_4f>("Color Color_fromOKLCH(float, float, float, float)"); assert(r >= 0);
+    r = bind.function<Color_fromOKLab_3f>("Color Color_fromOKLab(float, float, float)"); assert(r >= 0);
+    r = bind.function<Color_fromOKLab_4f>("Color Color_fromOKLab(float, float, float, float)"); assert(r >= 0);
 
     // Rect
-    r = engine_->RegisterObjectType("Rect", sizeof(Rect), asOBJ_VALUE | asOBJ_POD | asGetTypeTraits<Rect>()); assert(r >= 0);
+    r = engine_->RegisterObjectType("Rect", sizeof(Rect), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_ALLFLOATS | asGetTypeTraits<Rect>()); assert(r >= 0);
     r = engine_->RegisterObjectProperty("Rect", "float x", offsetof(Rect, x)); assert(r >= 0);
     r = engine_->RegisterObjectProperty("Rect", "float y", offsetof(Rect, y)); assert(r >= 0);
     r = engine_->RegisterObjectProperty("Rect", "float width", offsetof(Rect, width)); assert(r >= 0);
     r = engine_->RegisterObjectProperty("Rect", "float height", offsetof(Rect, height)); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("Rect", asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(Rect_Construct), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("Rect", asBEHAVE_CONSTRUCT, "void f(float, float, float, float)", asFUNCTION(Rect_Construct_4f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("Rect", asBEHAVE_CONSTRUCT, "void f(const Rect &in)", asFUNCTION(Rect_CopyConstruct), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Rect", "Rect& set(float, float, float, float)", asFUNCTION(Rect_Set), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Rect", "bool contains(float, float) const", asFUNCTION(Rect_Contains), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Rect", "bool intersects(const Rect &in) const", asFUNCTION(Rect_Intersects), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Rect", "float getCenterX() const", asFUNCTION(Rect_GetCenterX), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Rect", "float getCenterY() const", asFUNCTION(Rect_GetCenterY), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Rect", "float getRight() const", asFUNCTION(Rect_GetRight), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Rect", "float getBottom() const", asFUNCTION(Rect_GetBottom), asCALL_GENERIC); assert(r >= 0);
+    r = bind.behaviour<Rect_Construct>("Rect", asBEHAVE_CONSTRUCT, "void f()"); assert(r >= 0);
+    r = bind.behaviour<Rect_Construct_4f>("Rect", asBEHAVE_CONSTRUCT, "void f(float, float, float, float)"); assert(r >= 0);
+    r = bind.behaviour<Rect_CopyConstruct>("Rect", asBEHAVE_CONSTRUCT, "void f(const Rect &in)"); assert(r >= 0);
+    r = bind.method<Rect_Set>("Rect", "Rect& set(float, float, float, float)"); assert(r >= 0);
+    r = bind.method<Rect_Contains>("Rect", "bool contains(float, float) const"); assert(r >= 0);
+    r = bind.method<Rect_Intersects>("Rect", "bool intersects(const Rect &in) const"); assert(r >= 0);
+    r = bind.method<Rect_GetCenterX>("Rect", "float getCenterX() const"); assert(r >= 0);
+    r = bind.method<Rect_GetCenterY>("Rect", "float getCenterY() const"); assert(r >= 0);
+    r = bind.method<Rect_GetRight>("Rect", "float getRight() const"); assert(r >= 0);
+    r = bind.method<Rect_GetBottom>("Rect", "float getBottom() const"); assert(r >= 0);
 
     // Mat4 (4x4 matrix for 3D transformations)
     r = engine_->RegisterObjectType("Mat4", sizeof(Mat4), asOBJ_VALUE | asOBJ_POD | asGetTypeTraits<Mat4>()); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("Mat4", asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(Mat4_Construct), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("Mat4", asBEHAVE_CONSTRUCT, "void f(const Mat4 &in)", asFUNCTION(Mat4_CopyConstruct), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mat4", "Mat4 opMul(const Mat4 &in) const", asFUNCTION(Mat4_OpMul_Mat4), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mat4", "Vec3 opMul(const Vec3 &in) const", asFUNCTION(Mat4_OpMul_Vec3), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mat4", "Mat4 transposed() const", asFUNCTION(Mat4_Transposed), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mat4", "Mat4 inverted() const", asFUNCTION(Mat4_Inverted), asCALL_GENERIC); assert(r >= 0);
+    r = bind.behaviour<Mat4_Construct>("Mat4", asBEHAVE_CONSTRUCT, "void f()"); assert(r >= 0);
+    r = bind.behaviour<Mat4_CopyConstruct>("Mat4", asBEHAVE_CONSTRUCT, "void f(const Mat4 &in)"); assert(r >= 0);
+    r = bind.method<Mat4_OpMul_Mat4>("Mat4", "Mat4 opMul(const Mat4 &in) const"); assert(r >= 0);
+    r = bind.method<Mat4_OpMul_Vec3>("Mat4", "Vec3 opMul(const Vec3 &in) const"); assert(r >= 0);
+    r = bind.method<Mat4_Transposed>("Mat4", "Mat4 transposed() const"); assert(r >= 0);
+    r = bind.method<Mat4_Inverted>("Mat4", "Mat4 inverted() const"); assert(r >= 0);
     // Mat4 static factory functions
-    r = engine_->RegisterGlobalFunction("Mat4 Mat4_identity()", asFUNCTION(Mat4_Identity), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Mat4 Mat4_translate(float, float, float)", asFUNCTION(Mat4_Translate_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Mat4 Mat4_translate(const Vec3 &in)", asFUNCTION(Mat4_Translate_Vec3), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Mat4 Mat4_rotateX(float)", asFUNCTION(Mat4_RotateX), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Mat4 Mat4_rotateY(float)", asFUNCTION(Mat4_RotateY), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Mat4 Mat4_rotateZ(float)", asFUNCTION(Mat4_RotateZ), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Mat4 Mat4_scale(float)", asFUNCTION(Mat4_Scale_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Mat4 Mat4_scale(float, float, float)", asFUNCTION(Mat4_Scale_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Mat4 Mat4_lookAt(const Vec3 &in, const Vec3 &in, const Vec3 &in)", asFUNCTION(Mat4_LookAt), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Mat4 Mat4_ortho(float, float, float, float, float, float)", asFUNCTION(Mat4_Ortho), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Mat4 Mat4_perspective(float, float, float, float)", asFUNCTION(Mat4_Perspective), asCALL_GENERIC); assert(r >= 0);
+    r = bind.function<Mat4_Identity>("Mat4 Mat4_identity()"); assert(r >= 0);
+    r = bind.function<Mat4_Translate_3f>("Mat4 Mat4_translate(float, float, float)"); assert(r >= 0);
+    r = bind.function<Mat4_Translate_Vec3>("Mat4 Mat4_translate(const Vec3 &in)"); assert(r >= 0);
+    r = bind.function<Mat4_RotateX>("Mat4 Mat4_rotateX(float)"); assert(r >= 0);
+    r = bind.function<Mat4_RotateY>("Mat4 Mat4_rotateY(float)"); assert(r >= 0);
+    r = bind.function<Mat4_RotateZ>("Mat4 Mat4_rotateZ(float)"); assert(r >= 0);
+    r = bind.function<Mat4_Scale_1f>("Mat4 Mat4_scale(float)"); assert(r >= 0);
+    r = bind.function<Mat4_Scale_3f>("Mat4 Mat4_scale(float, float, float)"); assert(r >= 0);
+    r = bind.function<Mat4_LookAt>("Mat4 Mat4_lookAt(const Vec3 &in, const Vec3 &in, const Vec3 &in)"); assert(r >= 0);
+    r = bind.function<Mat4_Ortho>("Mat4 Mat4_ortho(float, float, float, float, float, float)"); assert(r >= 0);
+    r = bind.function<Mat4_Perspective>("Mat4 Mat4_perspective(float, float, float, float)"); assert(r >= 0);
 
     // Quaternion (unit quaternion for 3D rotations)
-    r = engine_->RegisterObjectType("Quaternion", sizeof(Quaternion), asOBJ_VALUE | asOBJ_POD | asGetTypeTraits<Quaternion>()); assert(r >= 0);
+    r = engine_->RegisterObjectType("Quaternion", sizeof(Quaternion), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_ALLFLOATS | asGetTypeTraits<Quaternion>()); assert(r >= 0);
     r = engine_->RegisterObjectProperty("Quaternion", "float w", offsetof(Quaternion, w)); assert(r >= 0);
     r = engine_->RegisterObjectProperty("Quaternion", "float x", offsetof(Quaternion, x)); assert(r >= 0);
     r = engine_->RegisterObjectProperty("Quaternion", "float y", offsetof(Quaternion, y)); assert(r >= 0);
     r = engine_->RegisterObjectProperty("Quaternion", "float z", offsetof(Quaternion, z)); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("Quaternion", asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(Quaternion_Construct), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("Quaternion", asBEHAVE_CONSTRUCT, "void f(float, float, float, float)", asFUNCTION(Quaternion_Construct_4f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("Quaternion", asBEHAVE_CONSTRUCT, "void f(const Quaternion &in)", asFUNCTION(Quaternion_CopyConstruct), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Quaternion", "Quaternion opMul(const Quaternion &in) const", asFUNCTION(Quaternion_OpMul), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Quaternion", "Vec3 rotate(const Vec3 &in) const", asFUNCTION(Quaternion_Rotate), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Quaternion", "Vec3 toEuler() const", asFUNCTION(Quaternion_ToEuler), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Quaternion", "Mat4 toMatrix() const", asFUNCTION(Quaternion_ToMatrix), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Quaternion", "Quaternion normalized() const", asFUNCTION(Quaternion_Normalized), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Quaternion", "float length() const", asFUNCTION(Quaternion_Length), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Quaternion", "Quaternion conjugate() const", asFUNCTION(Quaternion_Conjugate), asCALL_GENERIC); assert(r >= 0);
+    r = bind.behaviour<Quaternion_Construct>("Quaternion", asBEHAVE_CONSTRUCT, "void f()"); assert(r >= 0);
+    r = bind.behaviour<Quaternion_Construct_4f>("Quaternion", asBEHAVE_CONSTRUCT, "void f(float, float, float, float)"); assert(r >= 0);
+    r = bind.behaviour<Quaternion_CopyConstruct>("Quaternion", asBEHAVE_CONSTRUCT, "void f(const Quaternion &in)"); assert(r >= 0);
+    r = bind.method<Quaternion_OpMul>("Quaternion", "Quaternion opMul(const Quaternion &in) const"); assert(r >= 0);
+    r = bind.method<Quaternion_Rotate>("Quaternion", "Vec3 rotate(const Vec3 &in) const"); assert(r >= 0);
+    r = bind.method<Quaternion_ToEuler>("Quaternion", "Vec3 toEuler() const"); assert(r >= 0);
+    r = bind.method<Quaternion_ToMatrix>("Quaternion", "Mat4 toMatrix() const"); assert(r >= 0);
+    r = bind.method<Quaternion_Normalized>("Quaternion", "Quaternion normalized() const"); assert(r >= 0);
+    r = bind.method<Quaternion_Length>("Quaternion", "float length() const"); assert(r >= 0);
+    r = bind.method<Quaternion_Conjugate>("Quaternion", "Quaternion conjugate() const"); assert(r >= 0);
     // Quaternion static factory functions
-    r = engine_->RegisterGlobalFunction("Quaternion Quaternion_identity()", asFUNCTION(Quaternion_Identity), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Quaternion Quaternion_fromAxisAngle(const Vec3 &in, float)", asFUNCTION(Quaternion_FromAxisAngle), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Quaternion Quaternion_fromEuler(float, float, float)", asFUNCTION(Quaternion_FromEuler_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Quaternion Quaternion_fromEuler(const Vec3 &in)", asFUNCTION(Quaternion_FromEuler_Vec3), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Quaternion Quaternion_slerp(const Quaternion &in, const Quaternion &in, float)", asFUNCTION(Quaternion_Slerp), asCALL_GENERIC); assert(r >= 0);
+    r = bind.function<Quaternion_Identity>("Quaternion Quaternion_identity()"); assert(r >= 0);
+    r = bind.function<Quaternion_FromAxisAngle>("Quaternion Quaternion_fromAxisAngle(const Vec3 &in, float)"); assert(r >= 0);
+    r = bind.function<Quaternion_FromEuler_3f>("Quaternion Quaternion_fromEuler(float, float, float)"); assert(r >= 0);
+    r = bind.function<Quaternion_FromEuler_Vec3>("Quaternion Quaternion_fromEuler(const Vec3 &in)"); assert(r >= 0);
+    r = bind.function<Quaternion_Slerp>("Quaternion Quaternion_slerp(const Quaternion &in, const Quaternion &in, float)"); assert(r >= 0);
 
     // =========================================================================
     // Reference types: Pixels, Texture, Fbo, Sound
@@ -2368,16 +3701,19 @@ void tcScriptHost::registerTrussCFunctions() {
     // =========================================================================
 
     // First, register all object types
-    r = engine_->RegisterObjectType("Pixels", 0, asOBJ_REF | asOBJ_NOCOUNT); assert(r >= 0);
-    r = engine_->RegisterObjectType("Texture", 0, asOBJ_REF | asOBJ_NOCOUNT); assert(r >= 0);
-    r = engine_->RegisterObjectType("Fbo", 0, asOBJ_REF | asOBJ_NOCOUNT); assert(r >= 0);
-    r = engine_->RegisterObjectType("Sound", 0, asOBJ_REF | asOBJ_NOCOUNT); assert(r >= 0);
-    r = engine_->RegisterObjectType("Font", 0, asOBJ_REF | asOBJ_NOCOUNT); assert(r >= 0);
-    r = engine_->RegisterObjectType("Mesh", 0, asOBJ_REF | asOBJ_NOCOUNT); assert(r >= 0);
-    r = engine_->RegisterObjectType("Path", 0, asOBJ_REF | asOBJ_NOCOUNT); assert(r >= 0);
-    r = engine_->RegisterObjectType("StrokeMesh", 0, asOBJ_REF | asOBJ_NOCOUNT); assert(r >= 0);
-    r = engine_->RegisterObjectType("Image", 0, asOBJ_REF | asOBJ_NOCOUNT); assert(r >= 0);
-    r = engine_->RegisterObjectType("EasyCam", 0, asOBJ_REF | asOBJ_NOCOUNT); assert(r >= 0);
+    r = engine_->RegisterObjectType("FloatBuffer", 0, asOBJ_REF); assert(r >= 0);
+    r = engine_->RegisterObjectType("Pixels", 0, asOBJ_REF); assert(r >= 0);
+    r = engine_->RegisterObjectType("Texture", 0, asOBJ_REF); assert(r >= 0);
+    r = engine_->RegisterObjectType("Fbo", 0, asOBJ_REF); assert(r >= 0);
+    r = engine_->RegisterObjectType("Sound", 0, asOBJ_REF); assert(r >= 0);
+    r = engine_->RegisterObjectType("Font", 0, asOBJ_REF); assert(r >= 0);
+    r = engine_->RegisterObjectType("Mesh", 0, asOBJ_REF); assert(r >= 0);
+    r = engine_->RegisterObjectType("Path", 0, asOBJ_REF); assert(r >= 0);
+    r = engine_->RegisterObjectType("StrokeMesh", 0, asOBJ_REF); assert(r >= 0);
+    r = engine_->RegisterObjectType("Image", 0, asOBJ_REF); assert(r >= 0);
+    r = engine_->RegisterObjectType("EasyCam", 0, asOBJ_REF); assert(r >= 0);
+    r = engine_->RegisterObjectType("DisplayList", 0, asOBJ_REF); assert(r >= 0);
+    r = engine_->RegisterObjectType("ParticleSystem", 0, asOBJ_REF | asOBJ_GC); assert(r >= 0);
 
     // PrimitiveMode enum for Mesh
     r = engine_->RegisterEnum("PrimitiveMode"); assert(r >= 0);
@@ -2394,203 +3730,351 @@ void tcScriptHost::registerTrussCFunctions() {
 
     // ChipSoundNote value type
     r = engine_->RegisterObjectType("ChipSoundNote", sizeof(ChipSoundNote), asOBJ_VALUE | asOBJ_POD | asGetTypeTraits<ChipSoundNote>()); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("ChipSoundNote", asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(ChipNote_Construct), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("ChipSoundNote", asBEHAVE_CONSTRUCT, "void f(Wave, float, float, float)", asFUNCTION(ChipNote_Construct_4), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("ChipSoundNote", asBEHAVE_CONSTRUCT, "void f(const ChipSoundNote &in)", asFUNCTION(ChipNote_CopyConstruct), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectBehaviour("ChipSoundNote", asBEHAVE_DESTRUCT, "void f()", asFUNCTION(ChipNote_Destruct), asCALL_GENERIC); assert(r >= 0);
+    r = engine_->RegisterObjectBehaviour("ChipSoundNote", asBEHAVE_CONSTRUCT, "void f()", AS_GENERIC(ChipNote_Construct)); assert(r >= 0);
+    r = engine_->RegisterObjectBehaviour("ChipSoundNote", asBEHAVE_CONSTRUCT, "void f(Wave, float, float, float)", AS_GENERIC(ChipNote_Construct_4)); assert(r >= 0);
+    r = engine_->RegisterObjectBehaviour("ChipSoundNote", asBEHAVE_CONSTRUCT, "void f(const ChipSoundNote &in)", AS_GENERIC(ChipNote_CopyConstruct)); assert(r >= 0);
+    r = engine_->RegisterObjectBehaviour("ChipSoundNote", asBEHAVE_DESTRUCT, "void f()", AS_GENERIC(ChipNote_Destruct)); assert(r >= 0);
 
     // ChipSoundBundle reference type
-    r = engine_->RegisterObjectType("ChipSoundBundle", 0, asOBJ_REF | asOBJ_NOCOUNT); assert(r >= 0);
+    r = engine_->RegisterObjectType("ChipSoundBundle", 0, asOBJ_REF); assert(r >= 0);
+
+    // ChipSynth reference type
+    r = engine_->RegisterObjectType("ChipSynth", 0, asOBJ_REF); assert(r >= 0);
+
+    // Sequencer reference type
+    r = engine_->RegisterObjectType("Sequencer", 0, asOBJ_REF); assert(r >= 0);
+
+    // Reference counting (see tcScriptRef.h)
+    r = bind.behaviour<tcscript::scriptAddRef<tcFloatBuffer>>("FloatBuffer", asBEHAVE_ADDREF, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptRelease<tcFloatBuffer>>("FloatBuffer", asBEHAVE_RELEASE, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptAddRef<Pixels>>("Pixels", asBEHAVE_ADDREF, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptRelease<Pixels>>("Pixels", asBEHAVE_RELEASE, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptAddRef<Texture>>("Texture", asBEHAVE_ADDREF, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptRelease<Texture>>("Texture", asBEHAVE_RELEASE, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptAddRef<Fbo>>("Fbo", asBEHAVE_ADDREF, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptRelease<Fbo>>("Fbo", asBEHAVE_RELEASE, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptAddRef<Sound>>("Sound", asBEHAVE_ADDREF, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptRelease<Sound>>("Sound", asBEHAVE_RELEASE, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptAddRef<Font>>("Font", asBEHAVE_ADDREF, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptRelease<Font>>("Font", asBEHAVE_RELEASE, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptAddRef<Mesh>>("Mesh", asBEHAVE_ADDREF, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptRelease<Mesh>>("Mesh", asBEHAVE_RELEASE, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptAddRef<Path>>("Path", asBEHAVE_ADDREF, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptRelease<Path>>("Path", asBEHAVE_RELEASE, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptAddRef<StrokeMesh>>("StrokeMesh", asBEHAVE_ADDREF, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptRelease<StrokeMesh>>("StrokeMesh", asBEHAVE_RELEASE, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptAddRef<Image>>("Image", asBEHAVE_ADDREF, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptRelease<Image>>("Image", asBEHAVE_RELEASE, "void f()"); assert(r >= 0);
+    ScriptObject<Image>::setDestroyHook(Image_Destroyed);
+    r = bind.behaviour<tcscript::scriptAddRef<EasyCam>>("EasyCam", asBEHAVE_ADDREF, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptRelease<EasyCam>>("EasyCam", asBEHAVE_RELEASE, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptAddRef<tcDisplayList>>("DisplayList", asBEHAVE_ADDREF, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptRelease<tcDisplayList>>("DisplayList", asBEHAVE_RELEASE, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptAddRef<tcParticleSystem>>("ParticleSystem", asBEHAVE_ADDREF, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptRelease<tcParticleSystem>>("ParticleSystem", asBEHAVE_RELEASE, "void f()"); assert(r >= 0);
+    r = engine_->RegisterObjectBehaviour("ParticleSystem", asBEHAVE_GETREFCOUNT, "int f()", AS_GENERIC(ParticleSystem_GetRefCount)); assert(r >= 0);
+    r = engine_->RegisterObjectBehaviour("ParticleSystem", asBEHAVE_SETGCFLAG, "void f()", AS_GENERIC(ParticleSystem_SetGCFlag)); assert(r >= 0);
+    r = engine_->RegisterObjectBehaviour("ParticleSystem", asBEHAVE_GETGCFLAG, "bool f()", AS_GENERIC(ParticleSystem_GetGCFlag)); assert(r >= 0);
+    r = engine_->RegisterObjectBehaviour("ParticleSystem", asBEHAVE_ENUMREFS, "void f(int&in)", AS_GENERIC(ParticleSystem_EnumRefs)); assert(r >= 0);
+    r = engine_->RegisterObjectBehaviour("ParticleSystem", asBEHAVE_RELEASEREFS, "void f(int&in)", AS_GENERIC(ParticleSystem_ReleaseRefs)); assert(r >= 0);
+    ScriptObject<tcParticleSystem>::setDestroyHook(ParticleSystem_Destroyed);
+    r = bind.behaviour<tcscript::scriptAddRef<ChipSoundBundle>>("ChipSoundBundle", asBEHAVE_ADDREF, "void f()"); assert(r >= 0);
+    r = bind.behaviour<ChipBundle_Release>("ChipSoundBundle", asBEHAVE_RELEASE, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptAddRef<tcChipSynth>>("ChipSynth", asBEHAVE_ADDREF, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptRelease<tcChipSynth>>("ChipSynth", asBEHAVE_RELEASE, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptAddRef<tcSequencer>>("Sequencer", asBEHAVE_ADDREF, "void f()"); assert(r >= 0);
+    r = bind.behaviour<Sequencer_Release>("Sequencer", asBEHAVE_RELEASE, "void f()"); assert(r >= 0);
+
+    // FloatBuffer methods (kernels take an optional offset and stride)
+    r = engine_->RegisterGlobalFunction("FloatBuffer@ createFloatBuffer()", AS_GENERIC(FloatBuffer_Factory)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("FloatBuffer@ createFloatBuffer(int)", AS_GENERIC(FloatBuffer_Factory_1i)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("FloatBuffer", "void resize(int)", AS_GENERIC(FloatBuffer_Resize)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("FloatBuffer", "int size() const", AS_GENERIC(FloatBuffer_Size)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("FloatBuffer", "float& opIndex(int)", AS_GENERIC(FloatBuffer_Index)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("FloatBuffer", "const float& opIndex(int) const", AS_GENERIC(FloatBuffer_Index)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("FloatBuffer", "void fill(float, int = 0, int = 1)", AS_GENERIC(FloatBuffer_Fill)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("FloatBuffer", "void add(float, int = 0, int = 1)", AS_GENERIC(FloatBuffer_Add_Value)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("FloatBuffer", "void mul(float, int = 0, int = 1)", AS_GENERIC(FloatBuffer_Mul_Value)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("FloatBuffer", "void clamp(float, float, int = 0, int = 1)", AS_GENERIC(FloatBuffer_Clamp)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("FloatBuffer", "void sin(int = 0, int = 1)", AS_GENERIC(FloatBuffer_Sin)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("FloatBuffer", "void cos(int = 0, int = 1)", AS_GENERIC(FloatBuffer_Cos)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("FloatBuffer", "void add(FloatBuffer@, int = 0, int = 1)", AS_GENERIC(FloatBuffer_Add_Buffer)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("FloatBuffer", "void mul(FloatBuffer@, int = 0, int = 1)", AS_GENERIC(FloatBuffer_Mul_Buffer)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("FloatBuffer", "void fma(FloatBuffer@, float, int = 0, int = 1)", AS_GENERIC(FloatBuffer_Fma)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("FloatBuffer", "void lerp(FloatBuffer@, float, int = 0, int = 1)", AS_GENERIC(FloatBuffer_Lerp)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("FloatBuffer", "void fillRandom(float, float, int = 0, int = 1)", AS_GENERIC(FloatBuffer_FillRandom)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("FloatBuffer", "void fillNoise(float, float, float, int = 0, int = 1)", AS_GENERIC(FloatBuffer_FillNoise)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("FloatBuffer", "void copyFrom(FloatBuffer@, int = 0, int = 1, int = 0, int = 1)", AS_GENERIC(FloatBuffer_CopyFrom)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("FloatBuffer", "void fromArray(array<float>@)", AS_GENERIC(FloatBuffer_FromArray)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("FloatBuffer", "array<float>@ toArray() const", AS_GENERIC(FloatBuffer_ToArray)); assert(r >= 0);
 
     // Pixels methods
-    r = engine_->RegisterGlobalFunction("Pixels@ createPixels()", asFUNCTION(Pixels_Factory), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Pixels", "void allocate(int, int)", asFUNCTION(Pixels_Allocate_2i), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Pixels", "void allocate(int, int, int)", asFUNCTION(Pixels_Allocate_3i), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Pixels", "Color getColor(int, int) const", asFUNCTION(Pixels_GetColor), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Pixels", "void setColor(int, int, const Color &in)", asFUNCTION(Pixels_SetColor), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Pixels", "bool load(const string &in)", asFUNCTION(Pixels_Load), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Pixels", "bool save(const string &in) const", asFUNCTION(Pixels_Save), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Pixels", "int getWidth() const", asFUNCTION(Pixels_GetWidth), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Pixels", "int getHeight() const", asFUNCTION(Pixels_GetHeight), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Pixels", "bool isAllocated() const", asFUNCTION(Pixels_IsAllocated), asCALL_GENERIC); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("Pixels@ createPixels()", AS_GENERIC(Pixels_Factory)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Pixels", "void allocate(int, int)", AS_GENERIC(Pixels_Allocate_2i)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Pixels", "void allocate(int, int, int)", AS_GENERIC(Pixels_Allocate_3i)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Pixels", "Color getColor(int, int) const", AS_GENERIC(Pixels_GetColor)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Pixels", "void setColor(int, int, const Color &in)", AS_GENERIC(Pixels_SetColor)); assert(r >= 0);
+    r = engine_->RegisterFuncdef("void LoadCallback(bool)"); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Pixels", "bool load(const string &in)", AS_GENERIC(Pixels_Load)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Pixels", "void loadAsync(const string &in, LoadCallback@ = null)", AS_GENERIC(Pixels_LoadAsync)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Pixels", "bool isLoading() const", AS_GENERIC(Pixels_IsLoading)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Pixels", "bool save(const string &in) const", AS_GENERIC(Pixels_Save)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Pixels", "int getWidth() const", AS_GENERIC(Pixels_GetWidth)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Pixels", "int getHeight() const", AS_GENERIC(Pixels_GetHeight)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Pixels", "bool isAllocated() const", AS_GENERIC(Pixels_IsAllocated)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Pixels", "int getChannels() const", AS_GENERIC(Pixels_GetChannels)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Pixels", "void fromFloatBuffer(FloatBuffer@)", AS_GENERIC(Pixels_FromFloatBuffer)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Pixels", "void toFloatBuffer(FloatBuffer@) const", AS_GENERIC(Pixels_ToFloatBuffer)); assert(r >= 0);
+
+    // Pixels bulk access and filters
+    r = engine_->RegisterEnum("PixelBlend"); assert(r >= 0);
+    r = engine_->RegisterEnumValue("PixelBlend", "Mix", static_cast<int>(tcpixels::Blend::Mix)); assert(r >= 0);
+    r = engine_->RegisterEnumValue("PixelBlend", "Add", static_cast<int>(tcpixels::Blend::Add)); assert(r >= 0);
+    r = engine_->RegisterEnumValue("PixelBlend", "Multiply", static_cast<int>(tcpixels::Blend::Multiply)); assert(r >= 0);
+    r = engine_->RegisterEnumValue("PixelBlend", "Screen", static_cast<int>(tcpixels::Blend::Screen)); assert(r >= 0);
+    r = engine_->RegisterFuncdef("void PixelRowFunc(FloatBuffer@, int)"); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Pixels", "array<uint8>@ getData() const", AS_GENERIC(Pixels_GetData)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Pixels", "void setData(array<uint8>@)", AS_GENERIC(Pixels_SetData)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Pixels", "void fill(const Color &in)", AS_GENERIC(Pixels_Fill)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Pixels", "void map(PixelRowFunc@)", AS_GENERIC(Pixels_Map)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Pixels", "void blur(int)", AS_GENERIC(Pixels_Blur)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Pixels", "void threshold(float)", AS_GENERIC(Pixels_Threshold)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Pixels", "void convolve(array<float>@)", AS_GENERIC(Pixels_Convolve)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Pixels", "void blend(Pixels@, PixelBlend, float = 1.0f)", AS_GENERIC(Pixels_Blend)); assert(r >= 0);
 
     // Texture methods
-    r = engine_->RegisterGlobalFunction("Texture@ createTexture()", asFUNCTION(Texture_Factory), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Texture", "void allocate(int, int)", asFUNCTION(Texture_Allocate_2i), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Texture", "void allocate(Pixels@)", asFUNCTION(Texture_Allocate_Pixels), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Texture", "void loadData(Pixels@)", asFUNCTION(Texture_LoadData), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Texture", "void bind()", asFUNCTION(Texture_Bind), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Texture", "void unbind()", asFUNCTION(Texture_Unbind), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Texture", "int getWidth() const", asFUNCTION(Texture_GetWidth), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Texture", "int getHeight() const", asFUNCTION(Texture_GetHeight), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Texture", "bool isAllocated() const", asFUNCTION(Texture_IsAllocated), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Texture", "void draw(float, float)", asFUNCTION(Texture_Draw_2f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Texture", "void draw(float, float, float, float)", asFUNCTION(Texture_Draw_4f), asCALL_GENERIC); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("Texture@ createTexture()", AS_GENERIC(Texture_Factory)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Texture", "void allocate(int, int)", AS_GENERIC(Texture_Allocate_2i)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Texture", "void allocate(Pixels@)", AS_GENERIC(Texture_Allocate_Pixels)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Texture", "void loadData(Pixels@)", AS_GENERIC(Texture_LoadData)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Texture", "void loadData(Pixels@, const Rect &in)", AS_GENERIC(Texture_LoadData_Rect)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Texture", "void bind()", AS_GENERIC(Texture_Bind)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Texture", "void unbind()", AS_GENERIC(Texture_Unbind)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Texture", "int getWidth() const", AS_GENERIC(Texture_GetWidth)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Texture", "int getHeight() const", AS_GENERIC(Texture_GetHeight)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Texture", "bool isAllocated() const", AS_GENERIC(Texture_IsAllocated)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Texture", "void draw(float, float)", AS_GENERIC(Texture_Draw_2f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Texture", "void draw(float, float, float, float)", AS_GENERIC(Texture_Draw_4f)); assert(r >= 0);
 
     // Fbo methods
-    r = engine_->RegisterGlobalFunction("Fbo@ createFbo()", asFUNCTION(Fbo_Factory), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Fbo", "void allocate(int, int)", asFUNCTION(Fbo_Allocate_2i), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Fbo", "void begin()", asFUNCTION(Fbo_Begin), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Fbo", "void begin(float, float, float, float)", asFUNCTION(Fbo_Begin_4f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Fbo", "void end()", asFUNCTION(Fbo_End), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Fbo", "Texture@ getTexture()", asFUNCTION(Fbo_GetTexture), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Fbo", "int getWidth() const", asFUNCTION(Fbo_GetWidth), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Fbo", "int getHeight() const", asFUNCTION(Fbo_GetHeight), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Fbo", "bool isAllocated() const", asFUNCTION(Fbo_IsAllocated), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Fbo", "void draw(float, float)", asFUNCTION(Fbo_Draw_2f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Fbo", "void draw(float, float, float, float)", asFUNCTION(Fbo_Draw_4f), asCALL_GENERIC); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("Fbo@ createFbo()", AS_GENERIC(Fbo_Factory)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Fbo", "void allocate(int, int)", AS_GENERIC(Fbo_Allocate_2i)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Fbo", "void begin()", AS_GENERIC(Fbo_Begin)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Fbo", "void begin(float, float, float, float)", AS_GENERIC(Fbo_Begin_4f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Fbo", "void end()", AS_GENERIC(Fbo_End)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Fbo", "Texture@ getTexture()", AS_GENERIC(Fbo_GetTexture)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Fbo", "int getWidth() const", AS_GENERIC(Fbo_GetWidth)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Fbo", "int getHeight() const", AS_GENERIC(Fbo_GetHeight)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Fbo", "bool isAllocated() const", AS_GENERIC(Fbo_IsAllocated)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Fbo", "void draw(float, float)", AS_GENERIC(Fbo_Draw_2f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Fbo", "void draw(float, float, float, float)", AS_GENERIC(Fbo_Draw_4f)); assert(r >= 0);
 
     // Mesh methods
-    r = engine_->RegisterGlobalFunction("Mesh@ createMesh()", asFUNCTION(Mesh_Factory), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ setMode(PrimitiveMode)", asFUNCTION(Mesh_SetMode), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "int getMode() const", asFUNCTION(Mesh_GetMode), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addVertex(float, float, float)", asFUNCTION(Mesh_AddVertex_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addVertex(float, float)", asFUNCTION(Mesh_AddVertex_2f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addVertex(const Vec3 &in)", asFUNCTION(Mesh_AddVertex_Vec3), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addVertex(const Vec2 &in)", asFUNCTION(Mesh_AddVertex_Vec2), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addColor(const Color &in)", asFUNCTION(Mesh_AddColor_Color), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addColor(float, float, float, float)", asFUNCTION(Mesh_AddColor_4f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addColor(float, float, float)", asFUNCTION(Mesh_AddColor_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addTexCoord(float, float)", asFUNCTION(Mesh_AddTexCoord_2f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addTexCoord(const Vec2 &in)", asFUNCTION(Mesh_AddTexCoord_Vec2), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addNormal(float, float, float)", asFUNCTION(Mesh_AddNormal_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addNormal(const Vec3 &in)", asFUNCTION(Mesh_AddNormal_Vec3), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addIndex(uint)", asFUNCTION(Mesh_AddIndex), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addTriangle(uint, uint, uint)", asFUNCTION(Mesh_AddTriangle), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ clear()", asFUNCTION(Mesh_Clear), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "void draw()", asFUNCTION(Mesh_Draw), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "void drawWireframe()", asFUNCTION(Mesh_DrawWireframe), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "int getNumVertices() const", asFUNCTION(Mesh_GetNumVertices), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "int getNumIndices() const", asFUNCTION(Mesh_GetNumIndices), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "int getNumColors() const", asFUNCTION(Mesh_GetNumColors), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "int getNumNormals() const", asFUNCTION(Mesh_GetNumNormals), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "bool hasColors() const", asFUNCTION(Mesh_HasColors), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "bool hasIndices() const", asFUNCTION(Mesh_HasIndices), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "bool hasNormals() const", asFUNCTION(Mesh_HasNormals), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "bool hasTexCoords() const", asFUNCTION(Mesh_HasTexCoords), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ translate(float, float, float)", asFUNCTION(Mesh_Translate_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ translate(const Vec3 &in)", asFUNCTION(Mesh_Translate_Vec3), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ rotateX(float)", asFUNCTION(Mesh_RotateX), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ rotateY(float)", asFUNCTION(Mesh_RotateY), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ rotateZ(float)", asFUNCTION(Mesh_RotateZ), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ scale(float)", asFUNCTION(Mesh_Scale_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ scale(float, float, float)", asFUNCTION(Mesh_Scale_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addVertices(array<Vec3>@)", asFUNCTION(Mesh_AddVertices_Vec3Array), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addVertices(array<Vec2>@)", asFUNCTION(Mesh_AddVertices_Vec2Array), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addColors(array<Color>@)", asFUNCTION(Mesh_AddColors_Array), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addIndices(array<uint>@)", asFUNCTION(Mesh_AddIndices_Array), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addNormals(array<Vec3>@)", asFUNCTION(Mesh_AddNormals_Array), asCALL_GENERIC); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("Mesh@ createMesh()", AS_GENERIC(Mesh_Factory)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("Mesh@ createTempMesh()", AS_GENERIC(Mesh_TempFactory)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ setMode(PrimitiveMode)", AS_GENERIC(Mesh_SetMode)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "int getMode() const", AS_GENERIC(Mesh_GetMode)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addVertex(float, float, float)", AS_GENERIC(Mesh_AddVertex_3f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addVertex(float, float)", AS_GENERIC(Mesh_AddVertex_2f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addVertex(const Vec3 &in)", AS_GENERIC(Mesh_AddVertex_Vec3)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addVertex(const Vec2 &in)", AS_GENERIC(Mesh_AddVertex_Vec2)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addColor(const Color &in)", AS_GENERIC(Mesh_AddColor_Color)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addColor(float, float, float, float)", AS_GENERIC(Mesh_AddColor_4f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addColor(float, float, float)", AS_GENERIC(Mesh_AddColor_3f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addTexCoord(float, float)", AS_GENERIC(Mesh_AddTexCoord_2f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addTexCoord(const Vec2 &in)", AS_GENERIC(Mesh_AddTexCoord_Vec2)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addNormal(float, float, float)", AS_GENERIC(Mesh_AddNormal_3f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addNormal(const Vec3 &in)", AS_GENERIC(Mesh_AddNormal_Vec3)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addIndex(uint)", AS_GENERIC(Mesh_AddIndex)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addTriangle(uint, uint, uint)", AS_GENERIC(Mesh_AddTriangle)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ clear()", AS_GENERIC(Mesh_Clear)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "void draw()", AS_GENERIC(Mesh_Draw)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "void drawWireframe()", AS_GENERIC(Mesh_DrawWireframe)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "int getNumVertices() const", AS_GENERIC(Mesh_GetNumVertices)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "int getNumIndices() const", AS_GENERIC(Mesh_GetNumIndices)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "int getNumColors() const", AS_GENERIC(Mesh_GetNumColors)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "int getNumNormals() const", AS_GENERIC(Mesh_GetNumNormals)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "bool hasColors() const", AS_GENERIC(Mesh_HasColors)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "bool hasIndices() const", AS_GENERIC(Mesh_HasIndices)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "bool hasNormals() const", AS_GENERIC(Mesh_HasNormals)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "bool hasTexCoords() const", AS_GENERIC(Mesh_HasTexCoords)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ translate(float, float, float)", AS_GENERIC(Mesh_Translate_3f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ translate(const Vec3 &in)", AS_GENERIC(Mesh_Translate_Vec3)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ rotateX(float)", AS_GENERIC(Mesh_RotateX)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ rotateY(float)", AS_GENERIC(Mesh_RotateY)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ rotateZ(float)", AS_GENERIC(Mesh_RotateZ)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ scale(float)", AS_GENERIC(Mesh_Scale_1f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ scale(float, float, float)", AS_GENERIC(Mesh_Scale_3f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addVertices(array<Vec3>@)", AS_GENERIC(Mesh_AddVertices_Vec3Array)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addVertices(array<Vec2>@)", AS_GENERIC(Mesh_AddVertices_Vec2Array)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addVertices(FloatBuffer@, int = 2)", AS_GENERIC(Mesh_AddVertices_Buffer)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addColors(array<Color>@)", AS_GENERIC(Mesh_AddColors_Array)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addIndices(array<uint>@)", AS_GENERIC(Mesh_AddIndices_Array)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Mesh", "Mesh@ addNormals(array<Vec3>@)", AS_GENERIC(Mesh_AddNormals_Array)); assert(r >= 0);
 
     // Path (Polyline) methods
-    r = engine_->RegisterGlobalFunction("Path@ createPath()", asFUNCTION(Path_Factory), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Path", "Path@ addVertex(float, float)", asFUNCTION(Path_AddVertex_2f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Path", "Path@ addVertex(float, float, float)", asFUNCTION(Path_AddVertex_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Path", "Path@ addVertex(const Vec2 &in)", asFUNCTION(Path_AddVertex_Vec2), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Path", "Path@ addVertex(const Vec3 &in)", asFUNCTION(Path_AddVertex_Vec3), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Path", "Path@ addVertices(array<Vec3>@)", asFUNCTION(Path_AddVertices_Vec3Array), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Path", "Path@ addVertices(array<Vec2>@)", asFUNCTION(Path_AddVertices_Vec2Array), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Path", "Path@ lineTo(float, float)", asFUNCTION(Path_LineTo_2f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Path", "Path@ lineTo(const Vec2 &in)", asFUNCTION(Path_LineTo_Vec2), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Path", "Path@ bezierTo(float, float, float, float, float, float)", asFUNCTION(Path_BezierTo_6f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Path", "Path@ quadBezierTo(float, float, float, float)", asFUNCTION(Path_QuadBezierTo_4f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Path", "Path@ curveTo(float, float)", asFUNCTION(Path_CurveTo_2f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Path", "Path@ curveTo(float, float, float)", asFUNCTION(Path_CurveTo_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Path", "Path@ arc(float, float, float, float, float, float)", asFUNCTION(Path_Arc_6f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Path", "Path@ close()", asFUNCTION(Path_Close), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Path", "Path@ setClosed(bool)", asFUNCTION(Path_SetClosed), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Path", "bool isClosed() const", asFUNCTION(Path_IsClosed), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Path", "Path@ clear()", asFUNCTION(Path_Clear), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Path", "void draw()", asFUNCTION(Path_Draw), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Path", "int size() const", asFUNCTION(Path_Size), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Path", "bool empty() const", asFUNCTION(Path_Empty), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Path", "float getPerimeter() const", asFUNCTION(Path_GetPerimeter), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Path", "Rect getBounds() const", asFUNCTION(Path_GetBounds), asCALL_GENERIC); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("Path@ createPath()", AS_GENERIC(Path_Factory)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("Path@ createTempPath()", AS_GENERIC(Path_TempFactory)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Path", "Path@ addVertex(float, float)", AS_GENERIC(Path_AddVertex_2f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Path", "Path@ addVertex(float, float, float)", AS_GENERIC(Path_AddVertex_3f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Path", "Path@ addVertex(const Vec2 &in)", AS_GENERIC(Path_AddVertex_Vec2)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Path", "Path@ addVertex(const Vec3 &in)", AS_GENERIC(Path_AddVertex_Vec3)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Path", "Path@ addVertices(array<Vec3>@)", AS_GENERIC(Path_AddVertices_Vec3Array)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Path", "Path@ addVertices(array<Vec2>@)", AS_GENERIC(Path_AddVertices_Vec2Array)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Path", "Path@ lineTo(float, float)", AS_GENERIC(Path_LineTo_2f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Path", "Path@ lineTo(const Vec2 &in)", AS_GENERIC(Path_LineTo_Vec2)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Path", "Path@ bezierTo(float, float, float, float, float, float)", AS_GENERIC(Path_BezierTo_6f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Path", "Path@ quadBezierTo(float, float, float, float)", AS_GENERIC(Path_QuadBezierTo_4f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Path", "Path@ curveTo(float, float)", AS_GENERIC(Path_CurveTo_2f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Path", "Path@ curveTo(float, float, float)", AS_GENERIC(Path_CurveTo_3f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Path", "Path@ arc(float, float, float, float, float, float)", AS_GENERIC(Path_Arc_6f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Path", "Path@ close()", AS_GENERIC(Path_Close)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Path", "Path@ setClosed(bool)", AS_GENERIC(Path_SetClosed)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Path", "bool isClosed() const", AS_GENERIC(Path_IsClosed)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Path", "Path@ clear()", AS_GENERIC(Path_Clear)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Path", "void draw()", AS_GENERIC(Path_Draw)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Path", "int size() const", AS_GENERIC(Path_Size)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Path", "bool empty() const", AS_GENERIC(Path_Empty)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Path", "float getPerimeter() const", AS_GENERIC(Path_GetPerimeter)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Path", "Rect getBounds() const", AS_GENERIC(Path_GetBounds)); assert(r >= 0);
 
     // StrokeMesh methods
-    r = engine_->RegisterGlobalFunction("StrokeMesh@ createStrokeMesh()", asFUNCTION(StrokeMesh_Factory), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& setWidth(float)", asFUNCTION(StrokeMesh_SetWidth), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& setColor(const Color &in)", asFUNCTION(StrokeMesh_SetColor), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& setCapType(int)", asFUNCTION(StrokeMesh_SetCapType), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& setJoinType(int)", asFUNCTION(StrokeMesh_SetJoinType), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& setMiterLimit(float)", asFUNCTION(StrokeMesh_SetMiterLimit), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& addVertex(float, float)", asFUNCTION(StrokeMesh_AddVertex_2f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& addVertex(float, float, float)", asFUNCTION(StrokeMesh_AddVertex_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& addVertex(const Vec2 &in)", asFUNCTION(StrokeMesh_AddVertex_Vec2), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& addVertex(const Vec3 &in)", asFUNCTION(StrokeMesh_AddVertex_Vec3), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& addVertexWithWidth(float, float, float)", asFUNCTION(StrokeMesh_AddVertexWithWidth_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& setShape(Path@)", asFUNCTION(StrokeMesh_SetShape), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& setClosed(bool)", asFUNCTION(StrokeMesh_SetClosed), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& clear()", asFUNCTION(StrokeMesh_Clear), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("StrokeMesh", "void update()", asFUNCTION(StrokeMesh_Update), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("StrokeMesh", "void draw()", asFUNCTION(StrokeMesh_Draw), asCALL_GENERIC); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("StrokeMesh@ createStrokeMesh()", AS_GENERIC(StrokeMesh_Factory)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& setWidth(float)", AS_GENERIC(StrokeMesh_SetWidth)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& setColor(const Color &in)", AS_GENERIC(StrokeMesh_SetColor)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& setCapType(int)", AS_GENERIC(StrokeMesh_SetCapType)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& setJoinType(int)", AS_GENERIC(StrokeMesh_SetJoinType)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& setMiterLimit(float)", AS_GENERIC(StrokeMesh_SetMiterLimit)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& addVertex(float, float)", AS_GENERIC(StrokeMesh_AddVertex_2f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& addVertex(float, float, float)", AS_GENERIC(StrokeMesh_AddVertex_3f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& addVertex(const Vec2 &in)", AS_GENERIC(StrokeMesh_AddVertex_Vec2)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& addVertex(const Vec3 &in)", AS_GENERIC(StrokeMesh_AddVertex_Vec3)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& addVertexWithWidth(float, float, float)", AS_GENERIC(StrokeMesh_AddVertexWithWidth_3f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& setShape(Path@)", AS_GENERIC(StrokeMesh_SetShape)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& setClosed(bool)", AS_GENERIC(StrokeMesh_SetClosed)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("StrokeMesh", "StrokeMesh& clear()", AS_GENERIC(StrokeMesh_Clear)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("StrokeMesh", "void update()", AS_GENERIC(StrokeMesh_Update)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("StrokeMesh", "void draw()", AS_GENERIC(StrokeMesh_Draw)); assert(r >= 0);
+
+    // DisplayList methods
+    r = engine_->RegisterGlobalFunction("DisplayList@ createDisplayList()", AS_GENERIC(DisplayList_Factory)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("DisplayList", "void begin()", AS_GENERIC(DisplayList_Begin)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("DisplayList", "void end()", AS_GENERIC(DisplayList_End)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("DisplayList", "bool isRecording() const", AS_GENERIC(DisplayList_IsRecording)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("DisplayList", "void draw() const", AS_GENERIC(DisplayList_Draw)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("DisplayList", "void clear()", AS_GENERIC(DisplayList_Clear)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("DisplayList", "int size() const", AS_GENERIC(DisplayList_Size)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("DisplayList", "bool bake()", AS_GENERIC(DisplayList_Bake)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("DisplayList", "bool isBaked() const", AS_GENERIC(DisplayList_IsBaked)); assert(r >= 0);
+
+    // ParticleSystem methods (columns are FloatBuffers with one value per live particle)
+    r = engine_->RegisterEnum("ParticleColumn"); assert(r >= 0);
+    r = engine_->RegisterEnumValue("ParticleColumn", "PosX", tcParticleSystem::PosX); assert(r >= 0);
+    r = engine_->RegisterEnumValue("ParticleColumn", "PosY", tcParticleSystem::PosY); assert(r >= 0);
+    r = engine_->RegisterEnumValue("ParticleColumn", "VelX", tcParticleSystem::VelX); assert(r >= 0);
+    r = engine_->RegisterEnumValue("ParticleColumn", "VelY", tcParticleSystem::VelY); assert(r >= 0);
+    r = engine_->RegisterEnumValue("ParticleColumn", "Age", tcParticleSystem::Age); assert(r >= 0);
+    r = engine_->RegisterEnumValue("ParticleColumn", "Life", tcParticleSystem::Life); assert(r >= 0);
+    r = engine_->RegisterEnumValue("ParticleColumn", "Size", tcParticleSystem::Size); assert(r >= 0);
+    r = engine_->RegisterEnumValue("ParticleColumn", "ColorR", tcParticleSystem::ColorR); assert(r >= 0);
+    r = engine_->RegisterEnumValue("ParticleColumn", "ColorG", tcParticleSystem::ColorG); assert(r >= 0);
+    r = engine_->RegisterEnumValue("ParticleColumn", "ColorB", tcParticleSystem::ColorB); assert(r >= 0);
+    r = engine_->RegisterEnumValue("ParticleColumn", "ColorA", tcParticleSystem::ColorA); assert(r >= 0);
+    r = engine_->RegisterFuncdef("void ParticleBatchFunc(ParticleSystem@, int, int)"); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("ParticleSystem@ createParticleSystem()", AS_GENERIC(ParticleSystem_Factory)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("ParticleSystem@ createParticleSystem(int)", AS_GENERIC(ParticleSystem_Factory_1i)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ParticleSystem", "int emit(int, float, float)", AS_GENERIC(ParticleSystem_Emit)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ParticleSystem", "void update(float)", AS_GENERIC(ParticleSystem_Update)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ParticleSystem", "void draw() const", AS_GENERIC(ParticleSystem_Draw)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ParticleSystem", "void clear()", AS_GENERIC(ParticleSystem_Clear)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ParticleSystem", "int size() const", AS_GENERIC(ParticleSystem_Size)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ParticleSystem", "void setMaxParticles(int)", AS_GENERIC(ParticleSystem_SetMaxParticles)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ParticleSystem", "int getMaxParticles() const", AS_GENERIC(ParticleSystem_GetMaxParticles)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ParticleSystem", "void setSpeed(float, float)", AS_GENERIC(ParticleSystem_SetSpeed)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ParticleSystem", "void setDirection(float, float)", AS_GENERIC(ParticleSystem_SetDirection)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ParticleSystem", "void setLife(float, float)", AS_GENERIC(ParticleSystem_SetLife)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ParticleSystem", "void setSize(float, float)", AS_GENERIC(ParticleSystem_SetSize)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ParticleSystem", "void setColor(const Color &in)", AS_GENERIC(ParticleSystem_SetColor)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ParticleSystem", "void setGravity(float, float)", AS_GENERIC(ParticleSystem_SetGravity)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ParticleSystem", "void setDrag(float)", AS_GENERIC(ParticleSystem_SetDrag)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ParticleSystem", "void setNoiseForce(float, float)", AS_GENERIC(ParticleSystem_SetNoiseForce)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ParticleSystem", "void setFadeOut(bool)", AS_GENERIC(ParticleSystem_SetFadeOut)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ParticleSystem", "void setResolution(int)", AS_GENERIC(ParticleSystem_SetResolution)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ParticleSystem", "FloatBuffer@ getColumn(ParticleColumn)", AS_GENERIC(ParticleSystem_GetColumn)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ParticleSystem", "void setOnEmit(ParticleBatchFunc@)", AS_GENERIC(ParticleSystem_SetOnEmit)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ParticleSystem", "void setOnUpdate(ParticleBatchFunc@)", AS_GENERIC(ParticleSystem_SetOnUpdate)); assert(r >= 0);
 
     // Image methods
-    r = engine_->RegisterGlobalFunction("Image@ createImage()", asFUNCTION(Image_Factory), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Image", "bool load(const string &in)", asFUNCTION(Image_Load), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Image", "bool save(const string &in)", asFUNCTION(Image_Save), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Image", "void allocate(int, int)", asFUNCTION(Image_Allocate_2i), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Image", "void allocate(int, int, int)", asFUNCTION(Image_Allocate_3i), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Image", "void clear()", asFUNCTION(Image_Clear), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Image", "bool isAllocated() const", asFUNCTION(Image_IsAllocated), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Image", "int getWidth() const", asFUNCTION(Image_GetWidth), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Image", "int getHeight() const", asFUNCTION(Image_GetHeight), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Image", "int getChannels() const", asFUNCTION(Image_GetChannels), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Image", "Pixels@ getPixels()", asFUNCTION(Image_GetPixels), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Image", "Color getColor(int, int) const", asFUNCTION(Image_GetColor), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Image", "void setColor(int, int, const Color &in)", asFUNCTION(Image_SetColor), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Image", "void update()", asFUNCTION(Image_Update), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Image", "void setDirty()", asFUNCTION(Image_SetDirty), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Image", "Texture@ getTexture()", asFUNCTION(Image_GetTexture), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Image", "void draw()", asFUNCTION(Image_Draw_0), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Image", "void draw(float, float)", asFUNCTION(Image_Draw_2f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Image", "void draw(float, float, float, float)", asFUNCTION(Image_Draw_4f), asCALL_GENERIC); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("Image@ createImage()", AS_GENERIC(Image_Factory)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Image", "bool load(const string &in)", AS_GENERIC(Image_Load)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Image", "void loadAsync(const string &in, LoadCallback@ = null)", AS_GENERIC(Image_LoadAsync)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Image", "bool isLoading() const", AS_GENERIC(Image_IsLoading)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Image", "bool save(const string &in)", AS_GENERIC(Image_Save)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Image", "void allocate(int, int)", AS_GENERIC(Image_Allocate_2i)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Image", "void allocate(int, int, int)", AS_GENERIC(Image_Allocate_3i)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Image", "void clear()", AS_GENERIC(Image_Clear)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Image", "bool isAllocated() const", AS_GENERIC(Image_IsAllocated)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Image", "int getWidth() const", AS_GENERIC(Image_GetWidth)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Image", "int getHeight() const", AS_GENERIC(Image_GetHeight)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Image", "int getChannels() const", AS_GENERIC(Image_GetChannels)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Image", "Pixels@ getPixels()", AS_GENERIC(Image_GetPixels)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Image", "Color getColor(int, int) const", AS_GENERIC(Image_GetColor)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Image", "void setColor(int, int, const Color &in)", AS_GENERIC(Image_SetColor)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Image", "void update()", AS_GENERIC(Image_Update)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Image", "void setDirty()", AS_GENERIC(Image_SetDirty)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Image", "Texture@ getTexture()", AS_GENERIC(Image_GetTexture)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Image", "void draw()", AS_GENERIC(Image_Draw_0)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Image", "void draw(float, float)", AS_GENERIC(Image_Draw_2f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Image", "void draw(float, float, float, float)", AS_GENERIC(Image_Draw_4f)); assert(r >= 0);
 
     // EasyCam methods
-    r = engine_->RegisterGlobalFunction("EasyCam@ createEasyCam()", asFUNCTION(EasyCam_Factory), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("EasyCam", "void begin()", asFUNCTION(EasyCam_Begin), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("EasyCam", "void end()", asFUNCTION(EasyCam_End), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("EasyCam", "void reset()", asFUNCTION(EasyCam_Reset), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("EasyCam", "void setTarget(float, float, float)", asFUNCTION(EasyCam_SetTarget_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("EasyCam", "void setTarget(const Vec3 &in)", asFUNCTION(EasyCam_SetTarget_Vec3), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("EasyCam", "Vec3 getTarget() const", asFUNCTION(EasyCam_GetTarget), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("EasyCam", "void setDistance(float)", asFUNCTION(EasyCam_SetDistance), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("EasyCam", "float getDistance() const", asFUNCTION(EasyCam_GetDistance), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("EasyCam", "void setFov(float)", asFUNCTION(EasyCam_SetFov), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("EasyCam", "float getFov() const", asFUNCTION(EasyCam_GetFov), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("EasyCam", "void setFovDeg(float)", asFUNCTION(EasyCam_SetFovDeg), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("EasyCam", "void setNearClip(float)", asFUNCTION(EasyCam_SetNearClip), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("EasyCam", "void setFarClip(float)", asFUNCTION(EasyCam_SetFarClip), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("EasyCam", "void enableMouseInput()", asFUNCTION(EasyCam_EnableMouseInput), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("EasyCam", "void disableMouseInput()", asFUNCTION(EasyCam_DisableMouseInput), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("EasyCam", "bool isMouseInputEnabled() const", asFUNCTION(EasyCam_IsMouseInputEnabled), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("EasyCam", "void mousePressed(int, int, int)", asFUNCTION(EasyCam_MousePressed), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("EasyCam", "void mouseReleased(int, int, int)", asFUNCTION(EasyCam_MouseReleased), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("EasyCam", "void mouseDragged(int, int, int)", asFUNCTION(EasyCam_MouseDragged), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("EasyCam", "void mouseScrolled(float, float)", asFUNCTION(EasyCam_MouseScrolled), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("EasyCam", "Vec3 getPosition() const", asFUNCTION(EasyCam_GetPosition), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("EasyCam", "void setSensitivity(float)", asFUNCTION(EasyCam_SetSensitivity), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("EasyCam", "void setZoomSensitivity(float)", asFUNCTION(EasyCam_SetZoomSensitivity), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("EasyCam", "void setPanSensitivity(float)", asFUNCTION(EasyCam_SetPanSensitivity), asCALL_GENERIC); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("EasyCam@ createEasyCam()", AS_GENERIC(EasyCam_Factory)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("EasyCam", "void begin()", AS_GENERIC(EasyCam_Begin)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("EasyCam", "void end()", AS_GENERIC(EasyCam_End)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("EasyCam", "void reset()", AS_GENERIC(EasyCam_Reset)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("EasyCam", "void setTarget(float, float, float)", AS_GENERIC(EasyCam_SetTarget_3f)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("EasyCam", "void setTarget(const Vec3 &in)", AS_GENERIC(EasyCam_SetTarget_Vec3)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("EasyCam", "Vec3 getTarget() const", AS_GENERIC(EasyCam_GetTarget)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("EasyCam", "void setDistance(float)", AS_GENERIC(EasyCam_SetDistance)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("EasyCam", "float getDistance() const", AS_GENERIC(EasyCam_GetDistance)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("EasyCam", "void setFov(float)", AS_GENERIC(EasyCam_SetFov)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("EasyCam", "float getFov() const", AS_GENERIC(EasyCam_GetFov)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("EasyCam", "void setFovDeg(float)", AS_GENERIC(EasyCam_SetFovDeg)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("EasyCam", "void setNearClip(float)", AS_GENERIC(EasyCam_SetNearClip)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("EasyCam", "void setFarClip(float)", AS_GENERIC(EasyCam_SetFarClip)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("EasyCam", "void enableMouseInput()", AS_GENERIC(EasyCam_EnableMouseInput)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("EasyCam", "void disableMouseInput()", AS_GENERIC(EasyCam_DisableMouseInput)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("EasyCam", "bool isMouseInputEnabled() const", AS_GENERIC(EasyCam_IsMouseInputEnabled)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("EasyCam", "void mousePressed(int, int, int)", AS_GENERIC(EasyCam_MousePressed)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("EasyCam", "void mouseReleased(int, int, int)", AS_GENERIC(EasyCam_MouseReleased)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("EasyCam", "void mouseDragged(int, int, int)", AS_GENERIC(EasyCam_MouseDragged)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("EasyCam", "void mouseScrolled(float, float)", AS_GENERIC(EasyCam_MouseScrolled)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("EasyCam", "Vec3 getPosition() const", AS_GENERIC(EasyCam_GetPosition)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("EasyCam", "void setSensitivity(float)", AS_GENERIC(EasyCam_SetSensitivity)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("EasyCam", "void setZoomSensitivity(float)", AS_GENERIC(EasyCam_SetZoomSensitivity)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("EasyCam", "void setPanSensitivity(float)", AS_GENERIC(EasyCam_SetPanSensitivity)); assert(r >= 0);
 
     // Sound methods
-    r = engine_->RegisterGlobalFunction("Sound@ createSound()", asFUNCTION(Sound_Factory), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Sound", "bool load(const string &in)", asFUNCTION(Sound_Load), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Sound", "void play()", asFUNCTION(Sound_Play), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Sound", "void stop()", asFUNCTION(Sound_Stop), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Sound", "bool isLoaded() const", asFUNCTION(Sound_IsLoaded), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Sound", "bool isPlaying() const", asFUNCTION(Sound_IsPlaying), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Sound", "void setVolume(float)", asFUNCTION(Sound_SetVolume), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Sound", "void setLoop(bool)", asFUNCTION(Sound_SetLoop), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Sound", "bool isLoop() const", asFUNCTION(Sound_IsLoop), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Sound", "void setPan(float)", asFUNCTION(Sound_SetPan), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Sound", "float getPan() const", asFUNCTION(Sound_GetPan), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Sound", "void setSpeed(float)", asFUNCTION(Sound_SetSpeed), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Sound", "float getSpeed() const", asFUNCTION(Sound_GetSpeed), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Sound", "void pause()", asFUNCTION(Sound_Pause), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Sound", "void resume()", asFUNCTION(Sound_Resume), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Sound", "bool isPaused() const", asFUNCTION(Sound_IsPaused), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Sound", "float getPosition() const", asFUNCTION(Sound_GetPosition), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Sound", "float getDuration() const", asFUNCTION(Sound_GetDuration), asCALL_GENERIC); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("Sound@ createSound()", AS_GENERIC(Sound_Factory)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sound", "bool load(const string &in)", AS_GENERIC(Sound_Load)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sound", "void loadAsync(const string &in, LoadCallback@ = null)", AS_GENERIC(Sound_LoadAsync)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sound", "bool isLoading() const", AS_GENERIC(Sound_IsLoading)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sound", "void play()", AS_GENERIC(Sound_Play)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sound", "void stop()", AS_GENERIC(Sound_Stop)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sound", "bool isLoaded() const", AS_GENERIC(Sound_IsLoaded)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sound", "bool isPlaying() const", AS_GENERIC(Sound_IsPlaying)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sound", "void setVolume(float)", AS_GENERIC(Sound_SetVolume)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sound", "void setLoop(bool)", AS_GENERIC(Sound_SetLoop)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sound", "bool isLoop() const", AS_GENERIC(Sound_IsLoop)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sound", "void setPan(float)", AS_GENERIC(Sound_SetPan)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sound", "float getPan() const", AS_GENERIC(Sound_GetPan)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sound", "void setSpeed(float)", AS_GENERIC(Sound_SetSpeed)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sound", "float getSpeed() const", AS_GENERIC(Sound_GetSpeed)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sound", "void pause()", AS_GENERIC(Sound_Pause)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sound", "void resume()", AS_GENERIC(Sound_Resume)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sound", "bool isPaused() const", AS_GENERIC(Sound_IsPaused)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sound", "float getPosition() const", AS_GENERIC(Sound_GetPosition)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sound", "float getDuration() const", AS_GENERIC(Sound_GetDuration)); assert(r >= 0);
 
     // Wave enum constants
     r = engine_->RegisterEnumValue("Wave", "Sin", kWaveSin); assert(r >= 0);
@@ -2602,224 +4086,312 @@ void tcScriptHost::registerTrussCFunctions() {
     r = engine_->RegisterEnumValue("Wave", "Silent", kWaveSilent); assert(r >= 0);
 
     // ChipSoundNote methods (value type with chaining)
-    r = engine_->RegisterObjectMethod("ChipSoundNote", "Sound@ build()", asFUNCTION(ChipNote_Build), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("ChipSoundNote", "ChipSoundNote& wave(Wave)", asFUNCTION(ChipNote_SetWave), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("ChipSoundNote", "ChipSoundNote& hz(float)", asFUNCTION(ChipNote_SetHz), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("ChipSoundNote", "ChipSoundNote& volume(float)", asFUNCTION(ChipNote_SetVolume), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("ChipSoundNote", "ChipSoundNote& duration(float)", asFUNCTION(ChipNote_SetDuration), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("ChipSoundNote", "ChipSoundNote& attack(float)", asFUNCTION(ChipNote_SetAttack), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("ChipSoundNote", "ChipSoundNote& decay(float)", asFUNCTION(ChipNote_SetDecay), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("ChipSoundNote", "ChipSoundNote& sustain(float)", asFUNCTION(ChipNote_SetSustain), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("ChipSoundNote", "ChipSoundNote& release(float)", asFUNCTION(ChipNote_SetRelease), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("ChipSoundNote", "ChipSoundNote& adsr(float, float, float, float)", asFUNCTION(ChipNote_SetADSR), asCALL_GENERIC); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ChipSoundNote", "Sound@ build()", AS_GENERIC(ChipNote_Build)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ChipSoundNote", "ChipSoundNote& wave(Wave)", AS_GENERIC(ChipNote_SetWave)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ChipSoundNote", "ChipSoundNote& hz(float)", AS_GENERIC(ChipNote_SetHz)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ChipSoundNote", "ChipSoundNote& volume(float)", AS_GENERIC(ChipNote_SetVolume)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ChipSoundNote", "ChipSoundNote& duration(float)", AS_GENERIC(ChipNote_SetDuration)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ChipSoundNote", "ChipSoundNote& attack(float)", AS_GENERIC(ChipNote_SetAttack)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ChipSoundNote", "ChipSoundNote& decay(float)", AS_GENERIC(ChipNote_SetDecay)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ChipSoundNote", "ChipSoundNote& sustain(float)", AS_GENERIC(ChipNote_SetSustain)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ChipSoundNote", "ChipSoundNote& release(float)", AS_GENERIC(ChipNote_SetRelease)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ChipSoundNote", "ChipSoundNote& adsr(float, float, float, float)", AS_GENERIC(ChipNote_SetADSR)); assert(r >= 0);
 
     // ChipSoundBundle methods (reference type)
-    r = engine_->RegisterGlobalFunction("ChipSoundBundle@ createChipBundle()", asFUNCTION(ChipBundle_Factory), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("ChipSoundBundle", "ChipSoundBundle& add(const ChipSoundNote &in, float)", asFUNCTION(ChipBundle_Add), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("ChipSoundBundle", "ChipSoundBundle& add(Wave, float, float, float, float)", asFUNCTION(ChipBundle_Add_5), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("ChipSoundBundle", "void clear()", asFUNCTION(ChipBundle_Clear), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("ChipSoundBundle", "float getDuration() const", asFUNCTION(ChipBundle_GetDuration), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("ChipSoundBundle", "ChipSoundBundle& volume(float)", asFUNCTION(ChipBundle_SetVolume), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("ChipSoundBundle", "Sound@ build()", asFUNCTION(ChipBundle_Build), asCALL_GENERIC); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("ChipSoundBundle@ createChipBundle()", AS_GENERIC(ChipBundle_Factory)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ChipSoundBundle", "ChipSoundBundle& add(const ChipSoundNote &in, float)", AS_GENERIC(ChipBundle_Add)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ChipSoundBundle", "ChipSoundBundle& add(Wave, float, float, float, float)", AS_GENERIC(ChipBundle_Add_5)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ChipSoundBundle", "void clear()", AS_GENERIC(ChipBundle_Clear)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ChipSoundBundle", "float getDuration() const", AS_GENERIC(ChipBundle_GetDuration)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ChipSoundBundle", "ChipSoundBundle& volume(float)", AS_GENERIC(ChipBundle_SetVolume)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ChipSoundBundle", "Sound@ build()", AS_GENERIC(ChipBundle_Build)); assert(r >= 0);
+
+    // ChipSynth methods (notes are rendered in the audio callback)
+    r = engine_->RegisterGlobalFunction("ChipSynth@ createChipSynth(int = 16)", AS_GENERIC(ChipSynth_Factory)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ChipSynth", "bool play(const ChipSoundNote &in, float = 0)", AS_GENERIC(ChipSynth_Play)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ChipSynth", "void stopAll()", AS_GENERIC(ChipSynth_StopAll)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ChipSynth", "void setVolume(float)", AS_GENERIC(ChipSynth_SetVolume)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ChipSynth", "float getVolume() const", AS_GENERIC(ChipSynth_GetVolume)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ChipSynth", "int getVoiceCount() const", AS_GENERIC(ChipSynth_GetVoiceCount)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ChipSynth", "int getActiveVoices() const", AS_GENERIC(ChipSynth_GetActiveVoices)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("ChipSynth", "double getTime() const", AS_GENERIC(ChipSynth_GetTime)); assert(r >= 0);
+
+    // Sequencer methods (event times in beats)
+    r = engine_->RegisterGlobalFunction("Sequencer@ createSequencer(ChipSynth@ = null, float = 120)", AS_GENERIC(Sequencer_Factory)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sequencer", "Sequencer& add(const ChipSoundNote &in, float)", AS_GENERIC(Sequencer_Add)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sequencer", "Sequencer& add(Wave, float, float, float, float)", AS_GENERIC(Sequencer_Add_5)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sequencer", "Sequencer& add(Sound@, float)", AS_GENERIC(Sequencer_Add_Sound)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sequencer", "void clear()", AS_GENERIC(Sequencer_Clear)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sequencer", "void setBpm(float)", AS_GENERIC(Sequencer_SetBpm)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sequencer", "float getBpm() const", AS_GENERIC(Sequencer_GetBpm)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sequencer", "void setLoop(float)", AS_GENERIC(Sequencer_SetLoop)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sequencer", "float getLoop() const", AS_GENERIC(Sequencer_GetLoop)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sequencer", "void setLookahead(float)", AS_GENERIC(Sequencer_SetLookahead)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sequencer", "float getLookahead() const", AS_GENERIC(Sequencer_GetLookahead)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sequencer", "void start()", AS_GENERIC(Sequencer_Start)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sequencer", "void stop()", AS_GENERIC(Sequencer_Stop)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sequencer", "bool isPlaying() const", AS_GENERIC(Sequencer_IsPlaying)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Sequencer", "double getBeat() const", AS_GENERIC(Sequencer_GetBeat)); assert(r >= 0);
 
     // Font methods
-    r = engine_->RegisterGlobalFunction("Font@ createFont()", asFUNCTION(Font_Factory), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Font", "bool load(const string &in, int)", asFUNCTION(Font_Load), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Font", "bool isLoaded() const", asFUNCTION(Font_IsLoaded), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Font", "void drawString(const string &in, float, float)", asFUNCTION(Font_DrawString_3), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Font", "float getWidth(const string &in) const", asFUNCTION(Font_GetWidth), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Font", "float getHeight(const string &in) const", asFUNCTION(Font_GetHeight), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Font", "float getLineHeight() const", asFUNCTION(Font_GetLineHeight), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Font", "int getSize() const", asFUNCTION(Font_GetSize), asCALL_GENERIC); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("Font@ createFont()", AS_GENERIC(Font_Factory)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Font", "bool load(const string &in, int)", AS_GENERIC(Font_Load)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Font", "void loadAsync(const string &in, int, LoadCallback@ = null)", AS_GENERIC(Font_LoadAsync)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Font", "bool isLoading() const", AS_GENERIC(Font_IsLoading)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Font", "bool isLoaded() const", AS_GENERIC(Font_IsLoaded)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Font", "void drawString(const string &in, float, float)", AS_GENERIC(Font_DrawString_3)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Font", "float getWidth(const string &in) const", AS_GENERIC(Font_GetWidth)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Font", "float getHeight(const string &in) const", AS_GENERIC(Font_GetHeight)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Font", "float getLineHeight() const", AS_GENERIC(Font_GetLineHeight)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Font", "int getSize() const", AS_GENERIC(Font_GetSize)); assert(r >= 0);
 
     // Font path constants (Web uses CDN URLs)
     r = engine_->RegisterGlobalProperty("const string FONT_SANS", (void*)&fontSans); assert(r >= 0);
     r = engine_->RegisterGlobalProperty("const string FONT_SERIF", (void*)&fontSerif); assert(r >= 0);
     r = engine_->RegisterGlobalProperty("const string FONT_MONO", (void*)&fontMono); assert(r >= 0);
 
+    category("graphics");
     // =========================================================================
     // Graphics - Clear & Color
     // =========================================================================
-    r = engine_->RegisterGlobalFunction("void clear(float)", asFUNCTION(as_clear_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void clear(float, float, float)", asFUNCTION(as_clear_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void setColor(float)", asFUNCTION(as_setColor_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void setColor(float, float, float)", asFUNCTION(as_setColor_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void setColor(float, float, float, float)", asFUNCTION(as_setColor_4f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void setColorHSB(float, float, float)", asFUNCTION(as_setColorHSB_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void setColorOKLCH(float, float, float)", asFUNCTION(as_setColorOKLCH_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void setColorOKLab(float, float, float)", asFUNCTION(as_setColorOKLab_3f), asCALL_GENERIC); assert(r >= 0);
+    r = bind.function<as_clear_1f>("void clear(float)"); assert(r >= 0);
+    r = bind.function<as_clear_3f>("void clear(float, float, float)"); assert(r >= 0);
+    r = bind.function<as_setColor_1f>("void setColor(float)"); assert(r >= 0);
+    r = bind.function<as_setColor_3f>("void setColor(float, float, float)"); assert(r >= 0);
+    r = bind.function<as_setColor_4f>("void setColor(float, float, float, float)"); assert(r >= 0);
+    r = bind.function<as_setColorHSB_3f>("void setColorHSB(float, float, float)"); assert(r >= 0);
+    r = bind.function<as_setColorOKLCH_3f>("void setColorOKLCH(float, float, float)"); assert(r >= 0);
+    r = bind.function<as_setColorOKLab_3f>("void setColorOKLab(float, float, float)"); assert(r >= 0);
 
     // =========================================================================
     // Graphics - Shapes
     // =========================================================================
-    r = engine_->RegisterGlobalFunction("void drawRect(float, float, float, float)", asFUNCTION(as_drawRect_4f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void drawCircle(float, float, float)", asFUNCTION(as_drawCircle_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void drawPoint(float, float)", asFUNCTION(as_drawPoint_2f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void drawEllipse(float, float, float, float)", asFUNCTION(as_drawEllipse_4f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void drawLine(float, float, float, float)", asFUNCTION(as_drawLine_4f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void drawTriangle(float, float, float, float, float, float)", asFUNCTION(as_drawTriangle_6f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void drawStroke(float, float, float, float)", asFUNCTION(as_drawStroke_4f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void drawBitmapString(const string &in, float, float)", asFUNCTION(as_drawBitmapString), asCALL_GENERIC); assert(r >= 0);
+    r = bind.function<as_drawRect_4f>("void drawRect(float, float, float, float)"); assert(r >= 0);
+    r = bind.function<as_drawCircle_3f>("void drawCircle(float, float, float)"); assert(r >= 0);
+    r = bind.function<as_drawPoint_2f>("void drawPoint(float, float)"); assert(r >= 0);
+    r = bind.function<as_drawEllipse_4f>("void drawEllipse(float, float, float, float)"); assert(r >= 0);
+    r = bind.function<as_drawLine_4f>("void drawLine(float, float, float, float)"); assert(r >= 0);
+    r = bind.function<as_drawTriangle_6f>("void drawTriangle(float, float, float, float, float, float)"); assert(r >= 0);
+    r = bind.function<as_drawStroke_4f>("void drawStroke(float, float, float, float)"); assert(r >= 0);
+    r = bind.function<as_drawBitmapString>("void drawBitmapString(const string &in, float, float)"); assert(r >= 0);
 
     // 3D shapes
-    r = engine_->RegisterGlobalFunction("void drawBox(float)", asFUNCTION(as_drawBox_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void drawBox(float, float, float)", asFUNCTION(as_drawBox_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void drawBox(float, float, float, float)", asFUNCTION(as_drawBox_4f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void drawBox(float, float, float, float, float, float)", asFUNCTION(as_drawBox_6f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void drawSphere(float)", asFUNCTION(as_drawSphere_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void drawSphere(float, float, float, float)", asFUNCTION(as_drawSphere_4f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void drawCone(float, float)", asFUNCTION(as_drawCone_2f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void drawCone(float, float, float, float, float)", asFUNCTION(as_drawCone_5f), asCALL_GENERIC); assert(r >= 0);
+    r = bind.function<as_drawBox_1f>("void drawBox(float)"); assert(r >= 0);
+    r = bind.function<as_drawBox_3f>("void drawBox(float, float, float)"); assert(r >= 0);
+    r = bind.function<as_drawBox_4f>("void drawBox(float, float, float, float)"); assert(r >= 0);
+    r = bind.function<as_drawBox_6f>("void drawBox(float, float, float, float, float, float)"); assert(r >= 0);
+    r = bind.function<as_drawSphere_1f>("void drawSphere(float)"); assert(r >= 0);
+    r = bind.function<as_drawSphere_4f>("void drawSphere(float, float, float, float)"); assert(r >= 0);
+    r = bind.function<as_drawCone_2f>("void drawCone(float, float)"); assert(r >= 0);
+    r = bind.function<as_drawCone_5f>("void drawCone(float, float, float, float, float)"); assert(r >= 0);
+
+    // Batched shapes: packed x, y, radius / x, y, w, h / x1, y1, x2, y2 / x, y per item
+    r = engine_->RegisterGlobalFunction("void drawCircles(array<float>@)", AS_GENERIC(as_drawCircles<false>)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("void drawCircles(array<float>@, array<Color>@)", AS_GENERIC(as_drawCircles<false>)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("void drawCircles(FloatBuffer@)", AS_GENERIC(as_drawCircles<true>)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("void drawCircles(FloatBuffer@, array<Color>@)", AS_GENERIC(as_drawCircles<true>)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("void drawRects(array<float>@)", AS_GENERIC(as_drawRects<false>)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("void drawRects(array<float>@, array<Color>@)", AS_GENERIC(as_drawRects<false>)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("void drawRects(FloatBuffer@)", AS_GENERIC(as_drawRects<true>)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("void drawRects(FloatBuffer@, array<Color>@)", AS_GENERIC(as_drawRects<true>)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("void drawLines(array<float>@)", AS_GENERIC(as_drawLines<false>)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("void drawLines(array<float>@, array<Color>@)", AS_GENERIC(as_drawLines<false>)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("void drawLines(FloatBuffer@)", AS_GENERIC(as_drawLines<true>)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("void drawLines(FloatBuffer@, array<Color>@)", AS_GENERIC(as_drawLines<true>)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("void drawPoints(array<Vec2>@)", AS_GENERIC(as_drawPoints<false>)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("void drawPoints(array<Vec2>@, array<Color>@)", AS_GENERIC(as_drawPoints<false>)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("void drawPoints(FloatBuffer@)", AS_GENERIC(as_drawPoints<true>)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("void drawPoints(FloatBuffer@, array<Color>@)", AS_GENERIC(as_drawPoints<true>)); assert(r >= 0);
 
     // =========================================================================
     // Graphics - Style
     // =========================================================================
-    r = engine_->RegisterGlobalFunction("void fill()", asFUNCTION(as_fill), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void noFill()", asFUNCTION(as_noFill), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void setStrokeWeight(float)", asFUNCTION(as_setStrokeWeight_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float getStrokeWeight()", asFUNCTION(as_getStrokeWeight), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void setStrokeCap(int)", asFUNCTION(as_setStrokeCap), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("int getStrokeCap()", asFUNCTION(as_getStrokeCap), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void setStrokeJoin(int)", asFUNCTION(as_setStrokeJoin), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("int getStrokeJoin()", asFUNCTION(as_getStrokeJoin), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void setCircleResolution(int)", asFUNCTION(as_setCircleResolution_1i), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("int getCircleResolution()", asFUNCTION(as_getCircleResolution), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("bool isFillEnabled()", asFUNCTION(as_isFillEnabled), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("bool isStrokeEnabled()", asFUNCTION(as_isStrokeEnabled), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void pushStyle()", asFUNCTION(as_pushStyle), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void popStyle()", asFUNCTION(as_popStyle), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Color getColor()", asFUNCTION(as_getColor), asCALL_GENERIC); assert(r >= 0);
+    r = bind.function<as_fill>("void fill()"); assert(r >= 0);
+    r = bind.function<as_noFill>("void noFill()"); assert(r >= 0);
+    r = bind.function<as_setStrokeWeight_1f>("void setStrokeWeight(float)"); assert(r >= 0);
+    r = bind.function<as_getStrokeWeight>("float getStrokeWeight()"); assert(r >= 0);
+    r = bind.function<as_setStrokeCap>("void setStrokeCap(int)"); assert(r >= 0);
+    r = bind.function<as_getStrokeCap>("int getStrokeCap()"); assert(r >= 0);
+    r = bind.function<as_setStrokeJoin>("void setStrokeJoin(int)"); assert(r >= 0);
+    r = bind.function<as_getStrokeJoin>("int getStrokeJoin()"); assert(r >= 0);
+    r = bind.function<as_setCircleResolution_1i>("void setCircleResolution(int)"); assert(r >= 0);
+    r = bind.function<as_getCircleResolution>("int getCircleResolution()"); assert(r >= 0);
+    r = bind.function<as_isFillEnabled>("bool isFillEnabled()"); assert(r >= 0);
+    r = bind.function<as_isStrokeEnabled>("bool isStrokeEnabled()"); assert(r >= 0);
+    r = bind.function<as_pushStyle>("void pushStyle()"); assert(r >= 0);
+    r = bind.function<as_popStyle>("void popStyle()"); assert(r >= 0);
+    r = bind.function<as_getColor>("Color getColor()"); assert(r >= 0);
 
     // =========================================================================
     // Shape & Stroke construction
     // =========================================================================
-    r = engine_->RegisterGlobalFunction("void beginShape()", asFUNCTION(as_beginShape), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void endShape()", asFUNCTION(as_endShape), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void endShape(bool)", asFUNCTION(as_endShape_bool), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void vertex(float, float)", asFUNCTION(as_vertex_2f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void vertex(float, float, float)", asFUNCTION(as_vertex_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void beginStroke()", asFUNCTION(as_beginStroke), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void endStroke()", asFUNCTION(as_endStroke), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void endStroke(bool)", asFUNCTION(as_endStroke_bool), asCALL_GENERIC); assert(r >= 0);
-
+    r = bind.function<as_beginShape>("void beginShape()"); assert(r >= 0);
+    r = bind.function<as_endShape>("void endShape()"); assert(r >= 0);
+    r = bind.function<as_endShape_bool>("void endShape(bool)"); assert(r >= 0);
+    r = bind.function<as_vertex_2f>("void vertex(float, float)"); assert(r >= 0);
+    r = bind.function<as_vertex_3f>("void vertex(float, float, float)"); assert(r >= 0);
+    r = bind.function<as_beginStroke>("void beginStroke()"); assert(r >= 0);
+    r = bind.function<as_endStroke>("void endStroke()"); assert(r >= 0);
+    r = bind.function<as_endStroke_bool>("void endStroke(bool)"); assert(r >= 0);
+
+    category("transform");
     // =========================================================================
     // Transform
     // =========================================================================
-    r = engine_->RegisterGlobalFunction("void pushMatrix()", asFUNCTION(as_pushMatrix), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void popMatrix()", asFUNCTION(as_popMatrix), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void translate(float, float)", asFUNCTION(as_translate_2f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void translate(float, float, float)", asFUNCTION(as_translate_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void rotate(float)", asFUNCTION(as_rotate_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void rotate(float, float, float)", asFUNCTION(as_rotate_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void rotateDeg(float)", asFUNCTION(as_rotateDeg_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void rotateDeg(float, float, float)", asFUNCTION(as_rotateDeg_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void rotateX(float)", asFUNCTION(as_rotateX_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void rotateY(float)", asFUNCTION(as_rotateY_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void rotateZ(float)", asFUNCTION(as_rotateZ_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void rotateXDeg(float)", asFUNCTION(as_rotateXDeg_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void rotateYDeg(float)", asFUNCTION(as_rotateYDeg_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void rotateZDeg(float)", asFUNCTION(as_rotateZDeg_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void resetMatrix()", asFUNCTION(as_resetMatrix), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void scale(float)", asFUNCTION(as_scale_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void scale(float, float)", asFUNCTION(as_scale_2f), asCALL_GENERIC); assert(r >= 0);
-
+    r = bind.function<as_pushMatrix>("void pushMatrix()"); assert(r >= 0);
+    r = bind.function<as_popMatrix>("void popMatrix()"); assert(r >= 0);
+    r = bind.function<as_translate_2f>("void translate(float, float)"); assert(r >= 0);
+    r = bind.function<as_translate_3f>("void translate(float, float, float)"); assert(r >= 0);
+    r = bind.function<as_rotate_1f>("void rotate(float)"); assert(r >= 0);
+    r = bind.function<as_rotate_3f>("void rotate(float, float, float)"); assert(r >= 0);
+    r = bind.function<as_rotateDeg_1f>("void rotateDeg(float)"); assert(r >= 0);
+    r = bind.function<as_rotateDeg_3f>("void rotateDeg(float, float, float)"); assert(r >= 0);
+    r = bind.function<as_rotateX_1f>("void rotateX(float)"); assert(r >= 0);
+    r = bind.function<as_rotateY_1f>("void rotateY(float)"); assert(r >= 0);
+    r = bind.function<as_rotateZ_1f>("void rotateZ(float)"); assert(r >= 0);
+    r = bind.function<as_rotateXDeg_1f>("void rotateXDeg(float)"); assert(r >= 0);
+    r = bind.function<as_rotateYDeg_1f>("void rotateYDeg(float)"); assert(r >= 0);
+    r = bind.function<as_rotateZDeg_1f>("void rotateZDeg(float)"); assert(r >= 0);
+    r = bind.function<as_resetMatrix>("void resetMatrix()"); assert(r >= 0);
+    r = bind.function<as_scale_1f>("void scale(float)"); assert(r >= 0);
+    r = bind.function<as_scale_2f>("void scale(float, float)"); assert(r >= 0);
+
+    category("input");
     // =========================================================================
     // Window & Input
     // =========================================================================
-    r = engine_->RegisterGlobalFunction("int getWindowWidth()", asFUNCTION(as_getWindowWidth), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("int getWindowHeight()", asFUNCTION(as_getWindowHeight), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float getMouseX()", asFUNCTION(as_getMouseX), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float getMouseY()", asFUNCTION(as_getMouseY), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("bool isMousePressed()", asFUNCTION(as_isMousePressed), asCALL_GENERIC); assert(r >= 0);
+    r = bind.function<as_getWindowWidth>("int getWindowWidth()"); assert(r >= 0);
+    r = bind.function<as_getWindowHeight>("int getWindowHeight()"); assert(r >= 0);
+    r = bind.function<as_getMouseX>("float getMouseX()"); assert(r >= 0);
+    r = bind.function<as_getMouseY>("float getMouseY()"); assert(r >= 0);
+    r = bind.function<as_isMousePressed>("bool isMousePressed()"); assert(r >= 0);
 
+    category("time");
     // =========================================================================
     // Time
     // =========================================================================
-    r = engine_->RegisterGlobalFunction("float getDeltaTime()", asFUNCTION(as_getDeltaTime), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float getFrameRate()", asFUNCTION(as_getFrameRate), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("int64 getFrameCount()", asFUNCTION(as_getFrameCount), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float getElapsedTimef()", asFUNCTION(as_getElapsedTimef), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float getElapsedTime()", asFUNCTION(as_getElapsedTimef), asCALL_GENERIC); assert(r >= 0);  // alias
-    r = engine_->RegisterGlobalFunction("int64 getElapsedTimeMillis()", asFUNCTION(as_getElapsedTimeMillis), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("int64 getElapsedTimeMicros()", asFUNCTION(as_getElapsedTimeMicros), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void resetElapsedTimeCounter()", asFUNCTION(as_resetElapsedTimeCounter), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("int64 getSystemTimeMillis()", asFUNCTION(as_getSystemTimeMillis), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("int64 getSystemTimeMicros()", asFUNCTION(as_getSystemTimeMicros), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("string getTimestampString()", asFUNCTION(as_getTimestampString_0), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("string getTimestampString(const string &in)", asFUNCTION(as_getTimestampString_1), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("int getSeconds()", asFUNCTION(as_getSeconds), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("int getMinutes()", asFUNCTION(as_getMinutes), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("int getHours()", asFUNCTION(as_getHours), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("int getYear()", asFUNCTION(as_getYear), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("int getMonth()", asFUNCTION(as_getMonth), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("int getDay()", asFUNCTION(as_getDay), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("int getWeekday()", asFUNCTION(as_getWeekday), asCALL_GENERIC); assert(r >= 0);
+    r = bind.function<as_getDeltaTime>("float getDeltaTime()"); assert(r >= 0);
+    r = bind.function<as_getFrameRate>("float getFrameRate()"); assert(r >= 0);
+    r = bind.function<as_getFrameCount>("int64 getFrameCount()"); assert(r >= 0);
+    r = bind.function<as_getElapsedTimef>("float getElapsedTimef()"); assert(r >= 0);
+    r = bind.function<as_getElapsedTimef>("float getElapsedTime()"); assert(r >= 0);  // alias
+    r = bind.function<as_getElapsedTimeMillis>("int64 getElapsedTimeMillis()"); assert(r >= 0);
+    r = bind.function<as_getElapsedTimeMicros>("int64 getElapsedTimeMicros()"); assert(r >= 0);
+    r = bind.function<as_resetElapsedTimeCounter>("void resetElapsedTimeCounter()"); assert(r >= 0);
+    r = bind.function<as_getSystemTimeMillis>("int64 getSystemTimeMillis()"); assert(r >= 0);
+    r = bind.function<as_getSystemTimeMicros>("int64 getSystemTimeMicros()"); assert(r >= 0);
+    r = bind.function<as_getTimestampString_0>("string getTimestampString()"); assert(r >= 0);
+    r = bind.function<as_getTimestampString_1>("string getTimestampString(const string &in)"); assert(r >= 0);
+    r = bind.function<as_getSeconds>("int getSeconds()"); assert(r >= 0);
+    r = bind.function<as_getMinutes>("int getMinutes()"); assert(r >= 0);
+    r = bind.function<as_getHours>("int getHours()"); assert(r >= 0);
+    r = bind.function<as_getYear>("int getYear()"); assert(r >= 0);
+    r = bind.function<as_getMonth>("int getMonth()"); assert(r >= 0);
+    r = bind.function<as_getDay>("int getDay()"); assert(r >= 0);
+    r = bind.function<as_getWeekday>("int getWeekday()"); assert(r >= 0);
+
+    category("debug");
+    // =========================================================================
+    // Debug
+    // =========================================================================
+    r = bind.function<as_getLiveObjectCount>("int getLiveObjectCount()"); assert(r >= 0);
 
+    category("coroutine");
+    // =========================================================================
+    // Coroutines
+    // =========================================================================
+    r = engine_->RegisterFuncdef("void CoroutineFunc()"); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("void startCoroutine(CoroutineFunc@)", AS_GENERIC(as_startCoroutine)); assert(r >= 0);
+    r = bind.function<as_yield>("void yield()"); assert(r >= 0);
+    r = bind.function<as_waitFrames>("void waitFrames(int)"); assert(r >= 0);
+
+    category("input");
+    // =========================================================================
+    // InputEvent (value type, delivered in batches to inputEvents())
+    // =========================================================================
+    r = engine_->RegisterEnum("InputEventType"); assert(r >= 0);
+    r = engine_->RegisterEnumValue("InputEventType", "MousePressed", InputEvent::MousePressed); assert(r >= 0);
+    r = engine_->RegisterEnumValue("InputEventType", "MouseReleased", InputEvent::MouseReleased); assert(r >= 0);
+    r = engine_->RegisterEnumValue("InputEventType", "MouseMoved", InputEvent::MouseMoved); assert(r >= 0);
+    r = engine_->RegisterEnumValue("InputEventType", "MouseDragged", InputEvent::MouseDragged); assert(r >= 0);
+    r = engine_->RegisterEnumValue("InputEventType", "KeyPressed", InputEvent::KeyPressed); assert(r >= 0);
+    r = engine_->RegisterEnumValue("InputEventType", "KeyReleased", InputEvent::KeyReleased); assert(r >= 0);
+    r = engine_->RegisterEnumValue("InputEventType", "WindowResized", InputEvent::WindowResized); assert(r >= 0);
+    r = engine_->RegisterObjectType("InputEvent", sizeof(InputEvent), asOBJ_VALUE | asOBJ_POD | asGetTypeTraits<InputEvent>()); assert(r >= 0);
+    r = engine_->RegisterObjectProperty("InputEvent", "InputEventType type", offsetof(InputEvent, type)); assert(r >= 0);
+    r = engine_->RegisterObjectProperty("InputEvent", "float x", offsetof(InputEvent, x)); assert(r >= 0);
+    r = engine_->RegisterObjectProperty("InputEvent", "float y", offsetof(InputEvent, y)); assert(r >= 0);
+    r = engine_->RegisterObjectProperty("InputEvent", "int button", offsetof(InputEvent, button)); assert(r >= 0);
+    r = engine_->RegisterObjectProperty("InputEvent", "int key", offsetof(InputEvent, key)); assert(r >= 0);
+
+    category("math");
     // =========================================================================
     // Math - Random & Noise
     // =========================================================================
-    r = engine_->RegisterGlobalFunction("float random()", asFUNCTION(as_random_0), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float random(float)", asFUNCTION(as_random_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float random(float, float)", asFUNCTION(as_random_2f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("int randomInt(int)", asFUNCTION(as_randomInt_1), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("int randomInt(int, int)", asFUNCTION(as_randomInt_2), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void randomSeed(uint)", asFUNCTION(as_randomSeed), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float noise(float)", asFUNCTION(as_noise_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float noise(float, float)", asFUNCTION(as_noise_2f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float noise(float, float, float)", asFUNCTION(as_noise_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float signedNoise(float)", asFUNCTION(as_signedNoise_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float signedNoise(float, float)", asFUNCTION(as_signedNoise_2f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float signedNoise(float, float, float)", asFUNCTION(as_signedNoise_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float fbm(float, float)", asFUNCTION(as_fbm_2f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float fbm(float, float, int, float, float)", asFUNCTION(as_fbm_5f), asCALL_GENERIC); assert(r >= 0);
+    r = bind.function<as_random_0>("float random()"); assert(r >= 0);
+    r = bind.function<as_random_1f>("float random(float)"); assert(r >= 0);
+    r = bind.function<as_random_2f>("float random(float, float)"); assert(r >= 0);
+    r = bind.function<as_randomInt_1>("int randomInt(int)"); assert(r >= 0);
+    r = bind.function<as_randomInt_2>("int randomInt(int, int)"); assert(r >= 0);
+    r = bind.function<as_randomSeed>("void randomSeed(uint)"); assert(r >= 0);
+    r = bind.function<as_noise_1f>("float noise(float)"); assert(r >= 0);
+    r = bind.function<as_noise_2f>("float noise(float, float)"); assert(r >= 0);
+    r = bind.function<as_noise_3f>("float noise(float, float, float)"); assert(r >= 0);
+    r = bind.function<as_signedNoise_1f>("float signedNoise(float)"); assert(r >= 0);
+    r = bind.function<as_signedNoise_2f>("float signedNoise(float, float)"); assert(r >= 0);
+    r = bind.function<as_signedNoise_3f>("float signedNoise(float, float, float)"); assert(r >= 0);
+    r = bind.function<as_fbm_2f>("float fbm(float, float)"); assert(r >= 0);
+    r = bind.function<as_fbm_5f>("float fbm(float, float, int, float, float)"); assert(r >= 0);
 
     // =========================================================================
     // Math - Interpolation & Trigonometry & General
     // =========================================================================
-    r = engine_->RegisterGlobalFunction("float lerp(float, float, float)", asFUNCTION(as_lerp), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float clamp(float, float, float)", asFUNCTION(as_clamp), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float map(float, float, float, float, float)", asFUNCTION(as_map), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float sin(float)", asFUNCTION(as_sin), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float cos(float)", asFUNCTION(as_cos), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float tan(float)", asFUNCTION(as_tan), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float asin(float)", asFUNCTION(as_asin), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float acos(float)", asFUNCTION(as_acos), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float atan(float)", asFUNCTION(as_atan), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float atan2(float, float)", asFUNCTION(as_atan2), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float deg2rad(float)", asFUNCTION(as_deg2rad), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float rad2deg(float)", asFUNCTION(as_rad2deg), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float abs(float)", asFUNCTION(as_abs), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float sqrt(float)", asFUNCTION(as_sqrt), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float sq(float)", asFUNCTION(as_sq), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float pow(float, float)", asFUNCTION(as_pow), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float log(float)", asFUNCTION(as_log), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float exp(float)", asFUNCTION(as_exp), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float min(float, float)", asFUNCTION(as_min), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float max(float, float)", asFUNCTION(as_max), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float floor(float)", asFUNCTION(as_floor), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float ceil(float)", asFUNCTION(as_ceil), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float round(float)", asFUNCTION(as_round), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float fmod(float, float)", asFUNCTION(as_fmod), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float sign(float)", asFUNCTION(as_sign), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float fract(float)", asFUNCTION(as_fract), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float dist(float, float, float, float)", asFUNCTION(as_dist), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float distSquared(float, float, float, float)", asFUNCTION(as_distSquared), asCALL_GENERIC); assert(r >= 0);
-
+    r = bind.function<as_lerp>("float lerp(float, float, float)"); assert(r >= 0);
+    r = bind.function<as_clamp>("float clamp(float, float, float)"); assert(r >= 0);
+    r = bind.function<as_map>("float map(float, float, float, float, float)"); assert(r >= 0);
+    r = bind.function<as_sin>("float sin(float)"); assert(r >= 0);
+    r = bind.function<as_cos>("float cos(float)"); assert(r >= 0);
+    r = bind.function<as_tan>("float tan(float)"); assert(r >= 0);
+    r = bind.function<as_asin>("float asin(float)"); assert(r >= 0);
+    r = bind.function<as_acos>("float acos(float)"); assert(r >= 0);
+    r = bind.function<as_atan>("float atan(float)"); assert(r >= 0);
+    r = bind.function<as_atan2>("float atan2(float, float)"); assert(r >= 0);
+    r = bind.function<as_deg2rad>("float deg2rad(float)"); assert(r >= 0);
+    r = bind.function<as_rad2deg>("float rad2deg(float)"); assert(r >= 0);
+    r = bind.function<as_abs>("float abs(float)"); assert(r >= 0);
+    r = bind.function<as_sqrt>("float sqrt(float)"); assert(r >= 0);
+    r = bind.function<as_sq>("float sq(float)"); assert(r >= 0);
+    r = bind.function<as_pow>("float pow(float, float)"); assert(r >= 0);
+    r = bind.function<as_log>("float log(float)"); assert(r >= 0);
+    r = bind.function<as_exp>("float exp(float)"); assert(r >= 0);
+    r = bind.function<as_min>("float min(float, float)"); assert(r >= 0);
+    r = bind.function<as_max>("float max(float, float)"); assert(r >= 0);
+    r = bind.function<as_floor>("float floor(float)"); assert(r >= 0);
+    r = bind.function<as_ceil>("float ceil(float)"); assert(r >= 0);
+    r = bind.function<as_round>("float round(float)"); assert(r >= 0);
+    r = bind.function<as_fmod>("float fmod(float, float)"); assert(r >= 0);
+    r = bind.function<as_sign>("float sign(float)"); assert(r >= 0);
+    r = bind.function<as_fract>("float fract(float)"); assert(r >= 0);
+    r = bind.function<as_dist>("float dist(float, float, float, float)"); assert(r >= 0);
+    r = bind.function<as_distSquared>("float distSquared(float, float, float, float)"); assert(r >= 0);
+
+    category("system");
     // =========================================================================
     // System & Window
     // =========================================================================
-    r = engine_->RegisterGlobalFunction("void toggleFullscreen()", asFUNCTION(as_toggleFullscreen), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void setClipboardString(const string &in)", asFUNCTION(as_setClipboardString), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("string getClipboardString()", asFUNCTION(as_getClipboardString), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void setWindowTitle(const string &in)", asFUNCTION(as_setWindowTitle), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void setWindowSize(int, int)", asFUNCTION(as_setWindowSize), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Vec2 getWindowSize()", asFUNCTION(as_getWindowSize), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Vec2 getMousePos()", asFUNCTION(as_getMousePos), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Vec2 getGlobalMousePos()", asFUNCTION(as_getGlobalMousePos), asCALL_GENERIC); assert(r >= 0);
-
+    r = bind.function<as_toggleFullscreen>("void toggleFullscreen()"); assert(r >= 0);
+    r = bind.function<as_setClipboardString>("void setClipboardString(const string &in)"); assert(r >= 0);
+    r = bind.function<as_getClipboardString>("string getClipboardString()"); assert(r >= 0);
+    r = bind.function<as_setWindowTitle>("void setWindowTitle(const string &in)"); assert(r >= 0);
+    r = bind.function<as_setWindowSize>("void setWindowSize(int, int)"); assert(r >= 0);
+    r = bind.function<as_getWindowSize>("Vec2 getWindowSize()"); assert(r >= 0);
+    r = bind.function<as_getMousePos>("Vec2 getMousePos()"); assert(r >= 0);
+    r = bind.function<as_getGlobalMousePos>("Vec2 getGlobalMousePos()"); assert(r >= 0);
+
+    category("transform");
     // Transform matrix
-    r = engine_->RegisterGlobalFunction("Mat4 getCurrentMatrix()", asFUNCTION(as_getCurrentMatrix), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void setMatrix(const Mat4 &in)", asFUNCTION(as_setMatrix), asCALL_GENERIC); assert(r >= 0);
+    r = bind.function<as_getCurrentMatrix>("Mat4 getCurrentMatrix()"); assert(r >= 0);
+    r = bind.function<as_setMatrix>("void setMatrix(const Mat4 &in)"); assert(r >= 0);
 
     // Direction enum for text alignment
     r = engine_->RegisterEnum("Direction"); assert(r >= 0);
@@ -2830,51 +4402,54 @@ void tcScriptHost::registerTrussCFunctions() {
     r = engine_->RegisterEnumValue("Direction", "Bottom", 4); assert(r >= 0);
     r = engine_->RegisterEnumValue("Direction", "Baseline", 5); assert(r >= 0);
 
+    category("graphics");
     // Text alignment
-    r = engine_->RegisterGlobalFunction("void setTextAlign(Direction, Direction)", asFUNCTION(as_setTextAlign), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Direction getTextAlignH()", asFUNCTION(as_getTextAlignH), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Direction getTextAlignV()", asFUNCTION(as_getTextAlignV), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float getBitmapFontHeight()", asFUNCTION(as_getBitmapFontHeight), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float getBitmapStringWidth(const string &in)", asFUNCTION(as_getBitmapStringWidth), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float getBitmapStringHeight(const string &in)", asFUNCTION(as_getBitmapStringHeight), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Rect getBitmapStringBBox(const string &in)", asFUNCTION(as_getBitmapStringBBox), asCALL_GENERIC); assert(r >= 0);
+    r = bind.function<as_setTextAlign>("void setTextAlign(Direction, Direction)"); assert(r >= 0);
+    r = bind.function<as_getTextAlignH>("Direction getTextAlignH()"); assert(r >= 0);
+    r = bind.function<as_getTextAlignV>("Direction getTextAlignV()"); assert(r >= 0);
+    r = bind.function<as_getBitmapFontHeight>("float getBitmapFontHeight()"); assert(r >= 0);
+    r = bind.function<as_getBitmapStringWidth>("float getBitmapStringWidth(const string &in)"); assert(r >= 0);
+    r = bind.function<as_getBitmapStringHeight>("float getBitmapStringHeight(const string &in)"); assert(r >= 0);
+    r = bind.function<as_getBitmapStringBBox>("Rect getBitmapStringBBox(const string &in)"); assert(r >= 0);
 
     // Graphics advanced
-    r = engine_->RegisterGlobalFunction("void drawMesh(Mesh@)", asFUNCTION(as_drawMesh), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void drawPolyline(Path@)", asFUNCTION(as_drawPolyline), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void drawTexture(Texture@, float, float)", asFUNCTION(as_drawTexture_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void drawTexture(Texture@, float, float, float, float)", asFUNCTION(as_drawTexture_5f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Mesh@ createBox(float)", asFUNCTION(as_createBox_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Mesh@ createBox(float, float, float)", asFUNCTION(as_createBox_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Mesh@ createSphere(float)", asFUNCTION(as_createSphere_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Mesh@ createSphere(float, int)", asFUNCTION(as_createSphere_2), asCALL_GENERIC); assert(r >= 0);
-
+    r = engine_->RegisterGlobalFunction("void drawMesh(Mesh@)", AS_GENERIC(as_drawMesh)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("void drawPolyline(Path@)", AS_GENERIC(as_drawPolyline)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("void drawTexture(Texture@, float, float)", AS_GENERIC(as_drawTexture_3f)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("void drawTexture(Texture@, float, float, float, float)", AS_GENERIC(as_drawTexture_5f)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("Mesh@ createBox(float)", AS_GENERIC(as_createBox_1f)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("Mesh@ createBox(float, float, float)", AS_GENERIC(as_createBox_3f)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("Mesh@ createSphere(float)", AS_GENERIC(as_createSphere_1f)); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("Mesh@ createSphere(float, int)", AS_GENERIC(as_createSphere_2)); assert(r >= 0);
+
+    category("Color");
     // Color static factory functions
-    r = engine_->RegisterGlobalFunction("Color Color_fromHex(uint)", asFUNCTION(Color_FromHex_1u), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Color Color_fromHex(uint, bool)", asFUNCTION(Color_FromHex_1u1b), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Color Color_fromBytes(int, int, int)", asFUNCTION(Color_FromBytes_3i), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Color Color_fromBytes(int, int, int, int)", asFUNCTION(Color_FromBytes_4i), asCALL_GENERIC); assert(r >= 0);
+    r = bind.function<Color_FromHex_1u>("Color Color_fromHex(uint)"); assert(r >= 0);
+    r = bind.function<Color_FromHex_1u1b>("Color Color_fromHex(uint, bool)"); assert(r >= 0);
+    r = bind.function<Color_FromBytes_3i>("Color Color_fromBytes(int, int, int)"); assert(r >= 0);
+    r = bind.function<Color_FromBytes_4i>("Color Color_fromBytes(int, int, int, int)"); assert(r >= 0);
 
+    category("utility");
     // =========================================================================
     // Utility
     // =========================================================================
-    r = engine_->RegisterGlobalFunction("void logNotice(const string &in)", asFUNCTION(as_logNotice), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("string toString(int)", asFUNCTION(as_toString_int), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("string toString(float)", asFUNCTION(as_toString_float), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void beep()", asFUNCTION(as_beep), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void beep(float)", asFUNCTION(as_beep_1f), asCALL_GENERIC); assert(r >= 0);
+    r = bind.function<as_logNotice>("void logNotice(const string &in)"); assert(r >= 0);
+    r = bind.function<as_toString_int>("string toString(int)"); assert(r >= 0);
+    r = bind.function<as_toString_float>("string toString(float)"); assert(r >= 0);
+    r = bind.function<as_beep>("void beep()"); assert(r >= 0);
+    r = bind.function<as_beep_1f>("void beep(float)"); assert(r >= 0);
 
     // =========================================================================
     // 3D Projection
     // =========================================================================
-    r = engine_->RegisterGlobalFunction("void setupScreenPerspective()", asFUNCTION(as_setupScreenPerspective), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void setupScreenPerspective(float)", asFUNCTION(as_setupScreenPerspective_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void setupScreenPerspective(float, float, float)", asFUNCTION(as_setupScreenPerspective_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void setupScreenOrtho()", asFUNCTION(as_setupScreenOrtho), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void setupScreenFov(float)", asFUNCTION(as_setupScreenFov_1f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void setupScreenFov(float, float, float)", asFUNCTION(as_setupScreenFov_3f), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("void setDefaultScreenFov(float)", asFUNCTION(as_setDefaultScreenFov), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float getDefaultScreenFov()", asFUNCTION(as_getDefaultScreenFov), asCALL_GENERIC); assert(r >= 0);
+    r = bind.function<as_setupScreenPerspective>("void setupScreenPerspective()"); assert(r >= 0);
+    r = bind.function<as_setupScreenPerspective_1f>("void setupScreenPerspective(float)"); assert(r >= 0);
+    r = bind.function<as_setupScreenPerspective_3f>("void setupScreenPerspective(float, float, float)"); assert(r >= 0);
+    r = bind.function<as_setupScreenOrtho>("void setupScreenOrtho()"); assert(r >= 0);
+    r = bind.function<as_setupScreenFov_1f>("void setupScreenFov(float)"); assert(r >= 0);
+    r = bind.function<as_setupScreenFov_3f>("void setupScreenFov(float, float, float)"); assert(r >= 0);
+    r = bind.function<as_setDefaultScreenFov>("void setDefaultScreenFov(float)"); assert(r >= 0);
+    r = bind.function<as_getDefaultScreenFov>("float getDefaultScreenFov()"); assert(r >= 0);
 
     // =========================================================================
     // Constants
@@ -2920,94 +4495,54 @@ void tcScriptHost::registerTrussCFunctions() {
     r = engine_->RegisterGlobalProperty("const int InOut", (void*)&kEaseModeInOut); assert(r >= 0);
     engine_->SetDefaultNamespace("");
 
+    category("math");
     // =========================================================================
     // Easing functions
     // =========================================================================
-    r = engine_->RegisterGlobalFunction("float ease(float, int, int)", asFUNCTION(as_ease), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float easeIn(float, int)", asFUNCTION(as_easeIn), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float easeOut(float, int)", asFUNCTION(as_easeOut), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("float easeInOut(float, int)", asFUNCTION(as_easeInOut), asCALL_GENERIC); assert(r >= 0);
+    r = bind.function<as_ease>("float ease(float, int, int)"); assert(r >= 0);
+    r = bind.function<as_easeIn>("float easeIn(float, int)"); assert(r >= 0);
+    r = bind.function<as_easeOut>("float easeOut(float, int)"); assert(r >= 0);
+    r = bind.function<as_easeInOut>("float easeInOut(float, int)"); assert(r >= 0);
 
+    category("Tween");
     // =========================================================================
     // Tween type (reference type for float animation)
     // =========================================================================
-    r = engine_->RegisterObjectType("Tween", 0, asOBJ_REF | asOBJ_NOCOUNT); assert(r >= 0);
-    r = engine_->RegisterGlobalFunction("Tween@ createTween()", asFUNCTION(TweenFloat_Factory), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Tween", "Tween@ from(float)", asFUNCTION(TweenFloat_From), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Tween", "Tween@ to(float)", asFUNCTION(TweenFloat_To), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Tween", "Tween@ duration(float)", asFUNCTION(TweenFloat_Duration), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Tween", "Tween@ ease(int, int)", asFUNCTION(TweenFloat_Ease), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Tween", "Tween@ ease(int)", asFUNCTION(TweenFloat_Ease_1), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Tween", "Tween@ start()", asFUNCTION(TweenFloat_Start), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Tween", "Tween@ pause()", asFUNCTION(TweenFloat_Pause), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Tween", "Tween@ resume()", asFUNCTION(TweenFloat_Resume), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Tween", "Tween@ reset()", asFUNCTION(TweenFloat_Reset), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Tween", "Tween@ finish()", asFUNCTION(TweenFloat_Finish), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Tween", "void update(float)", asFUNCTION(TweenFloat_Update), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Tween", "float getValue() const", asFUNCTION(TweenFloat_GetValue), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Tween", "float getProgress() const", asFUNCTION(TweenFloat_GetProgress), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Tween", "float getElapsed() const", asFUNCTION(TweenFloat_GetElapsed), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Tween", "float getDuration() const", asFUNCTION(TweenFloat_GetDuration), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Tween", "bool isPlaying() const", asFUNCTION(TweenFloat_IsPlaying), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Tween", "bool isComplete() const", asFUNCTION(TweenFloat_IsComplete), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Tween", "float getStart() const", asFUNCTION(TweenFloat_GetStart), asCALL_GENERIC); assert(r >= 0);
-    r = engine_->RegisterObjectMethod("Tween", "float getEnd() const", asFUNCTION(TweenFloat_GetEnd), asCALL_GENERIC); assert(r >= 0);
-
-    tc::logNotice() << "[AngelScript] Registration complete (" << engine_->GetGlobalFunctionCount() << " global functions, " << engine_->GetObjectTypeCount() << " object types)";
+    r = engine_->RegisterObjectType("Tween", 0, asOBJ_REF); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptAddRef<Tween<float>>>("Tween", asBEHAVE_ADDREF, "void f()"); assert(r >= 0);
+    r = bind.behaviour<tcscript::scriptRelease<Tween<float>>>("Tween", asBEHAVE_RELEASE, "void f()"); assert(r >= 0);
+    r = engine_->RegisterGlobalFunction("Tween@ createTween()", AS_GENERIC(TweenFloat_Factory)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Tween", "Tween@ from(float)", AS_GENERIC(TweenFloat_From)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Tween", "Tween@ to(float)", AS_GENERIC(TweenFloat_To)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Tween", "Tween@ duration(float)", AS_GENERIC(TweenFloat_Duration)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Tween", "Tween@ ease(int, int)", AS_GENERIC(TweenFloat_Ease)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Tween", "Tween@ ease(int)", AS_GENERIC(TweenFloat_Ease_1)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Tween", "Tween@ start()", AS_GENERIC(TweenFloat_Start)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Tween", "Tween@ pause()", AS_GENERIC(TweenFloat_Pause)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Tween", "Tween@ resume()", AS_GENERIC(TweenFloat_Resume)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Tween", "Tween@ reset()", AS_GENERIC(TweenFloat_Reset)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Tween", "Tween@ finish()", AS_GENERIC(TweenFloat_Finish)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Tween", "void update(float)", AS_GENERIC(TweenFloat_Update)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Tween", "float getValue() const", AS_GENERIC(TweenFloat_GetValue)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Tween", "float getProgress() const", AS_GENERIC(TweenFloat_GetProgress)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Tween", "float getElapsed() const", AS_GENERIC(TweenFloat_GetElapsed)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Tween", "float getDuration() const", AS_GENERIC(TweenFloat_GetDuration)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Tween", "bool isPlaying() const", AS_GENERIC(TweenFloat_IsPlaying)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Tween", "bool isComplete() const", AS_GENERIC(TweenFloat_IsComplete)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Tween", "float getStart() const", AS_GENERIC(TweenFloat_GetStart)); assert(r >= 0);
+    r = engine_->RegisterObjectMethod("Tween", "float getEnd() const", AS_GENERIC(TweenFloat_GetEnd)); assert(r >= 0);
+
+    category(nullptr);
+
+#ifdef TCSCRIPT_HEADLESS
+    tcheadless::markNullCalls(engine_);
+#endif
+
+    tc::logNotice() << "[AngelScript] Registration complete (" << engine_->GetGlobalFunctionCount() << " global functions, " << engine_->GetObjectTypeCount() << " object types, " << (bind.usesNativeCalls() ? "native" : "generic") << " calling convention)";
 }
 
 bool tcScriptHost::loadScript(const string& code) {
-    lastError_.clear();
-
-    // Clean up resources from previous script
-    clearScriptResources();
-
-    if (module_) {
-        module_->Discard();
-        module_ = nullptr;
-    }
-
-    setupFunc_ = nullptr;
-    updateFunc_ = nullptr;
-    drawFunc_ = nullptr;
-    mousePressedFunc_ = nullptr;
-    mouseReleasedFunc_ = nullptr;
-    mouseMovedFunc_ = nullptr;
-    mouseDraggedFunc_ = nullptr;
-    keyPressedFunc_ = nullptr;
-    keyReleasedFunc_ = nullptr;
-    windowResizedFunc_ = nullptr;
-
-    module_ = engine_->GetModule("script", asGM_ALWAYS_CREATE);
-    if (!module_) {
-        lastError_ = "Failed to create script module";
-        return false;
-    }
-
-    int r = module_->AddScriptSection("main", code.c_str(), code.length());
-    if (r < 0) {
-        lastError_ = "Failed to add script section";
-        return false;
-    }
-
-    r = module_->Build();
-    if (r < 0) {
-        lastError_ = "Script compilation failed";
-        return false;
-    }
-
-    setupFunc_ = module_->GetFunctionByDecl("void setup()");
-    updateFunc_ = module_->GetFunctionByDecl("void update()");
-    drawFunc_ = module_->GetFunctionByDecl("void draw()");
-    mousePressedFunc_ = module_->GetFunctionByDecl("void mousePressed(float, float, int)");
-    mouseReleasedFunc_ = module_->GetFunctionByDecl("void mouseReleased(float, float, int)");
-    mouseMovedFunc_ = module_->GetFunctionByDecl("void mouseMoved(float, float)");
-    mouseDraggedFunc_ = module_->GetFunctionByDecl("void mouseDragged(float, float, int)");
-    keyPressedFunc_ = module_->GetFunctionByDecl("void keyPressed(int)");
-    keyReleasedFunc_ = module_->GetFunctionByDecl("void keyReleased(int)");
-    windowResizedFunc_ = module_->GetFunctionByDecl("void windowResized(int, int)");
-
-    return true;
+    return buildModule({{"main", code}});
 }
 
 // =============================================================================
@@ -3023,52 +4558,224 @@ void tcScriptHost::addScriptFile(const string& name, const string& code) {
 }
 
 bool tcScriptHost::buildScriptFiles() {
-    lastError_.clear();
+    return buildModule(scriptFiles_);
+}
 
-    // Clean up resources from previous script
-    clearScriptResources();
+// =============================================================================
+// Module build (shared by single-file and multi-file modes)
+// =============================================================================
 
-    if (module_) {
-        module_->Discard();
-        module_ = nullptr;
+bool tcScriptHost::buildModule(const vector<pair<string, string>>& sections) {
+    tcScopedTiming timing(compileStats_);
+    lastError_.clear();
+    loadedFromCache_ = false;
+    stateRestored_ = false;
+
+    // The new code is built into the other module slot while the current
+    // module keeps running, so a compile error leaves the old sketch alive.
+    // A module still being torn down from the previous swap may occupy that
+    // slot - finish it off first.
+    if (retiredModule_) {
+        retiredModule_->Discard();
+        retiredModule_ = nullptr;
     }
+    const char* name = (module_ && strcmp(module_->GetName(), "script") == 0) ? "script_next" : "script";
 
-    setupFunc_ = nullptr;
-    updateFunc_ = nullptr;
-    drawFunc_ = nullptr;
-    mousePressedFunc_ = nullptr;
-    mouseReleasedFunc_ = nullptr;
-    mouseMovedFunc_ = nullptr;
-    mouseDraggedFunc_ = nullptr;
-    keyPressedFunc_ = nullptr;
-    keyReleasedFunc_ = nullptr;
-    windowResizedFunc_ = nullptr;
-
-    module_ = engine_->GetModule("script", asGM_ALWAYS_CREATE);
-    if (!module_) {
+    asIScriptModule* pending = engine_->GetModule(name, asGM_ALWAYS_CREATE);
+    if (!pending) {
         lastError_ = "Failed to create script module";
         return false;
     }
 
+    // Fast path: restore previously compiled bytecode for identical sources
+    uint64_t cacheKey = 0;
+    if (bytecodeCacheEnabled_) {
+        cacheKey = tcBytecodeCache::hashSections(sections, engine_);
+        if (bytecodeCache_.load(cacheKey, pending)) {
+            loadedFromCache_ = true;
+            swapModule(pending);
+            tc::logNotice() << "[AngelScript] Loaded module from bytecode cache";
+            return true;
+        }
+        // A failed load may leave partial state behind - start from a fresh module
+        lastError_.clear();
+        pending = engine_->GetModule(name, asGM_ALWAYS_CREATE);
+        if (!pending) {
+            lastError_ = "Failed to create script module";
+            return false;
+        }
+    }
+
     // Add each file as a section
-    for (const auto& [name, code] : scriptFiles_) {
-        int r = module_->AddScriptSection(name.c_str(), code.c_str(), code.length());
+    for (const auto& [sectionName, code] : sections) {
+        int r = pending->AddScriptSection(sectionName.c_str(), code.c_str(), code.length());
         if (r < 0) {
-            lastError_ = "Failed to add script section: " + name;
+            lastError_ = "Failed to add script section: " + sectionName;
+            pending->Discard();
             return false;
         }
     }
 
-    int r = module_->Build();
+    int r = pending->Build();
     if (r < 0) {
         // Error already captured by message callback
         if (lastError_.empty()) {
             lastError_ = "Script compilation failed";
         }
+        pending->Discard();
         return false;
     }
 
-    // Bind lifecycle functions
+    if (bytecodeCacheEnabled_) {
+        bytecodeCache_.store(cacheKey, pending);
+    }
+
+    swapModule(pending);
+    return true;
+}
+
+void tcScriptHost::swapModule(asIScriptModule* next) {
+    // Drop calls of the old script still spread over frames
+    abortSuspended();
+    stopCoroutines();
+    loader_.cancelAll();
+    dropChipBuilds();
+
+    // Stop sounds the previous script left playing
+    clearScriptResources();
+
+    // A script stopped by the memory cap: its globals are what filled the
+    // memory, so they are not carried over
+    bool overCap = halted_;
+    if (preserveState_ && module_ && !overCap) {
+        int restored = restoreGlobals(module_, next);
+        stateRestored_ = restored > 0;
+        if (stateRestored_) {
+            tc::logNotice() << "[AngelScript] Restored " << restored << " global variable(s)";
+        }
+    }
+
+    // The old module is discarded on the next update() and its garbage
+    // collected incrementally over the following frames
+    retiredModule_ = module_;
+    module_ = next;
+    halted_ = false;
+    if (overCap) {
+        // Its memory would still count against the cap when setup() runs -
+        // free it now rather than over the next frames (the aborted call's
+        // stack included)
+        if (ctx_) ctx_->Unprepare();
+        collectRetiredModule();
+        engine_->GarbageCollect(asGC_FULL_CYCLE);
+    }
+    bindLifecycleFunctions();
+    profiler_.forgetFunctions();
+}
+
+// Copy global variable values from the old module into the new one.
+// Only variables with the same declaration name, namespace and type are
+// copied: primitives, registered enums, registered value types (string,
+// Vec2, Vec3, Color, Mat4, Quaternion, ...) and arrays. Script classes and
+// handles are skipped - their types belong to the old module.
+int tcScriptHost::restoreGlobals(asIScriptModule* from, asIScriptModule* to) {
+    int restored = 0;
+    for (asUINT i = 0; i < to->GetGlobalVarCount(); i++) {
+        const char* name = nullptr;
+        const char* nameSpace = nullptr;
+        int typeId = 0;
+        bool isConst = false;
+        if (to->GetGlobalVar(i, &name, &nameSpace, &typeId, &isConst) < 0 || isConst) continue;
+
+        // Find the same variable in the old module
+        int index = -1;
+        for (asUINT j = 0; j < from->GetGlobalVarCount(); j++) {
+            const char* oldName = nullptr;
+            const char* oldNameSpace = nullptr;
+            int oldTypeId = 0;
+            from->GetGlobalVar(j, &oldName, &oldNameSpace, &oldTypeId);
+            if (oldTypeId == typeId && strcmp(oldName, name) == 0 && strcmp(oldNameSpace, nameSpace) == 0) {
+                index = static_cast<int>(j);
+                break;
+            }
+        }
+        if (index < 0) continue;
+
+        void* dst = to->GetAddressOfGlobalVar(i);
+        void* src = from->GetAddressOfGlobalVar(index);
+        if (!dst || !src) continue;
+
+        if (!(typeId & asTYPEID_MASK_OBJECT)) {
+            // Primitive or enum
+            memcpy(dst, src, engine_->GetSizeOfPrimitiveType(typeId));
+            restored++;
+            continue;
+        }
+        if (typeId & (asTYPEID_OBJHANDLE | asTYPEID_SCRIPTOBJECT)) continue;
+
+        asITypeInfo* type = engine_->GetTypeInfoById(typeId);
+        if (!type) continue;
+        bool isArray = (type->GetFlags() & asOBJ_TEMPLATE) && strcmp(type->GetName(), "array") == 0;
+        if (!(type->GetFlags() & asOBJ_VALUE) && !isArray) continue;
+
+        if (engine_->AssignScriptObject(dst, src, type) >= 0) {
+            restored++;
+        }
+    }
+    return restored;
+}
+
+void tcScriptHost::collectRetiredModule() {
+    // Its objects are left to collectGarbage()
+    if (retiredModule_) {
+        retiredModule_->Discard();
+        retiredModule_ = nullptr;
+    }
+}
+
+// Runs after draw(). Automatic collection would run whole cycles inside
+// script calls whenever it decides to; here the work is spread over frames
+// and bounded by gcBudgetUs_.
+void tcScriptHost::collectGarbage() {
+    asUINT objects = 0;
+    engine_->GetGCStatistics(&objects);
+    if (objects == 0) return;
+
+    tcScopedTiming timing(gcStats_);
+
+    if (gcThreshold_ > 0 && objects > gcNextFullCycle_) {
+        engine_->GarbageCollect(asGC_FULL_CYCLE);
+        gcFullCycles_++;
+        // If most objects are still alive, don't force another cycle every frame
+        engine_->GetGCStatistics(&objects);
+        gcNextFullCycle_ = max(gcThreshold_, static_cast<size_t>(objects) * 2);
+        return;
+    }
+
+    auto deadline = chrono::steady_clock::now() + chrono::microseconds(gcBudgetUs_);
+    do {
+        gcSteps_++;
+        // 0 means the cycle is complete - the next step would start a new one
+        if (engine_->GarbageCollect(asGC_ONE_STEP) == 0) {
+            gcCycles_++;
+            break;
+        }
+    } while (chrono::steady_clock::now() < deadline);
+}
+
+tcScriptHost::GarbageStats tcScriptHost::getGarbageStats() const {
+    GarbageStats stats;
+    asUINT objects = 0, destroyed = 0, detected = 0;
+    if (engine_) engine_->GetGCStatistics(&objects, &destroyed, &detected);
+    stats.objects = objects;
+    stats.destroyed = destroyed;
+    stats.detected = detected;
+    stats.steps = gcSteps_;
+    stats.cycles = gcCycles_;
+    stats.fullCycles = gcFullCycles_;
+    return stats;
+}
+
+void tcScriptHost::bindLifecycleFunctions() {
     setupFunc_ = module_->GetFunctionByDecl("void setup()");
     updateFunc_ = module_->GetFunctionByDecl("void update()");
     drawFunc_ = module_->GetFunctionByDecl("void draw()");
@@ -3080,34 +4787,434 @@ bool tcScriptHost::buildScriptFiles() {
     keyReleasedFunc_ = module_->GetFunctionByDecl("void keyReleased(int)");
     windowResizedFunc_ = module_->GetFunctionByDecl("void windowResized(int, int)");
 
+    // Optional: receive each frame's events as one batch instead
+    inputEventsFunc_ = module_->GetFunctionByDecl("void inputEvents(array<InputEvent>@)");
+    if (!inputEventsFunc_) {
+        inputEventsFunc_ = module_->GetFunctionByDecl("void inputEvents(const array<InputEvent> &in)");
+    }
+}
+
+// =============================================================================
+// Execution watchdog
+// =============================================================================
+
+asIScriptContext* tcScriptHost::createContext() {
+    asIScriptContext* ctx = engine_->CreateContext();
+    if (ctx) applyLineCallback(ctx, false);
+    return ctx;
+}
+
+// Install the cheapest line callback that does the job: none when neither
+// the watchdog nor the profiler is on. Coroutine contexts always need one
+// to yield when their frame slice runs out.
+void tcScriptHost::applyLineCallback(asIScriptContext* ctx, bool coroutine) {
+    if (profiler_.isEnabled()) {
+        ctx->SetLineCallback(asFUNCTION(profileLineCallbackStatic), this, asCALL_CDECL);
+    } else if (budgetMs_ > 0 || coroutine || tcScriptAllocator::getMemoryCap() > 0) {
+        ctx->SetLineCallback(asFUNCTION(lineCallbackStatic), this, asCALL_CDECL);
+    } else {
+        ctx->ClearLineCallback();
+    }
+}
+
+void tcScriptHost::updateLineCallbacks() {
+    if (ctx_) applyLineCallback(ctx_, false);
+    if (suspendedCtx_) applyLineCallback(suspendedCtx_, false);
+    for (const Coroutine& co : coroutines_) applyLineCallback(co.ctx, true);
+    for (asIScriptContext* ctx : contextPool_) applyLineCallback(ctx, true);
+}
+
+void tcScriptHost::setExecutionBudget(int milliseconds, bool suspend) {
+    budgetMs_ = milliseconds > 0 ? milliseconds : 0;
+    budgetSuspends_ = suspend;
+    updateLineCallbacks();
+}
+
+void tcScriptHost::setMemoryCap(size_t bytes) {
+    tcScriptAllocator::setMemoryCap(bytes);
+    updateLineCallbacks();
+}
+
+size_t tcScriptHost::getMemoryCap() const {
+    return tcScriptAllocator::getMemoryCap();
+}
+
+void tcScriptHost::checkExecutionBudget(asIScriptContext* ctx) {
+    // Reading the clock on every statement is measurable - sample instead
+    if (++linesSinceCheck_ < kBudgetCheckInterval) return;
+    linesSinceCheck_ = 0;
+
+    if (tcScriptAllocator::isOverCap()) {
+        memoryCapExceeded_ = true;
+        rememberLocation(ctx);
+        ctx->Abort();
+        return;
+    }
+
+    // A nested call (Pixels.map(), particle hooks) can't be suspended:
+    // PopState() would throw its unfinished frames away
+    bool nested = ctx->IsNested();
+
+    auto now = chrono::steady_clock::now();
+    if (runningCoroutines_ && now >= coroutineDeadline_ && !nested) {
+        // This frame's coroutine time is used up - continue next frame
+        // (a nested call finishes first; the caller yields after it)
+        ctx->Suspend();
+        return;
+    }
+    if (budgetMs_ <= 0 || now - callStart_ < chrono::milliseconds(budgetMs_)) return;
+
+    budgetExceeded_ = true;
+    if (budgetSuspends_ && !suspendedCtx_ && !nested) {
+        ctx->Suspend();
+        return;
+    }
+
+    // Remember where the script was stuck before the call stack unwinds
+    rememberLocation(ctx);
+    ctx->Abort();
+}
+
+void tcScriptHost::rememberLocation(asIScriptContext* ctx) {
+    const char* section = nullptr;
+    int col = 0;
+    budgetRow_ = ctx->GetLineNumber(0, &col, &section);
+    budgetCol_ = col;
+    budgetSection_ = section ? section : "";
+}
+
+void tcScriptHost::reportBudgetAbort(const string& what) {
+    appendError(budgetSection_, budgetRow_, budgetCol_,
+        "Execution of " + what + " exceeded the " + to_string(budgetMs_) + " ms budget and was aborted");
+    tc::logError() << "[AngelScript] " << what << " aborted after " << budgetMs_ << " ms at "
+                   << budgetSection_ << " (" << budgetRow_ << ", " << budgetCol_ << ")";
+}
+
+// Stop the script once it holds more memory than the cap allows. Returns
+// true if it was stopped now.
+bool tcScriptHost::checkMemoryCap(const char* what) {
+    if (halted_ || !(memoryCapExceeded_ || tcScriptAllocator::isOverCap())) return false;
+    halted_ = true;
+
+    string message = string("Execution of ") + what + " exceeded the memory cap of " +
+        to_string(tcScriptAllocator::getMemoryCap() / 1024) + " KB, script stopped";
+    if (memoryCapExceeded_) {
+        appendError(budgetSection_, budgetRow_, budgetCol_, message);
+    } else {
+        lastError_ = message;
+    }
+    tc::logError() << "[AngelScript] " << message;
     return true;
 }
 
+void tcScriptHost::execute(asIScriptContext* ctx, const char* what) {
+    callStart_ = chrono::steady_clock::now();
+    linesSinceCheck_ = 0;
+    budgetExceeded_ = false;
+    memoryCapExceeded_ = false;
+
+    bool profiling = profiler_.isEnabled();
+    if (profiling) profiler_.begin(what, "lifecycle");
+    int r = ctx->Execute();
+    if (profiling) endProfiledCall();
+    if (r == asEXECUTION_EXCEPTION) {
+        lastError_ = string("Exception in ") + what + ": " + ctx->GetExceptionString();
+    } else if (r == asEXECUTION_ABORTED && budgetExceeded_) {
+        reportBudgetAbort(what);
+    } else if (r == asEXECUTION_SUSPENDED) {
+        if (ctx == ctx_) {
+            // Park the call and keep a fresh context for everything else
+            suspendedCtx_ = ctx_;
+            // The entry function (update/draw/...), not whichever helper
+            // the call was in when it ran out of time
+            suspendedFunc_ = ctx_->GetFunction(ctx_->GetCallstackSize() - 1);
+            suspendedWhat_ = what;
+            ctx_ = createContext();
+            tc::logNotice() << "[AngelScript] " << what << " exceeded " << budgetMs_ << " ms, continuing next frame";
+        } else {
+            suspendedCtx_ = ctx;
+        }
+        return;
+    }
+    checkMemoryCap(what);
+
+    if (ctx != ctx_) {
+        ctx->Release();
+    }
+}
+
+void tcScriptHost::resumeSuspended() {
+    asIScriptContext* ctx = suspendedCtx_;
+    suspendedCtx_ = nullptr;
+    execute(ctx, suspendedWhat_.c_str());
+    if (!suspendedCtx_) {
+        suspendedFunc_ = nullptr;
+    }
+}
+
+void tcScriptHost::abortSuspended() {
+    if (!suspendedCtx_) return;
+    suspendedCtx_->Abort();
+    suspendedCtx_->Release();
+    suspendedCtx_ = nullptr;
+    suspendedFunc_ = nullptr;
+}
+
+// =============================================================================
+// Profiler
+// =============================================================================
+
+void tcScriptHost::setProfilingEnabled(bool enabled) {
+    profileStack_.clear();
+    profiler_.setEnabled(enabled);
+    updateLineCallbacks();
+}
+
+string tcScriptHost::getProfileTrace() const {
+    return profiler_.toChromeTrace();
+}
+
+// Script functions have no entry/exit hook, so spans follow the call stack
+// as seen from the line callback: a function starts at its first line and
+// ends at the next line run in its caller.
+void tcScriptHost::profileLine(asIScriptContext* ctx) {
+    if (!profiler_.isEnabled()) return;
+
+    size_t depth = ctx->GetCallstackSize();
+    while (profileStack_.size() > depth) {
+        profiler_.end();
+        profileStack_.pop_back();
+    }
+    // Returned and called another function between two lines
+    if (depth > 0 && profileStack_.size() == depth && profileStack_.back() != ctx->GetFunction(0)) {
+        profiler_.end();
+        profileStack_.pop_back();
+    }
+    while (profileStack_.size() < depth) {
+        asIScriptFunction* func = ctx->GetFunction(static_cast<asUINT>(depth - 1 - profileStack_.size()));
+        profiler_.begin(func);
+        profileStack_.push_back(func);
+    }
+}
+
+// Close the spans of a finished (or suspended) Execute()
+void tcScriptHost::endProfiledCall() {
+    for (size_t i = 0; i < profileStack_.size(); i++) {
+        profiler_.end();
+    }
+    profileStack_.clear();
+    profiler_.end();
+}
+
+// =============================================================================
+// Coroutines
+// =============================================================================
+
+void tcScriptHost::startCoroutine(asIScriptFunction* func) {
+    asIScriptContext* ctx = nullptr;
+    if (!contextPool_.empty()) {
+        ctx = contextPool_.back();
+        contextPool_.pop_back();
+    } else {
+        ctx = engine_->CreateContext();
+        if (!ctx) return;
+        applyLineCallback(ctx, true);
+    }
+    if (ctx->Prepare(func) < 0) {
+        contextPool_.push_back(ctx);
+        return;
+    }
+    func->AddRef();
+    coroutines_.push_back({ctx, func, 0});
+}
+
+bool tcScriptHost::yieldCoroutine(asIScriptContext* ctx, int frames) {
+    for (Coroutine& co : coroutines_) {
+        if (co.ctx == ctx) {
+            co.waitFrames = frames > 1 ? frames - 1 : 0;
+            ctx->Suspend();
+            return true;
+        }
+    }
+    return false;
+}
+
+void tcScriptHost::finishCoroutine(size_t index) {
+    Coroutine co = coroutines_[index];
+    coroutines_.erase(coroutines_.begin() + index);
+    co.func->Release();
+    co.ctx->Unprepare();
+    if (contextPool_.size() < kMaxPooledContexts) {
+        contextPool_.push_back(co.ctx);
+    } else {
+        co.ctx->Release();
+    }
+}
+
+void tcScriptHost::runCoroutines() {
+    if (coroutines_.empty()) return;
+
+    runningCoroutines_ = true;
+    coroutineDeadline_ = chrono::steady_clock::now() + chrono::milliseconds(coroutineBudgetMs_);
+
+    size_t i = 0;
+    while (i < coroutines_.size()) {
+        if (coroutines_[i].waitFrames > 0) {
+            coroutines_[i].waitFrames--;
+            i++;
+            continue;
+        }
+        callStart_ = chrono::steady_clock::now();
+        if (callStart_ >= coroutineDeadline_) break;
+        linesSinceCheck_ = 0;
+        budgetExceeded_ = false;
+        memoryCapExceeded_ = false;
+
+        // Coroutines started from here are appended and first run next frame
+        asIScriptContext* ctx = coroutines_[i].ctx;
+        bool profiling = profiler_.isEnabled();
+        if (profiling) profiler_.begin("coroutine", "lifecycle");
+        int r = ctx->Execute();
+        if (profiling) endProfiledCall();
+        if (r == asEXECUTION_SUSPENDED) {
+            i++;
+            continue;
+        }
+        if (r == asEXECUTION_EXCEPTION) {
+            lastError_ = string("Exception in coroutine ") + coroutines_[i].func->GetDeclaration() + ": " + ctx->GetExceptionString();
+        } else if (r == asEXECUTION_ABORTED && budgetExceeded_) {
+            reportBudgetAbort(string("coroutine ") + coroutines_[i].func->GetDeclaration());
+        }
+        finishCoroutine(i);
+        if (checkMemoryCap("coroutine")) break;
+    }
+
+    // Out of time: start with the ones that did not get to run next frame
+    if (i > 0 && i < coroutines_.size()) {
+        rotate(coroutines_.begin(), coroutines_.begin() + i, coroutines_.end());
+    }
+    runningCoroutines_ = false;
+}
+
+void tcScriptHost::callLoadCallback(asIScriptFunction* func, bool loaded) {
+    if (!ctx_ || halted_) return;
+    ctx_->Prepare(func);
+    ctx_->SetArgByte(0, loaded ? 1 : 0);
+    execute(ctx_, "load callback");
+}
+
+void tcScriptHost::stopCoroutines() {
+    while (!coroutines_.empty()) {
+        coroutines_.back().ctx->Abort();
+        finishCoroutine(coroutines_.size() - 1);
+    }
+}
+
+// =============================================================================
+// Input events (queued by tcApp, dispatched once per frame)
+// =============================================================================
+
+void tcScriptHost::dispatchEvents() {
+    if (eventQueue_.empty() || !ctx_) return;
+    tcScopedTiming timing(eventStats_);
+
+    if (inputEventsFunc_) {
+        if (!inputEventArrayType_) {
+            inputEventArrayType_ = engine_->GetTypeInfoByDecl("array<InputEvent>");
+        }
+        CScriptArray* events = CScriptArray::Create(inputEventArrayType_, static_cast<asUINT>(eventQueue_.size()));
+        for (size_t i = 0; i < eventQueue_.size(); i++) {
+            *static_cast<InputEvent*>(events->At(static_cast<asUINT>(i))) = eventQueue_[i];
+        }
+        eventQueue_.clear();
+
+        ctx_->Prepare(inputEventsFunc_);
+        ctx_->SetArgObject(0, events);
+        execute(ctx_, "inputEvents()");
+        events->Release();
+        return;
+    }
+
+    for (size_t i = 0; i < eventQueue_.size(); i++) {
+        const InputEvent& e = eventQueue_[i];
+        switch (e.type) {
+            case InputEvent::MousePressed: callMousePressed(e.x, e.y, e.button); break;
+            case InputEvent::MouseReleased: callMouseReleased(e.x, e.y, e.button); break;
+            case InputEvent::MouseMoved: callMouseMoved(e.x, e.y); break;
+            case InputEvent::MouseDragged: callMouseDragged(e.x, e.y, e.button); break;
+            case InputEvent::KeyPressed: callKeyPressed(e.key); break;
+            case InputEvent::KeyReleased: callKeyReleased(e.key); break;
+            case InputEvent::WindowResized: callWindowResized(static_cast<int>(e.x), static_cast<int>(e.y)); break;
+        }
+    }
+    eventQueue_.clear();
+}
+
 void tcScriptHost::callSetup() {
-    if (!setupFunc_ || !ctx_) return;
+    if (!setupFunc_ || !ctx_ || halted_) return;
     ctx_->Prepare(setupFunc_);
-    int r = ctx_->Execute();
-    if (r != asEXECUTION_FINISHED && r == asEXECUTION_EXCEPTION) {
-        lastError_ = string("Exception in setup(): ") + ctx_->GetExceptionString();
-    }
+    execute(ctx_, "setup()");
 }
 
 void tcScriptHost::callUpdate() {
+    tcScopedTiming timing(updateStats_);
+
+    // Script allocations of the frame that just ended
+    const tcScriptAllocator::Stats& memory = tcScriptAllocator::getStats();
+    frameAllocs_ = memory.allocs - allocsAtFrameStart_;
+    frameSystemAllocs_ = memory.systemAllocs - systemAllocsAtFrameStart_;
+    allocsAtFrameStart_ = memory.allocs;
+    systemAllocsAtFrameStart_ = memory.systemAllocs;
+    frameUploadBytes_ = tcUploadStats::bytes - uploadBytesAtFrameStart_;
+    uploadBytesAtFrameStart_ = tcUploadStats::bytes;
+
+    releaseFinishedSounds();
+    collectRetiredModule();
+
+    // Stopped by the memory cap until the next reload
+    if (halted_) return;
+
+    // Before the early return below: audio keeps time while a call resumes
+    updateSequencers();
+    runCoroutines();
+
+    // A call suspended by the watchdog continues in place of this frame's update()
+    if (suspendedCtx_ && suspendedFunc_ != drawFunc_) {
+        resumeSuspended();
+        return;
+    }
+
+    dispatchEvents();
+    loader_.poll();
+
     if (!updateFunc_ || !ctx_) return;
     ctx_->Prepare(updateFunc_);
-    int r = ctx_->Execute();
-    if (r != asEXECUTION_FINISHED && r == asEXECUTION_EXCEPTION) {
-        lastError_ = string("Exception in update(): ") + ctx_->GetExceptionString();
-    }
+    execute(ctx_, "update()");
 }
 
 void tcScriptHost::callDraw() {
+    {
+        tcScopedTiming timing(drawStats_);
+        drawFrame();
+    }
+    resetFramePools();
+    // Garbage collection fills the time between this frame and the next
+    if (engine_) collectGarbage();
+}
+
+void tcScriptHost::drawFrame() {
+    if (halted_) return;
+    if (suspendedCtx_) {
+        if (suspendedFunc_ == drawFunc_) {
+            resumeSuspended();
+            return;
+        }
+        // Nothing to draw until setup() has finished
+        if (suspendedFunc_ == setupFunc_) return;
+    }
     if (!drawFunc_ || !ctx_) return;
     ctx_->Prepare(drawFunc_);
-    int r = ctx_->Execute();
-    if (r != asEXECUTION_FINISHED && r == asEXECUTION_EXCEPTION) {
-        lastError_ = string("Exception in draw(): ") + ctx_->GetExceptionString();
-    }
+    execute(ctx_, "draw()");
 }
 
 void tcScriptHost::callMousePressed(float x, float y, int button) {
@@ -3116,7 +5223,7 @@ void tcScriptHost::callMousePressed(float x, float y, int button) {
     ctx_->SetArgFloat(0, x);
     ctx_->SetArgFloat(1, y);
     ctx_->SetArgDWord(2, button);
-    ctx_->Execute();
+    execute(ctx_, "mousePressed()");
 }
 
 void tcScriptHost::callMouseReleased(float x, float y, int button) {
@@ -3125,7 +5232,7 @@ void tcScriptHost::callMouseReleased(float x, float y, int button) {
     ctx_->SetArgFloat(0, x);
     ctx_->SetArgFloat(1, y);
     ctx_->SetArgDWord(2, button);
-    ctx_->Execute();
+    execute(ctx_, "mouseReleased()");
 }
 
 void tcScriptHost::callMouseMoved(float x, float y) {
@@ -3133,7 +5240,7 @@ void tcScriptHost::callMouseMoved(float x, float y) {
     ctx_->Prepare(mouseMovedFunc_);
     ctx_->SetArgFloat(0, x);
     ctx_->SetArgFloat(1, y);
-    ctx_->Execute();
+    execute(ctx_, "mouseMoved()");
 }
 
 void tcScriptHost::callMouseDragged(float x, float y, int button) {
@@ -3142,21 +5249,21 @@ void tcScriptHost::callMouseDragged(float x, float y, int button) {
     ctx_->SetArgFloat(0, x);
     ctx_->SetArgFloat(1, y);
     ctx_->SetArgDWord(2, button);
-    ctx_->Execute();
+    execute(ctx_, "mouseDragged()");
 }
 
 void tcScriptHost::callKeyPressed(int key) {
     if (!keyPressedFunc_ || !ctx_) return;
     ctx_->Prepare(keyPressedFunc_);
     ctx_->SetArgDWord(0, key);
-    ctx_->Execute();
+    execute(ctx_, "keyPressed()");
 }
 
 void tcScriptHost::callKeyReleased(int key) {
     if (!keyReleasedFunc_ || !ctx_) return;
     ctx_->Prepare(keyReleasedFunc_);
     ctx_->SetArgDWord(0, key);
-    ctx_->Execute();
+    execute(ctx_, "keyReleased()");
 }
 
 void tcScriptHost::callWindowResized(int width, int height) {
@@ -3164,7 +5271,131 @@ void tcScriptHost::callWindowResized(int width, int height) {
     ctx_->Prepare(windowResizedFunc_);
     ctx_->SetArgDWord(0, width);
     ctx_->SetArgDWord(1, height);
-    ctx_->Execute();
+    execute(ctx_, "windowResized()");
+}
+
+size_t tcScriptHost::getLiveObjectCount() const {
+    return tcscript::RefStats::live;
+}
+
+// =============================================================================
+// Engine stats
+// =============================================================================
+
+// Buffers owned by an object (pixels, vertices, floats); types without one
+// are reported shallow - the objects alone, not what TrussC holds for them
+static size_t heldBytes(Pixels& pixels) { return pixelBytes(pixels); }
+static size_t heldBytes(Image& image) { return pixelBytes(image.getPixels()); }
+static size_t heldBytes(Texture& texture) {
+    return texture.isAllocated() ? static_cast<size_t>(texture.getWidth()) * texture.getHeight() * 4 : 0;
+}
+static size_t heldBytes(Fbo& fbo) {
+    return fbo.isAllocated() ? static_cast<size_t>(fbo.getWidth()) * fbo.getHeight() * 4 : 0;
+}
+static size_t heldBytes(tcFloatBuffer& buffer) { return buffer.size() * sizeof(float); }
+static size_t heldBytes(Mesh& mesh) {
+    return static_cast<size_t>(mesh.getNumVertices()) * sizeof(Vec3) + static_cast<size_t>(mesh.getNumNormals()) * sizeof(Vec3) +
+        static_cast<size_t>(mesh.getNumColors()) * sizeof(Color) + static_cast<size_t>(mesh.getNumIndices()) * sizeof(uint32_t);
+}
+static size_t heldBytes(Path& path) { return static_cast<size_t>(path.size()) * sizeof(Vec3); }
+static size_t heldBytes(tcParticleSystem& system) {
+    size_t bytes = 0;
+    for (int c = 0; c < tcParticleSystem::ColumnCount; c++) {
+        bytes += system.column(static_cast<tcParticleSystem::Column>(c)).size() * sizeof(float);
+    }
+    return bytes;
+}
+
+template<typename T, typename = void>
+struct HasHeldBytes : std::false_type {};
+template<typename T>
+struct HasHeldBytes<T, std::void_t<decltype(heldBytes(std::declval<T&>()))>> : std::true_type {};
+
+// "Name":{"live":n,"bytes":n,"pooled":n} - bytes are the objects plus the
+// buffers they own; types where that isn't known add "shallow":true
+template<typename T>
+static void appendObjectStats(string& out, const char* name) {
+    size_t bytes = ScriptObject<T>::liveCount() * sizeof(ScriptObject<T>);
+    if constexpr (HasHeldBytes<T>::value) {
+        ScriptObject<T>::forEachLive([&bytes](T& obj) { bytes += heldBytes(obj); });
+    }
+    char buf[192];
+    snprintf(buf, sizeof(buf), "\"%s\":{\"live\":%zu,\"bytes\":%zu,\"pooled\":%zu%s},", name,
+        ScriptObject<T>::liveCount(), bytes, ScriptObject<T>::pooledCount() * sizeof(ScriptObject<T>),
+        HasHeldBytes<T>::value ? "" : ",\"shallow\":true");
+    out += buf;
+}
+
+string tcScriptHost::getStatsJson() const {
+    string out;
+    out.reserve(2048);
+    out += "{\"compile\":";
+    compileStats_.appendJson(out);
+    out += ",\"update\":";
+    updateStats_.appendJson(out);
+    out += ",\"draw\":";
+    drawStats_.appendJson(out);
+    out += ",\"events\":";
+    eventStats_.appendJson(out);
+    out += ",\"gc\":";
+    gcStats_.appendJson(out);
+
+    out += ",\"objects\":{";
+    appendObjectStats<Pixels>(out, "Pixels");
+    appendObjectStats<Texture>(out, "Texture");
+    appendObjectStats<Fbo>(out, "Fbo");
+    appendObjectStats<Sound>(out, "Sound");
+    appendObjectStats<Font>(out, "Font");
+    appendObjectStats<Mesh>(out, "Mesh");
+    appendObjectStats<Path>(out, "Path");
+    appendObjectStats<StrokeMesh>(out, "StrokeMesh");
+    appendObjectStats<Image>(out, "Image");
+    appendObjectStats<EasyCam>(out, "EasyCam");
+    appendObjectStats<tcDisplayList>(out, "DisplayList");
+    appendObjectStats<tcFloatBuffer>(out, "FloatBuffer");
+    appendObjectStats<tcParticleSystem>(out, "ParticleSystem");
+    appendObjectStats<ChipSoundBundle>(out, "ChipSoundBundle");
+    appendObjectStats<tcChipSynth>(out, "ChipSynth");
+    appendObjectStats<tcSequencer>(out, "Sequencer");
+    appendObjectStats<Tween<float>>(out, "Tween");
+
+    GarbageStats gc = getGarbageStats();
+
+    char buf[384];
+    snprintf(buf, sizeof(buf),
+        "\"total\":%zu,\"created\":%zu},\"playingSounds\":%zu,\"queuedEvents\":%zu,\"droppedEvents\":%zu,\"coroutines\":%zu,\"pendingLoads\":%zu,"
+        "\"gcObjects\":%zu,\"gcDestroyed\":%zu,\"gcDetected\":%zu,\"gcSteps\":%zu,\"gcCycles\":%zu,\"gcFullCycles\":%zu",
+        tcscript::RefStats::live, tcscript::RefStats::created, g_playingSounds.size(),
+        eventQueue_.size(), eventQueue_.getDroppedCount(), coroutines_.size(), loader_.getPendingCount(),
+        gc.objects, gc.destroyed, gc.detected, gc.steps, gc.cycles, gc.fullCycles);
+    out += buf;
+
+    // Script memory: allocations per frame as requested by the engine and
+    // as they reached the system allocator
+    const tcScriptAllocator::Stats& memory = tcScriptAllocator::getStats();
+    snprintf(buf, sizeof(buf),
+        ",\"memory\":{\"inUse\":%zu,\"peak\":%zu,\"reserved\":%zu,\"cap\":%zu,\"allocsPerFrame\":%zu,\"systemAllocsPerFrame\":%zu,\"stopped\":%s}",
+        memory.bytesInUse, memory.peakBytes, memory.reservedBytes, tcScriptAllocator::getMemoryCap(),
+        frameAllocs_, frameSystemAllocs_, halted_ ? "true" : "false");
+    out += buf;
+
+    // Texture uploads: bytes sent, and how many of them had changed
+    snprintf(buf, sizeof(buf),
+        ",\"uploads\":{\"count\":%zu,\"skipped\":%zu,\"bytes\":%zu,\"dirtyBytes\":%zu,\"bytesPerFrame\":%zu}",
+        tcUploadStats::uploads, tcUploadStats::skipped, tcUploadStats::bytes, tcUploadStats::dirtyBytes,
+        frameUploadBytes_);
+    out += buf;
+
+    // Decoded assets kept across reloads
+    const tcAssetCache::Stats& assets = assetCache_.getStats();
+    snprintf(buf, sizeof(buf),
+        ",\"assetCache\":{\"entries\":%zu,\"bytes\":%zu,\"budget\":%zu,\"hits\":%zu,\"misses\":%zu,\"evictions\":%zu}",
+        assets.entries, assets.bytes, assetCache_.getBudget(), assets.hits, assets.misses, assets.evictions);
+    out += buf;
+
+    // Each block above starts with its own comma; the root closes once
+    out += '}';
+    return out;
 }
 
 void tcScriptHost::appendError(const string& section, int row, int col, const string& message) {
@@ -5,6 +5,13 @@
 #include <functional>
 #include <vector>
 #include <angelscript.h>
+#include <chrono>
+#include "tcAssetCache.h"
+#include "tcAsyncLoader.h"
+#include "tcBytecodeCache.h"
+#include "tcEventQueue.h"
+#include "tcFrameStats.h"
+#include "tcProfiler.h"
 
 using namespace std;
 using namespace tc;
@@ -22,18 +29,108 @@ public:
     void addScriptFile(const string& name, const string& code);
     bool buildScriptFiles();
 
+    // Bytecode cache (unchanged sources skip parsing/compiling)
+    void setBytecodeCacheEnabled(bool enabled) { bytecodeCacheEnabled_ = enabled; }
+    void setBytecodeCacheDir(const string& dir) { bytecodeCache_.setDirectory(dir); }
+    bool wasLoadedFromCache() const { return loadedFromCache_; }
+
+    // Hot reload keeps global variable values (matched by name and type).
+    // When anything was restored, setup() should not be called again.
+    void setPreserveState(bool enabled) { preserveState_ = enabled; }
+    bool isPreserveState() const { return preserveState_; }
+    bool wasStateRestored() const { return stateRestored_; }
+
+    // Number of script-visible objects (Mesh, Texture, Sound, ...) alive
+    size_t getLiveObjectCount() const;
+
+    // Execution watchdog: a single script call may run for at most
+    // 'milliseconds' (0 = unlimited). When exceeded the call is aborted with
+    // an error at the offending line, or with suspend = true it is paused and
+    // continued on the next frame.
+    void setExecutionBudget(int milliseconds, bool suspend = false);
+    int getExecutionBudget() const { return budgetMs_; }
+
+    // Memory cap for script allocations in bytes (0 = none). A script that
+    // goes over it is aborted with an error and stays stopped until the
+    // next reload, which frees its memory before the new script starts.
+    // See tcScriptAllocator.h.
+    void setMemoryCap(size_t bytes);
+    size_t getMemoryCap() const;
+
+    // Decoded images, sounds and fonts kept across reloads, least recently
+    // used evicted past 'bytes' (0 = no caching). See tcAssetCache.h.
+    void setAssetCacheBudget(size_t bytes) { assetCache_.setBudget(bytes); }
+    tcAssetCache& getAssetCache() { return assetCache_; }
+
+    // Coroutines: time per frame shared by all running coroutines. A
+    // coroutine that has not yielded when it runs out is suspended and
+    // continued next frame.
+    void setCoroutineBudget(int milliseconds) { coroutineBudgetMs_ = milliseconds; }
+    size_t getCoroutineCount() const { return coroutines_.size(); }
+
+    // Garbage collection: automatic collection is off; instead the collector
+    // runs incrementally after draw() for at most 'microseconds' per frame.
+    // A full cycle is forced only when the number of GC-tracked objects
+    // exceeds the threshold (0 = never).
+    struct GarbageStats {
+        size_t objects = 0;     // objects currently tracked by the collector
+        size_t destroyed = 0;   // objects destroyed since startup
+        size_t detected = 0;    // garbage cycles broken since startup
+        size_t steps = 0;       // incremental steps run
+        size_t cycles = 0;      // incremental cycles completed
+        size_t fullCycles = 0;  // forced full cycles
+    };
+    void setGarbageCollectionBudget(int microseconds) { gcBudgetUs_ = microseconds; }
+    int getGarbageCollectionBudget() const { return gcBudgetUs_; }
+    void setGarbageCollectionThreshold(size_t objects) { gcThreshold_ = objects; gcNextFullCycle_ = objects; }
+    GarbageStats getGarbageStats() const;
+
+    // Profiler: records script function spans (and C++ calls in
+    // TCSCRIPT_PROFILER builds) as Chrome Trace Event JSON
+    void setProfilingEnabled(bool enabled);
+    bool isProfilingEnabled() const { return profiler_.isEnabled(); }
+    string getProfileTrace() const;
+
+    // Engine stats for the perf HUD as one JSON object: rolling timings of
+    // compiles, update(), draw(), event dispatch and GC, live objects and
+    // pooled bytes per script type, playing sounds, GC counters and script
+    // memory (bytes in use, allocations per frame)
+    string getStatsJson() const;
+
     // Get last error message
     string getLastError() const { return lastError_; }
 
     // Append error message (for message callback)
     void appendError(const string& section, int row, int col, const string& message);
 
+    // Enforce the execution budget (for line callback)
+    void checkExecutionBudget(asIScriptContext* ctx);
+
+    // Track script function entry/exit (for profiling line callback)
+    void profileLine(asIScriptContext* ctx);
+
+    // Coroutine control (for startCoroutine / yield / waitFrames)
+    void startCoroutine(asIScriptFunction* func);
+    bool yieldCoroutine(asIScriptContext* ctx, int frames);
+
+    // Asynchronous loads (for loadAsync): work runs on a worker thread,
+    // finish on the main thread before update() once the work is done
+    void startLoad(tcAsyncLoader::Work work, tcAsyncLoader::Finish finish) { loader_.submit(std::move(work), std::move(finish)); }
+    void callLoadCallback(asIScriptFunction* func, bool loaded);
+    size_t getPendingLoadCount() const { return loader_.getPendingCount(); }
+
     // Lifecycle calls (call from tcApp)
     void callSetup();
     void callUpdate();
     void callDraw();
 
-    // Event calls
+    // Input events are queued and delivered once per frame before update().
+    // A script that defines inputEvents(array<InputEvent>@) gets the whole
+    // batch in one call instead of the individual callbacks below.
+    void queueEvent(const InputEvent& event) { eventQueue_.push(event); }
+    void setCoalesceMouseMoves(bool enabled) { eventQueue_.setCoalesceMoves(enabled); }
+
+    // Event calls (immediate)
     void callMousePressed(float x, float y, int button);
     void callMouseReleased(float x, float y, int button);
     void callMouseMoved(float x, float y);
@@ -44,16 +141,121 @@ public:
 
 private:
     void registerTrussCFunctions();
+    bool buildModule(const vector<pair<string, string>>& sections);
+    void swapModule(asIScriptModule* next);
+    void collectRetiredModule();
+    void collectGarbage();
+    int restoreGlobals(asIScriptModule* from, asIScriptModule* to);
+    void bindLifecycleFunctions();
+    asIScriptContext* createContext();
+    void applyLineCallback(asIScriptContext* ctx, bool coroutine);
+    void updateLineCallbacks();
+    void endProfiledCall();
+    void execute(asIScriptContext* ctx, const char* what);
+    void resumeSuspended();
+    void abortSuspended();
+    void runCoroutines();
+    void finishCoroutine(size_t index);
+    void stopCoroutines();
+    void dispatchEvents();
+    void drawFrame();
+    void rememberLocation(asIScriptContext* ctx);
+    void reportBudgetAbort(const string& what);
+    bool checkMemoryCap(const char* what);
     void messageCallback(const asSMessageInfo* msg);
 
     asIScriptEngine* engine_ = nullptr;
     asIScriptModule* module_ = nullptr;
     asIScriptContext* ctx_ = nullptr;
+
+    // Previous module after a reload, discarded on the next update()
+    asIScriptModule* retiredModule_ = nullptr;
+
+    // Incremental garbage collection
+    int gcBudgetUs_ = 500;
+    size_t gcThreshold_ = 20000;
+    size_t gcNextFullCycle_ = 20000;   // raised while live objects stay above the threshold
+    size_t gcSteps_ = 0;
+    size_t gcCycles_ = 0;
+    size_t gcFullCycles_ = 0;
+
+    // Execution watchdog
+    static constexpr int kBudgetCheckInterval = 1024;  // lines between clock reads
+    int budgetMs_ = 2000;
+    bool budgetSuspends_ = false;
+    bool budgetExceeded_ = false;
+    int linesSinceCheck_ = 0;
+    chrono::steady_clock::time_point callStart_;
+    string budgetSection_;
+    int budgetRow_ = 0;
+    int budgetCol_ = 0;
+
+    // Memory cap (script stopped until the next reload once exceeded)
+    bool memoryCapExceeded_ = false;
+    bool halted_ = false;
+
+    // Script allocations of the last complete frame
+    size_t frameAllocs_ = 0;
+    size_t frameSystemAllocs_ = 0;
+    size_t allocsAtFrameStart_ = 0;
+    size_t systemAllocsAtFrameStart_ = 0;
+
+    // Texture bytes uploaded in the last complete frame
+    size_t frameUploadBytes_ = 0;
+    size_t uploadBytesAtFrameStart_ = 0;
+
+    // Call suspended by the watchdog, continued on the next frame
+    asIScriptContext* suspendedCtx_ = nullptr;
+    asIScriptFunction* suspendedFunc_ = nullptr;
+    string suspendedWhat_;
+
+    // Coroutines, each on its own context (recycled through contextPool_)
+    struct Coroutine {
+        asIScriptContext* ctx;
+        asIScriptFunction* func;
+        int waitFrames;
+    };
+    static constexpr size_t kMaxPooledContexts = 16;
+    vector<Coroutine> coroutines_;
+    vector<asIScriptContext*> contextPool_;
+    int coroutineBudgetMs_ = 4;
+    bool runningCoroutines_ = false;
+    chrono::steady_clock::time_point coroutineDeadline_;
+
+    // loadAsync jobs
+    tcAsyncLoader loader_;
+
+    // Outlives every script module (cleared only with the host)
+    tcAssetCache assetCache_;
+
+    // Input events waiting for the next frame
+    tcEventQueue eventQueue_;
+    asITypeInfo* inputEventArrayType_ = nullptr;
+
+    // Profiler (script functions currently open, outermost first)
+    tcProfiler profiler_;
+    vector<asIScriptFunction*> profileStack_;
+
+    // Rolling timings (see getStatsJson)
+    tcTimingStats compileStats_;
+    tcTimingStats updateStats_;
+    tcTimingStats drawStats_;
+    tcTimingStats eventStats_;
+    tcTimingStats gcStats_;
+
+    // State-preserving reload
+    bool preserveState_ = false;
+    bool stateRestored_ = false;
     string lastError_;
 
     // Multi-file storage (preserves order)
     vector<pair<string, string>> scriptFiles_;
 
+    // Compiled bytecode keyed by source hash
+    tcBytecodeCache bytecodeCache_;
+    bool bytecodeCacheEnabled_ = true;
+    bool loadedFromCache_ = false;
+
     // Cached function pointers
     asIScriptFunction* setupFunc_ = nullptr;
     asIScriptFunction* updateFunc_ = nullptr;
@@ -65,4 +267,5 @@ private:
     asIScriptFunction* keyPressedFunc_ = nullptr;
     asIScriptFunction* keyReleasedFunc_ = nullptr;
     asIScriptFunction* windowResizedFunc_ = nullptr;
+    asIScriptFunction* inputEventsFunc_ = nullptr;
 };
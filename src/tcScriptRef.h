@@ -0,0 +1,267 @@
+#pragma once
+
+// =============================================================================
+// tcScriptRef - reference counting for script-visible TrussC objects
+//
+// Reference types handed to AngelScript are allocated as ScriptObject<T>:
+// the TrussC class plus an intrusive reference count. The script engine calls
+// scriptAddRef/scriptRelease (registered as asBEHAVE_ADDREF / asBEHAVE_RELEASE)
+// and the object is destroyed as soon as the last handle goes away. Freed
+// blocks are kept on a small per-type free list so createMesh() in a loop
+// does not hit the system allocator every frame.
+//
+// Some getters return objects that live inside another one (Fbo::getTexture,
+// Image::getPixels). Those are not ScriptObjects - BorrowedRefs tracks the
+// handles to them and keeps the owning object alive until they are released.
+//
+//   gen->SetReturnAddress(ScriptObject<Mesh>::create());      // new object, refcount 1
+//   gen->SetReturnObject(BorrowedRefs<Texture>::borrow(&fbo->getTexture(), fbo));
+//
+// Host-side state keyed by an object (a dirty region, say) is dropped in a
+// destroy hook rather than in the release behaviour: the last reference can
+// also go away through a borrowed handle, which never calls that behaviour.
+//
+// FramePool lends objects for a single frame (createTempMesh() and friends):
+// at the end of the frame they are reset and handed out again, so their
+// vertex storage is reused instead of reallocated.
+//
+// All counting happens on the script thread, so plain ints are enough.
+// =============================================================================
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tcscript {
+
+// Totals across all script-visible types
+struct RefStats {
+    static inline size_t live = 0;      // objects currently alive
+    static inline size_t created = 0;   // objects created since startup
+};
+
+// -----------------------------------------------------------------------------
+// ScriptObject<T> - T with an intrusive reference count and pooled storage
+// -----------------------------------------------------------------------------
+template<typename T>
+class ScriptObject final : public T {
+public:
+    template<typename... Args>
+    explicit ScriptObject(Args&&... args) : T(std::forward<Args>(args)...) {
+        ++liveCount_;
+        ++RefStats::live;
+        ++RefStats::created;
+        next_ = first_;
+        if (first_) first_->prev_ = this;
+        first_ = this;
+    }
+    ~ScriptObject() {
+        if (destroyHook_) destroyHook_(this);
+        --liveCount_;
+        --RefStats::live;
+        if (prev_) prev_->next_ = next_;
+        else first_ = next_;
+        if (next_) next_->prev_ = prev_;
+    }
+
+    ScriptObject(const ScriptObject&) = delete;
+    ScriptObject& operator=(const ScriptObject&) = delete;
+
+    // New object owned by the caller (reference count 1). Return it to the
+    // script with SetReturnAddress() so the reference is handed over as-is.
+    template<typename... Args>
+    static T* create(Args&&... args) {
+        return new ScriptObject(std::forward<Args>(args)...);
+    }
+
+    static void addRef(T* obj) {
+        ScriptObject* self = static_cast<ScriptObject*>(obj);
+        self->gcFlag_ = false;
+        ++self->refCount_;
+    }
+    static void release(T* obj) {
+        ScriptObject* self = static_cast<ScriptObject*>(obj);
+        self->gcFlag_ = false;
+        if (--self->refCount_ == 0) {
+            delete self;
+        }
+    }
+
+    static size_t liveCount() { return liveCount_; }
+
+    // Visit every live object (for stats; objects must not be created or
+    // destroyed from inside f)
+    template<typename F>
+    static void forEachLive(F f) {
+        for (ScriptObject* obj = first_; obj; obj = obj->next_) f(static_cast<T&>(*obj));
+    }
+    static int refCount(T* obj) { return static_cast<ScriptObject*>(obj)->refCount_; }
+
+    // Called with every object of this type just before it is destroyed
+    static void setDestroyHook(void (*hook)(T*)) { destroyHook_ = hook; }
+
+    // For types registered with asOBJ_GC: the collector sets the flag, any
+    // addRef/release clears it
+    static void setGCFlag(T* obj) { static_cast<ScriptObject*>(obj)->gcFlag_ = true; }
+    static bool gcFlag(T* obj) { return static_cast<ScriptObject*>(obj)->gcFlag_; }
+
+    // Freed blocks held for reuse
+    static size_t pooledCount() { return freeList_.size(); }
+
+    // Pooled storage
+    static void* operator new(size_t size) {
+        if (size == sizeof(ScriptObject) && !freeList_.empty()) {
+            void* p = freeList_.back();
+            freeList_.pop_back();
+            return p;
+        }
+        return ::operator new(size);
+    }
+    static void operator delete(void* p, size_t size) {
+        if (size == sizeof(ScriptObject) && freeList_.size() < kMaxPooled) {
+            freeList_.push_back(p);
+            return;
+        }
+        ::operator delete(p);
+    }
+
+private:
+    static constexpr size_t kMaxPooled = 256;
+
+    struct FreeList : std::vector<void*> {
+        ~FreeList() { for (void* p : *this) ::operator delete(p); }
+    };
+
+    int refCount_ = 1;
+    bool gcFlag_ = false;
+    ScriptObject* prev_ = nullptr;      // live objects of this type
+    ScriptObject* next_ = nullptr;
+    static inline ScriptObject* first_ = nullptr;
+    static inline size_t liveCount_ = 0;
+    static inline void (*destroyHook_)(T*) = nullptr;
+    static inline FreeList freeList_;
+};
+
+// -----------------------------------------------------------------------------
+// BorrowedRefs<T> - handles to a T owned by another script object
+// -----------------------------------------------------------------------------
+template<typename T>
+class BorrowedRefs {
+public:
+    // Register a pointer into 'parent' before returning it with
+    // SetReturnObject(). The parent stays alive while any handle exists.
+    template<typename P>
+    static T* borrow(T* ptr, P* parent) {
+        auto it = entries_.find(ptr);
+        if (it == entries_.end()) {
+            ScriptObject<P>::addRef(parent);
+            entries_.emplace(ptr, Entry{0, parent, [](void* p) {
+                ScriptObject<P>::release(static_cast<P*>(p));
+            }});
+        }
+        return ptr;
+    }
+
+    // True while a script holds a handle to 'ptr'
+    static bool isBorrowed(const T* ptr) {
+        return !entries_.empty() && entries_.count(const_cast<T*>(ptr)) > 0;
+    }
+
+    // Returns false if 'ptr' is not a borrowed object
+    static bool addRef(T* ptr) {
+        if (entries_.empty()) return false;
+        auto it = entries_.find(ptr);
+        if (it == entries_.end()) return false;
+        ++it->second.refs;
+        return true;
+    }
+    static bool release(T* ptr) {
+        if (entries_.empty()) return false;
+        auto it = entries_.find(ptr);
+        if (it == entries_.end()) return false;
+        if (--it->second.refs <= 0) {
+            Entry entry = it->second;
+            entries_.erase(it);
+            entry.releaseParent(entry.parent);
+        }
+        return true;
+    }
+
+private:
+    struct Entry {
+        int refs;
+        void* parent;
+        void (*releaseParent)(void*);
+    };
+    static inline std::unordered_map<T*, Entry> entries_;
+};
+
+// -----------------------------------------------------------------------------
+// FramePool<T> - objects lent to the script until the end of the frame
+// -----------------------------------------------------------------------------
+template<typename T>
+class FramePool {
+public:
+    // An object in its reset state. The pool keeps its own reference - return
+    // it with SetReturnObject().
+    static T* acquire() {
+        if (used_ == objects_.size()) {
+            objects_.push_back(ScriptObject<T>::create());
+        }
+        return objects_[used_++];
+    }
+
+    // End of frame: reset the objects handed out since the last call. One the
+    // script still holds a handle to (stored in a global, say) is given up
+    // by the pool and lives on as an ordinary object.
+    template<typename Reset>
+    static void reset(Reset&& resetObject) {
+        auto keptEnd = std::remove_if(objects_.begin(), objects_.begin() + used_, [](T* obj) {
+            if (ScriptObject<T>::refCount(obj) == 1) return false;
+            ScriptObject<T>::release(obj);
+            return true;
+        });
+        for (auto it = objects_.begin(); it != keptEnd; ++it) resetObject(**it);
+        objects_.erase(keptEnd, objects_.begin() + used_);
+        used_ = 0;
+
+        // Don't hold on to the peak of one unusually busy frame forever
+        while (objects_.size() > kMaxPooled) {
+            ScriptObject<T>::release(objects_.back());
+            objects_.pop_back();
+        }
+    }
+
+    // Give up every object (script reload / shutdown)
+    static void clear() {
+        for (T* obj : objects_) ScriptObject<T>::release(obj);
+        objects_.clear();
+        used_ = 0;
+    }
+
+    static size_t size() { return objects_.size(); }
+
+private:
+    static constexpr size_t kMaxPooled = 256;
+
+    static inline std::vector<T*> objects_;
+    static inline size_t used_ = 0;
+};
+
+// -----------------------------------------------------------------------------
+// Behaviours registered with the engine
+// -----------------------------------------------------------------------------
+template<typename T>
+void scriptAddRef(T* obj) {
+    if (!BorrowedRefs<T>::addRef(obj)) ScriptObject<T>::addRef(obj);
+}
+
+template<typename T>
+void scriptRelease(T* obj) {
+    if (!BorrowedRefs<T>::release(obj)) ScriptObject<T>::release(obj);
+}
+
+} // namespace tcscript
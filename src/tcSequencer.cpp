@@ -0,0 +1,153 @@
+#include "tcSequencer.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace tc;
+
+tcSequencer::tcSequencer(tcChipSynth* synth, float bpm)
+    : synth_(synth), bpm_(bpm > 0.0f ? bpm : 120.0f) {
+}
+
+void tcSequencer::add(const ChipSoundNote& note, float beat) {
+    Event event{std::max(0.0f, beat), note, nullptr};
+    auto at = std::upper_bound(events_.begin(), events_.end(), event.beat,
+        [](float b, const Event& e) { return b < e.beat; });
+    events_.insert(at, event);
+}
+
+void tcSequencer::add(Sound* sound, float beat) {
+    Event event{std::max(0.0f, beat), ChipSoundNote(), sound};
+    auto at = std::upper_bound(events_.begin(), events_.end(), event.beat,
+        [](float b, const Event& e) { return b < e.beat; });
+    events_.insert(at, event);
+}
+
+void tcSequencer::clear() {
+    events_.clear();
+    queued_.clear();
+}
+
+// =============================================================================
+// Clock
+// =============================================================================
+
+void tcSequencer::advanceClock() {
+    double host = getElapsedTimeMicros() * 1e-6;
+    double hostDelta = lastHostTime_ < 0.0 ? 0.0 : std::max(0.0, host - lastHostTime_);
+    lastHostTime_ = host;
+
+    if (synth_) {
+        uint64_t frame = synth_->getFrame();
+        if (frame != lastFrame_) {
+            clock_ += static_cast<double>(frame - lastFrame_) / tcChipSynth::getSampleRate();
+            lastFrame_ = frame;
+            stalledFor_ = 0.0;
+            synthRunning_ = true;
+            return;
+        }
+        // Audio blocks are coarser than frames: hold the clock for a while
+        // before deciding the synth has stopped
+        stalledFor_ += hostDelta;
+        if (synthRunning_ && stalledFor_ < kStallTimeout) return;
+        synthRunning_ = false;
+    }
+    clock_ += hostDelta;
+}
+
+double tcSequencer::beatAt(double time) const {
+    return anchorBeat_ + (time - anchorTime_) * bpm_ / 60.0;
+}
+
+double tcSequencer::timeAt(double beat) const {
+    return anchorTime_ + (beat - anchorBeat_) * 60.0 / bpm_;
+}
+
+void tcSequencer::setBpm(float bpm) {
+    if (bpm <= 0.0f) return;
+    if (playing_) {
+        anchorBeat_ = beatAt(clock_);
+        anchorTime_ = clock_;
+    }
+    bpm_ = bpm;
+}
+
+double tcSequencer::getBeat() const {
+    if (!playing_) return 0.0;
+    double beat = std::max(0.0, beatAt(clock_));
+    return loop_ > 0.0f ? std::fmod(beat, static_cast<double>(loop_)) : beat;
+}
+
+// =============================================================================
+// Scheduling
+// =============================================================================
+
+void tcSequencer::start() {
+    advanceClock();
+    anchorTime_ = clock_;
+    anchorBeat_ = 0.0;
+    scheduledBeat_ = 0.0;
+    queued_.clear();
+    playing_ = true;
+    // Beat 0 goes out now rather than a frame late
+    schedule(beatAt(anchorTime_ + lookahead_));
+}
+
+void tcSequencer::stop() {
+    playing_ = false;
+    queued_.clear();
+}
+
+// Events in [from, to) beats of one pass, 'base' beats after the start
+void tcSequencer::scheduleRange(double from, double to, double base) {
+    auto it = std::lower_bound(events_.begin(), events_.end(), from,
+        [](const Event& e, double b) { return e.beat < b; });
+    for (; it != events_.end() && it->beat < to; ++it) {
+        double time = timeAt(base + it->beat);
+        if (it->sound) {
+            queued_.push_back({time, it->sound});
+        } else if (synth_ && synthRunning_) {
+            // Relative to the last frame seen, so host-clock stretches don't shift it
+            double offset = std::max(0.0, time - clock_) * tcChipSynth::getSampleRate();
+            synth_->playAt(it->note, lastFrame_ + static_cast<uint64_t>(std::llround(offset)));
+        }
+    }
+}
+
+void tcSequencer::schedule(double toBeat) {
+    double from = scheduledBeat_;
+    if (from >= toBeat) return;
+    if (loop_ > 0.0f) {
+        double loop = loop_;
+        for (double pass = std::floor(from / loop); pass * loop < toBeat; pass++) {
+            double base = pass * loop;
+            scheduleRange(std::max(from - base, 0.0), std::min(toBeat - base, loop), base);
+        }
+    } else {
+        scheduleRange(from, toBeat, 0.0);
+    }
+    scheduledBeat_ = toBeat;
+}
+
+void tcSequencer::update(PlaySoundFunc playSound) {
+    if (!playing_) return;
+    advanceClock();
+    double t = clock_;
+
+    // Skip what is already too late to play
+    scheduledBeat_ = std::max(scheduledBeat_, beatAt(t - kMaxLateness));
+    schedule(beatAt(t + lookahead_));
+
+    for (size_t i = 0; i < queued_.size();) {
+        if (queued_[i].time > t) {
+            i++;
+            continue;
+        }
+        playSound(queued_[i].sound);
+        queued_.erase(queued_.begin() + i);
+    }
+
+    // A sequence that doesn't loop ends after its last event
+    if (loop_ == 0.0f && queued_.empty() && (events_.empty() || beatAt(t) >= events_.back().beat)) {
+        playing_ = false;
+    }
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+// =============================================================================
+// tcSequencer - beat-timed notes and sounds scheduled ahead of time
+//
+// Calling Sound.play() from update() ties rhythm to the frame rate. A
+// sequencer holds events at beat positions (the ChipSoundBundle add(note,
+// time) model, in beats instead of seconds) and the host advances it once per
+// frame: every event due within the next 'lookahead' seconds is handed on
+// with its exact start time.
+//
+// With a ChipSynth the sequencer runs on the synth's sample clock and notes
+// are queued with tcChipSynth::playAt(), so they start on their exact sample
+// however late the frame is, as long as frames are less than 'lookahead'
+// apart. Sound events have no scheduled start in TrussC: they are held until
+// due and then played by the host, so they are accurate to a frame. Without
+// a synth the sequencer runs on the host's elapsed time and can only play
+// sounds.
+//
+// If the synth clock stops (audio not started yet, the context suspended)
+// for longer than kStallTimeout, the sequencer falls back to the host's
+// elapsed time: sounds keep playing, notes are skipped until it moves again.
+//
+// Events more than kMaxLateness late (the page was hidden, a long stall) are
+// dropped instead of all being played at once.
+// =============================================================================
+
+#include <TrussC.h>
+#include "tcChipSynth.h"
+#include <vector>
+
+class tcSequencer {
+public:
+    static constexpr double kDefaultLookahead = 0.1;   // seconds
+    static constexpr double kMaxLateness = 0.25;       // seconds
+    static constexpr double kStallTimeout = 0.2;       // seconds
+
+    struct Event {
+        float beat;
+        tc::ChipSoundNote note;
+        tc::Sound* sound;           // null for a note
+    };
+
+    using PlaySoundFunc = void(*)(tc::Sound*);
+
+    explicit tcSequencer(tcChipSynth* synth = nullptr, float bpm = 120.0f);
+
+    // Events are kept sorted by beat; they may be added while playing
+    void add(const tc::ChipSoundNote& note, float beat);
+    void add(tc::Sound* sound, float beat);
+    void clear();
+    const std::vector<Event>& getEvents() const { return events_; }
+
+    // Tempo changes keep the current beat position
+    void setBpm(float bpm);
+    float getBpm() const { return bpm_; }
+    // Loop length in beats (0 = play once); events at or past it are skipped
+    void setLoop(float beats) { loop_ = beats > 0.0f ? beats : 0.0f; }
+    float getLoop() const { return loop_; }
+    void setLookahead(double seconds) { lookahead_ = seconds > 0.0 ? seconds : 0.0; }
+    double getLookahead() const { return lookahead_; }
+
+    void start();
+    void stop();
+    bool isPlaying() const { return playing_; }
+    // Position in beats (within the loop when looping)
+    double getBeat() const;
+
+    tcChipSynth* getSynth() const { return synth_; }
+
+    // Main thread, once per frame: schedules the lookahead window and plays
+    // the sounds that are due
+    void update(PlaySoundFunc playSound);
+
+private:
+    struct QueuedSound {
+        double time;
+        tc::Sound* sound;
+    };
+
+    void advanceClock();
+    double beatAt(double time) const;
+    double timeAt(double beat) const;
+    void schedule(double toBeat);
+    void scheduleRange(double from, double to, double base);
+
+    tcChipSynth* synth_;
+    std::vector<Event> events_;
+    std::vector<QueuedSound> queued_;
+    float bpm_;
+    float loop_ = 0.0f;
+    double lookahead_ = kDefaultLookahead;
+
+    // Sequencer clock in seconds: synth frames while they advance, host
+    // time otherwise. Advanced by start() and update() only.
+    double clock_ = 0.0;
+    double lastHostTime_ = -1.0;
+    uint64_t lastFrame_ = 0;
+    double stalledFor_ = 0.0;      // host seconds without a new synth frame
+    bool synthRunning_ = true;
+
+    bool playing_ = false;
+    double anchorTime_ = 0.0;      // clock time at anchorBeat_
+    double anchorBeat_ = 0.0;
+    double scheduledBeat_ = 0.0;   // events before this beat were handed on
+};